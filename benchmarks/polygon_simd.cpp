@@ -0,0 +1,244 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+/*
+ * Checks that the PolygonSimd loops give exactly the results of the scalar
+ * loops they replace, and times both.
+ *
+ * The paths are random, with small coordinates to get many points on borders
+ * and horizontal edges, far from the origin, and around the 32-bit boundaries
+ * where the nearest vertex search has to leave its 32-bit products.
+ *
+ * Usage: polygon_simd_benchmark [number of random cases]
+ * Exits with 1 if any result differs.
+ */
+
+#include <algorithm> //For std::min and std::max.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib> //For std::strtoul.
+#include <limits>
+#include <random>
+
+#include "utils/PolygonSimd.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+void scalarIncludeBounds(const ClipperLib::Path& path, Point& min, Point& max)
+{
+    for (const Point& p : path)
+    {
+        min.X = std::min(min.X, p.X);
+        min.Y = std::min(min.Y, p.Y);
+        max.X = std::max(max.X, p.X);
+        max.Y = std::max(max.Y, p.Y);
+    }
+}
+
+size_t scalarFindNearestVert(const Point& from, const ClipperLib::Path& path, int64_t& best_dist2)
+{
+    size_t best_idx = path.size();
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        const int64_t dist2 = vSize2(path[i] - from);
+        if (dist2 < best_dist2)
+        {
+            best_dist2 = dist2;
+            best_idx = i;
+        }
+    }
+    return best_idx;
+}
+
+struct Mismatches
+{
+    size_t point_in_polygon = 0;
+    size_t bounds = 0;
+    size_t nearest_vert = 0;
+};
+
+/*!
+ * Compare all three loops on one path and one query point.
+ * \param best_dist2 The squared distance to beat in the nearest vertex search.
+ */
+void compare(const ClipperLib::Path& path, const Point& point, const int64_t best_dist2, Mismatches& mismatches)
+{
+    if (PolygonSimd::pointInPolygon(point, path) != ClipperLib::PointInPolygon(point, path))
+    {
+        mismatches.point_in_polygon++;
+    }
+
+    Point min(POINT_MAX, POINT_MAX);
+    Point max(POINT_MIN, POINT_MIN);
+    Point scalar_min = min;
+    Point scalar_max = max;
+    PolygonSimd::includeBounds(path, min, max);
+    scalarIncludeBounds(path, scalar_min, scalar_max);
+    if (min != scalar_min || max != scalar_max)
+    {
+        mismatches.bounds++;
+    }
+
+    int64_t dist2 = best_dist2;
+    int64_t scalar_dist2 = best_dist2;
+    if (PolygonSimd::findNearestVert(point, path, dist2) != scalarFindNearestVert(point, path, scalar_dist2) || dist2 != scalar_dist2)
+    {
+        mismatches.nearest_vert++;
+    }
+}
+
+/*!
+ * Random paths and points within \p range of a random centre within
+ * \p centre_range of the origin. Some of the points are vertices of the path,
+ * which are on its border.
+ */
+void compareRandom(std::mt19937_64& rng, const size_t cases, const coord_t range, const coord_t centre_range, Mismatches& mismatches)
+{
+    std::uniform_int_distribution<coord_t> coordinate(-range, range);
+    std::uniform_int_distribution<coord_t> centre_coordinate(-centre_range, centre_range);
+    std::uniform_int_distribution<size_t> vertex_count(0, 40);
+    for (size_t case_idx = 0; case_idx < cases; case_idx++)
+    {
+        const Point centre(centre_coordinate(rng), centre_coordinate(rng));
+        ClipperLib::Path path(vertex_count(rng));
+        for (Point& p : path)
+        {
+            p = centre + Point(coordinate(rng), coordinate(rng));
+        }
+        Point point = centre + Point(coordinate(rng), coordinate(rng));
+        if (! path.empty() && case_idx % 5 == 0)
+        {
+            point = path[rng() % path.size()];
+        }
+        const int64_t best_dist2 = case_idx % 2 == 0 ? range * range / 4 : std::numeric_limits<int64_t>::max();
+        compare(path, point, best_dist2, mismatches);
+    }
+}
+
+/*!
+ * Paths whose differences to the query point lie just within and just beyond
+ * 32 bits, with the query point itself at the 32-bit limits.
+ */
+void compareBoundary(std::mt19937_64& rng, const size_t cases, Mismatches& mismatches)
+{
+    constexpr coord_t limit = coord_t(1) << 31;
+    const coord_t centres[] = { 0, limit - 1, -limit, limit, coord_t(1) << 32 };
+    std::uniform_int_distribution<coord_t> jitter(-8, 8);
+    std::uniform_int_distribution<size_t> vertex_count(3, 40);
+    for (size_t case_idx = 0; case_idx < cases; case_idx++)
+    {
+        const coord_t centre = centres[case_idx % 5];
+        const Point point(centre + jitter(rng), centre + jitter(rng));
+        ClipperLib::Path path(vertex_count(rng));
+        for (Point& p : path)
+        {
+            const coord_t dx = (rng() % 2 ? limit : limit / 2) * (rng() % 2 ? 1 : -1) + jitter(rng);
+            const coord_t dy = (rng() % 3 == 0 ? limit / 2 : 0) * (rng() % 2 ? 1 : -1) + jitter(rng); // Keeps the squared distance within 63 bits.
+            p = point + Point(dx, dy);
+        }
+        compare(path, point, std::numeric_limits<int64_t>::max(), mismatches);
+    }
+}
+
+double milliseconds(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+ * Time both versions of each loop on a circle, like the outlines the engine
+ * runs them on most.
+ */
+void benchmark()
+{
+    constexpr size_t vertex_count = 2000;
+    constexpr size_t repeats = 20000;
+    ClipperLib::Path circle;
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const double angle = 2 * M_PI * i / vertex_count;
+        circle.emplace_back(coord_t(100000 * std::cos(angle)), coord_t(100000 * std::sin(angle)));
+    }
+    size_t checksum = 0; // Keeps the compiler from dropping the loops.
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        checksum += ClipperLib::PointInPolygon(Point(r % 1000, r % 777), circle);
+    }
+    const double inside_scalar = milliseconds(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        checksum += PolygonSimd::pointInPolygon(Point(r % 1000, r % 777), circle);
+    }
+    const double inside_simd = milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        Point min(POINT_MAX, POINT_MAX);
+        Point max(POINT_MIN, POINT_MIN);
+        scalarIncludeBounds(circle, min, max);
+        checksum += max.X - min.Y;
+    }
+    const double bounds_scalar = milliseconds(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        Point min(POINT_MAX, POINT_MAX);
+        Point max(POINT_MIN, POINT_MIN);
+        PolygonSimd::includeBounds(circle, min, max);
+        checksum += max.X - min.Y;
+    }
+    const double bounds_simd = milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        int64_t best_dist2 = std::numeric_limits<int64_t>::max();
+        checksum += scalarFindNearestVert(Point(r, r), circle, best_dist2);
+    }
+    const double nearest_scalar = milliseconds(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        int64_t best_dist2 = std::numeric_limits<int64_t>::max();
+        checksum += PolygonSimd::findNearestVert(Point(r, r), circle, best_dist2);
+    }
+    const double nearest_simd = milliseconds(start);
+
+    std::printf("%zu calls on %zu vertices (checksum %zu):\n", repeats, vertex_count, checksum);
+    std::printf("  pointInPolygon   scalar %8.1f ms  simd %8.1f ms  x%.2f\n", inside_scalar, inside_simd, inside_scalar / inside_simd);
+    std::printf("  includeBounds    scalar %8.1f ms  simd %8.1f ms  x%.2f\n", bounds_scalar, bounds_simd, bounds_scalar / bounds_simd);
+    std::printf("  findNearestVert  scalar %8.1f ms  simd %8.1f ms  x%.2f\n", nearest_scalar, nearest_simd, nearest_scalar / nearest_simd);
+}
+
+} // namespace
+
+} // namespace cura52
+
+int main(int argc, char** argv)
+{
+    using namespace cura52;
+
+    const size_t cases = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::printf("AVX2: %s\n", PolygonSimd::hasAvx2() ? "yes" : "no, both sides run the scalar loops");
+
+    std::mt19937_64 rng(1);
+    Mismatches mismatches;
+    compareRandom(rng, cases, 10, 0, mismatches);
+    compareRandom(rng, cases, 1000000, 0, mismatches);
+    compareRandom(rng, cases, coord_t(1) << 30, coord_t(1) << 40, mismatches);
+    compareBoundary(rng, cases, mismatches);
+    std::printf("Mismatches in %zu cases: pointInPolygon %zu, includeBounds %zu, findNearestVert %zu\n", 4 * cases, mismatches.point_in_polygon, mismatches.bounds, mismatches.nearest_vert);
+
+    benchmark();
+
+    return mismatches.point_in_polygon + mismatches.bounds + mismatches.nearest_vert == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#ifndef CRSLICE_ASYNC_SLICE_H
+#define CRSLICE_ASYNC_SLICE_H
+#include "crslice/crslice.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+
+namespace crslice
+{
+	enum class SliceStage
+	{
+		start,
+		slicing,
+		parts,
+		insetSkin,
+		support,
+		exportGCode,
+		finish
+	};
+
+	struct SliceProgressEvent
+	{
+		SliceStage stage;
+		float stageProgress;   // 0 - 1
+		float overallProgress; // 0 - 1
+	};
+
+	/*
+	 * A piece of the g-code file. Layer chunks and the end chunk follow each other,
+	 * appending them gives the file. The header is only known after the last layer:
+	 * it comes as a header chunk with offset 0, which replaces as many bytes at the
+	 * start of what was received before. The end chunk is always the last one.
+	 */
+	struct GCodeChunkEvent
+	{
+		enum class Type
+		{
+			layer,
+			header,
+			end
+		};
+
+		Type type;
+		int layer;     // the layer written last, for layer chunks
+		size_t offset; // where the data goes in the file
+		std::string data;
+	};
+
+	/*
+	 * Called on any of the threads which slice, never two at a time; slicing waits for
+	 * them to return. Anything they share with other threads of the caller needs its
+	 * own synchronisation.
+	 */
+	struct AsyncSliceCallbacks
+	{
+		std::function<void(const SliceProgressEvent&)> progress;
+		std::function<void(const GCodeChunkEvent&)> gcodeChunk; // leave empty to not read the g-code back
+	};
+
+	/*
+	 * Slices a scene on a thread of its own. The slice starts in the constructor, the
+	 * scene must not change until it is done. The g-code is written to the output file
+	 * of the scene like CrSlice does, and can be received in chunks while it is written.
+	 *
+	 * cancel() only sets a flag, which the engine checks wherever it checks the tracer.
+	 * Destroying a slice which is still running cancels it and waits for it to stop.
+	 */
+	class CRSLICE_API CrAsyncSlice
+	{
+	public:
+		CrAsyncSlice(CrScenePtr scene, const AsyncSliceCallbacks& callbacks = AsyncSliceCallbacks(),
+			ccglobal::Tracer* tracer = nullptr, const SliceResourceLimits& limits = SliceResourceLimits());
+		~CrAsyncSlice();
+
+		void cancel();
+		bool isCancelled() const;
+
+		/*
+		 * Becomes ready when the slice is done: true if the g-code is complete,
+		 * false if it was cancelled or interrupted.
+		 */
+		std::shared_future<bool> future() const;
+
+		/*
+		 * Waits for the slice to be done.
+		 */
+		SliceResult sliceResult() const;
+	protected:
+		void run(CrScenePtr scene, ccglobal::Tracer* tracer, SliceResourceLimits limits);
+
+		AsyncSliceCallbacks m_callbacks;
+		std::atomic<bool> m_cancel;
+		SliceResult m_sliceResult;
+		std::promise<bool> m_promise;
+		std::shared_future<bool> m_future;
+		std::thread m_thread;
+	};
+}
+
+typedef std::shared_ptr<crslice::CrAsyncSlice> CrAsyncSlicePtr;
+#endif  // CRSLICE_ASYNC_SLICE_H
@@ -9,6 +9,15 @@
 namespace crslice
 {
 	class CrGroup;
+	class SettingsBundle;
+
+	/*
+	 * Compile the settings of a scene json file (see CrScene::setSceneJsonFile) into a
+	 * binary bundle for CrScene::setSceneBundleFile. Run once per machine + material +
+	 * profile set, not per job.
+	 */
+	CRSLICE_API bool compileSettingsBundle(const std::string& jsonFile, const std::string& bundleFile);
+
 	class CRSLICE_API CrScene
 	{
 		friend class CrSlice;
@@ -25,7 +34,22 @@ namespace crslice
 		void setGroupSettings(int groupID, SettingsPtr settings);
 		void setSceneSettings(SettingsPtr settings);
 		void setSceneJsonFile(const std::string& fileName);
+		/*
+		 * Use a precompiled settings bundle as the base of the scene and extruder settings.
+		 * The settings given by setSceneSettings and the extruder settings are applied on top
+		 * of it, so a job only has to provide what it changes. The bundle is mapped read-only
+		 * and shared with the other scenes using the same file.
+		 */
+		bool setSceneBundleFile(const std::string& fileName);
 		void setTempDirectory(const std::string& directory);
+		/*
+		 * Keep finished slices in a directory, keyed by a hash of the meshes, offsets and
+		 * effective settings. Slicing a scene which is already in there copies the stored
+		 * g-code and result instead of running the engine. maxBytes bounds the size of the
+		 * directory, the least recently used slices are removed first; 0 means no bound.
+		 * An empty directory turns the cache off.
+		 */
+		void setResultCacheDirectory(const std::string& directory, size_t maxBytes);
 
 		void release();
 		CrGroup* getGroupsIndex(int groupID);
@@ -43,11 +67,14 @@ namespace crslice
 		std::vector<CrGroup*> m_groups;
 		SettingsPtr m_settings;
 		std::vector<SettingsPtr> m_extruders;
+		std::shared_ptr<const SettingsBundle> m_bundle;
 		bool machine_center_is_zero;
 
 		std::string m_gcodeFileName;
 		std::string m_ploygonFileName;
 		std::string m_tempDirectory;
+		std::string m_resultCacheDirectory;
+		size_t m_resultCacheMaxBytes;
 
 		FDMDebugger* m_debugger;
 	};
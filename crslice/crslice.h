@@ -14,6 +14,21 @@ namespace crslice
         double x;   // Ƭxߴ
         double y;   // Ƭyߴ
         double z;   // Ƭzߴ
+        int threads;  // Ƭʹọ̃߳߳ԻʱΪ0
+        double cpuQuota;  // CPU0Ϊ
+        unsigned long long memoryBudget;  // ڴԤ㣬λֽڣ0Ϊ
+        bool pinnedThreads;  // ߳ǷCPU
+    };
+
+    /*
+     * Per job caps on top of what the container allows. The tightest of these,
+     * the engine_* settings of the scene and the container limits wins.
+     */
+    struct SliceResourceLimits
+    {
+        int maxThreads = 0;  // including the main thread, 0 for no cap
+        size_t maxMemoryMB = 0;  // 0 for no cap
+        bool pinThreads = false;  // bind each worker thread to a CPU, Linux only
     };
 
 	class CRSLICE_API CrSlice
@@ -23,8 +38,11 @@ namespace crslice
 		~CrSlice();
 
 		void sliceFromScene(CrScenePtr scene, ccglobal::Tracer* tracer = nullptr);
+		void setResourceLimits(const SliceResourceLimits& limits);
 
         SliceResult sliceResult;
+	protected:
+		SliceResourceLimits m_resourceLimits;
 	};
 }
 #endif  // MSIMPLIFY_SIMPLIFY_H
@@ -16,6 +16,7 @@ set(engine_SRCS # Except main.cpp.
         ${PREFIX5.2}src/layerPart.cpp
         ${PREFIX5.2}src/LayerPlan.cpp
         ${PREFIX5.2}src/LayerPlanBuffer.cpp
+        ${PREFIX5.2}src/LayerSpillStore.cpp
         ${PREFIX5.2}src/mesh.cpp
         ${PREFIX5.2}src/MeshGroup.cpp
         ${PREFIX5.2}src/Mold.cpp
@@ -66,6 +67,7 @@ set(engine_SRCS # Except main.cpp.
         ${PREFIX5.2}src/infill/SubDivCube.cpp
         ${PREFIX5.2}src/infill/GyroidInfill.cpp
         ${PREFIX5.2}src/pathPlanning/Comb.cpp
+        ${PREFIX5.2}src/pathPlanning/CombBoundaryCache.cpp
         ${PREFIX5.2}src/pathPlanning/GCodePath.cpp
         ${PREFIX5.2}src/pathPlanning/LinePolygonsCrossings.cpp
         ${PREFIX5.2}src/pathPlanning/NozzleTempInsert.cpp
@@ -76,9 +78,12 @@ set(engine_SRCS # Except main.cpp.
         ${PREFIX5.2}src/settings/FlowTempGraph.cpp
         ${PREFIX5.2}src/settings/PathConfigStorage.cpp
         ${PREFIX5.2}src/settings/Settings.cpp
+        ${PREFIX5.2}src/settings/SharedSettings.cpp
         ${PREFIX5.2}src/settings/ZSeamConfig.cpp
         ${PREFIX5.2}src/utils/AABB.cpp
+        ${PREFIX5.2}src/utils/AABBGrid.cpp
         ${PREFIX5.2}src/utils/AABB3D.cpp
+        ${PREFIX5.2}src/utils/ClipperPool.cpp
         ${PREFIX5.2}src/utils/Date.cpp
         ${PREFIX5.2}src/utils/ExtrusionJunction.cpp
         ${PREFIX5.2}src/utils/ExtrusionLine.cpp
@@ -94,8 +99,11 @@ set(engine_SRCS # Except main.cpp.
         ${PREFIX5.2}src/utils/PolygonsSegmentIndex.cpp
         ${PREFIX5.2}src/utils/polygonUtils.cpp
         ${PREFIX5.2}src/utils/polygon.cpp
+        ${PREFIX5.2}src/utils/PolygonSimd.cpp
+        ${PREFIX5.2}src/utils/PolygonOffsetCache.cpp
         ${PREFIX5.2}src/utils/PolylineStitcher.cpp
         ${PREFIX5.2}src/utils/ProximityPointLink.cpp
+        ${PREFIX5.2}src/utils/ResourceGovernor.cpp
         ${PREFIX5.2}src/utils/Simplify.cpp
         ${PREFIX5.2}src/utils/SVG.cpp
         ${PREFIX5.2}src/utils/socket.cpp
@@ -109,6 +117,7 @@ set(engine_SRCS # Except main.cpp.
 
 		${PREFIX5.2}src/TreeSupportT.cpp
 		${PREFIX5.2}src/TreeSupportTipGenerator.cpp
+        ${PREFIX5.2}src/TreeModelVolumesDiskCache.cpp
         ${PREFIX5.2}src/TreeModelVolumesT.cpp
 
 		${PREFIX5.2}include/progress/Progress.h
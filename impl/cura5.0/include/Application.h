@@ -5,14 +5,18 @@
 #define APPLICATION_H
 
 #include "utils/NoCopy.h"
+#include <atomic>
 #include <cstddef> //For size_t.
 #include <cassert>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "FffProcessor.h"
 #include "progress/Progress.h"
+#include "SliceListener.h"
 #include "debugger.h"
+#include "utils/ResourceGovernor.h"
 #include "crslice/header.h"
 
 #include "ccglobal/tracer.h"
@@ -32,6 +36,10 @@ namespace cura52
         double x;   // Ƭxߴ
         double y;   // Ƭyߴ
         double z;   // Ƭzߴ
+        size_t thread_count; // Ƭʹõ߳߳
+        double cpu_quota; // CPU0Ϊ
+        size_t memory_budget; // ڴԤ㣬λֽڣ0Ϊ
+        bool pinned_threads; // ߳ǷCPU
 
         SliceResult()
         {
@@ -42,6 +50,10 @@ namespace cura52
             x = 0.0f;
             y = 0.0f;
             z = 0.0f;
+            thread_count = 0;
+            cpu_quota = 0.0;
+            memory_budget = 0;
+            pinned_threads = false;
         }
     };
 
@@ -76,6 +88,12 @@ namespace cura52
         ccglobal::Tracer* tracer = nullptr;
         Debugger* debugger = nullptr;
         crslice::FDMDebugger* fDebugger = nullptr;
+        SliceListener* listener = nullptr; //!< Optional, gets progress and g-code as the slice runs.
+        /*!
+         * Optional flag to cancel the slice with. It is checked before asking the
+         * tracer, so setting it from any thread stops the slice at the next check.
+         */
+        const std::atomic<bool>* cancel_flag = nullptr;
         /*
          * \brief The slice that is currently ongoing.
          *
@@ -88,12 +106,20 @@ namespace cura52
          */
         ThreadPool* thread_pool = nullptr;
 
+        /*!
+         * \brief How many threads and how much memory the slice may use.
+         *
+         * Detected from the container, made tighter by the caller and by the
+         * settings of the slice before the thread pool starts.
+         */
+        ResourceGovernor resources;
+
         void runCommulication(Communication* communication);
         /*!
          * \brief Start the global thread pool.
          *
          * If `nworkers` <= 0 and there is no pre-existing thread pool, a thread
-         * pool with hardware_concurrency() workers is initialized.
+         * pool with as many workers as \ref resources allows is initialized.
          * The thread pool is restarted when the number of thread differs from
          * previous invocations.
          *
@@ -102,12 +128,22 @@ namespace cura52
         void startThreadPool(int nworkers = 0);
 
         void sendProgress(float r);
-        bool checkInterrupt(const std::string& message = "");
+
+        /*!
+         * Hand progress and g-code to the \ref listener, if there is one. They
+         * are called from worker threads, one call at a time.
+         */
+        void notifyProgress(const Progress::Stage stage, const float stage_progress, const float overall_progress);
+        void notifyGCodeChunk(const GCodeChunk& chunk);
+
+        bool checkInterrupt(const char* message = "");
+        bool interrupted() const;
         void tick(const std::string& tag);
 
         SliceResult sliceResult;
     private:
-        bool m_error;
+        std::atomic<bool> m_error;
+        std::mutex listener_mutex; //!< Serialises the calls to the listener.
     };
 
 } //Cura namespace.
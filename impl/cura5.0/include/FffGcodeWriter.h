@@ -72,6 +72,9 @@ private:
 
     std::vector<std::vector<size_t>> mesh_order_per_extruder; //!< For each extruder, the order of the meshes (first element is first mesh to be printed)
 
+    LayerIndex layer_window_below = 0; //!< How many layers below the current one \ref FffGcodeWriter::processLayer reads, when layers are spilled to disk.
+    LayerIndex layer_window_above = 0; //!< How many layers above the current one \ref FffGcodeWriter::processLayer reads, when layers are spilled to disk.
+
     /*!
      * For each extruder on which layer the prime will be planned,
      * or a large negative number if it's already planned outside of \ref FffGcodeWriter::processLayer
@@ -93,8 +93,9 @@ private:
      * fuzzy skin, infill combine
      * 
      * \param mesh Input and Output parameter: fetches the outline information (see SliceLayerPart::outline) and generates the other reachable field of the \p storage
+     * \param mesh_idx The index of the mesh in the storage, used to seed the fuzzy skin.
      */
-    void processDerivedWallsSkinInfill(SliceMeshStorage& mesh);
+    void processDerivedWallsSkinInfill(SliceMeshStorage& mesh, const size_t mesh_idx);
     
     /*!
      * Checks whether a layer is empty or not
@@ -163,9 +164,15 @@ private:
      * 
      * This only changes the outer wall.
      * 
+     * Layers are processed in parallel. The random offsets are drawn from a
+     * generator keyed on the mesh, layer, wall and vertex, so the result does
+     * not depend on the number of threads or the order in which layers are
+     * processed.
+     * 
      * \param[in,out] mesh where the outer wall is retrieved and stored in.
+     * \param mesh_idx The index of the mesh in the storage.
      */
-    void processFuzzyWalls(SliceMeshStorage& mesh);
+    void processFuzzyWalls(SliceMeshStorage& mesh, const size_t mesh_idx);
 };
 
 }//namespace cura52
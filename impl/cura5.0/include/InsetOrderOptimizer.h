@@ -8,6 +8,7 @@
 
 #include "sliceDataStorage.h" //For SliceMeshStorage, which is used here at implementation in the header.
 #include "settings/ZSeamConfig.h"
+#include "utils/OrderConstraints.h"
 
 namespace cura52
 {
@@ -64,23 +65,25 @@ public:
 
     /*!
      * Get the order constraints of the insets when printing walls per region / hole.
-     * Each returned pair consists of adjacent wall lines where the left has an inset_idx one lower than the right.
+     * Each requirement is between adjacent wall lines, which differ one in inset_idx.
+     * The lines are referred to by their index in \p input.
      * 
      * Odd walls should always go after their enclosing wall polygons.
      * 
      * \param outer_to_inner Whether the wall polygons with a lower inset_idx should go before those with a higher one.
      */
-    static std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> getRegionOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner);
+    static OrderConstraints getRegionOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner);
 
     /*!
      * Get the order constraints of the insets when printing walls per inset.
-     * Each returned pair consists of adjacent wall lines where the left has an inset_idx one lower than the right.
+     * Each requirement is between wall lines which differ one in inset_idx.
+     * The lines are referred to by their index in \p input.
      * 
      * Odd walls should always go after their enclosing wall polygons.
      * 
      * \param outer_to_inner Whether the wall polygons with a lower inset_idx should go before those with a higher one.
      */
-    static std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> getInsetOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner);
+    static OrderConstraints getInsetOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner);
 
     /*!
      * Make order requirements transitive.
@@ -11,9 +11,12 @@
 #endif
 
 #include "FanSpeedLayerTime.h"
+#include "LayerSpillStore.h"
 #include "gcodeExport.h"
 #include "PathOrderOptimizer.h"
 #include "SpaceFillType.h"
+#include "bridge.h"
+#include "pathPlanning/CombBoundaryCache.h"
 #include "pathPlanning/GCodePath.h"
 #include "pathPlanning/NozzleTempInsert.h"
 #include "pathPlanning/TimeMaterialEstimates.h"
@@ -260,8 +263,8 @@ private:
     std::vector<bool> has_prime_tower_planned_per_extruder; //!< For each extruder, whether the prime tower is planned yet or not.
     std::optional<Point> last_planned_position; //!< The last planned XY position of the print head (if known)
 
-    std::string current_mesh; //<! A unique ID for the mesh of the last planned move.
-    std::string tmp_mesh_name;
+    MeshId current_mesh; //<! A unique ID for the mesh of the last planned move.
+    MeshId tmp_mesh_id;
     /*!
      * Whether the skirt or brim polygons have been processed into planned paths
      * for each extruder train.
@@ -279,17 +282,19 @@ private:
     std::optional<std::pair<Acceleration, Velocity>> next_layer_acc_jerk; //!< If there is a next layer, the first acceleration and jerk it starts with.
     bool was_inside; //!< Whether the last planned (extrusion) move was inside a layer part
     bool is_inside; //!< Whether the destination of the next planned travel move is inside a layer part
-    Polygons comb_boundary_minimum; //!< The minimum boundary within which to comb, or to move into when performing a retraction.
-    Polygons comb_boundary_preferred; //!< The boundary preferably within which to comb, or to move into when performing a retraction.
+    std::shared_ptr<const CombBoundaries> comb_boundaries; //!< The minimum and preferred boundaries within which to comb, or to move into when performing a retraction. Shared with other layers with the same outlines.
     Comb* comb;
     coord_t comb_move_inside_distance;  //!< Whenever using the minimum boundary for combing it tries to move the coordinates inside by this distance after calculating the combing.
     Polygons bridge_wall_mask; //!< The regions of a layer part that are not supported, used for bridging
+    BridgeSolidBelowCache bridge_solid_below; //!< The areas below this layer which bridging skins can rest on, shared by all skin parts of the layer.
     std::vector<Polygons> overhang_mask; //!< The regions of a layer part where the walls overhang
     std::vector<std::pair<float, float>> overhang_speed_sections;
     coord_t fill_lineWidth_diff;
 
     const std::vector<FanSpeedLayerTimeSettings> fan_speed_layer_time_settings_per_extruder;
 
+    LayerSpillStore::Window layer_window; //!< Keeps the mesh layers this plan reads in memory until the plan is deleted, since travels are combed only once the next layer is planned.
+
     enum CombBoundary
     {
         MINIMUM,
@@ -351,6 +356,13 @@ public:
 
     ~LayerPlan();
 
+    /*!
+     * Keep the mesh layers in \p window in memory for as long as this plan
+     * exists. Its travels are combed through the outlines of those layers
+     * after the plan is returned, when the next layer is added to the buffer.
+     */
+    void keepLayersInMemory(LayerSpillStore::Window&& window);
+
     void overrideFanSpeeds(double speed);
 
     /*!
@@ -425,10 +437,23 @@ public:
 
     /*!
      * Track the currently printing mesh.
-     * \param mesh_id A unique ID indicating the current mesh.
+     * \param mesh_id A unique ID indicating the current mesh, see \ref MeshIdRegistry.
+     */
+    void setMesh(const MeshId mesh_id);
+    void setMesh2(const MeshId mesh_id);
+    /*!
+     * Get the model areas below this layer which a bridging skin can rest on.
+     *
+     * These are computed once per layer and shared by all skin parts.
+     * \param bridge_layer The bridge layer number (1, 2 or 3) of the skin.
+     * \param sparse_infill_max_density The maximum infill density which is
+     * considered too sparse to support a bridge.
      */
-    void setMesh(const std::string mesh_id);
-    void setMesh2(const std::string mesh_id);
+    const BridgeSolidBelow& getBridgeSolidBelow(const unsigned bridge_layer, const Ratio sparse_infill_max_density)
+    {
+        return bridge_solid_below.get(storage, layer_nr - bridge_layer, bridge_layer == 1, sparse_infill_max_density);
+    }
+
     /*!
      * Set bridge_wall_mask.
      *
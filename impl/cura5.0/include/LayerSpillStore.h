@@ -0,0 +1,154 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef LAYER_SPILL_STORE_H
+#define LAYER_SPILL_STORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "settings/types/LayerIndex.h"
+#include "utils/NoCopy.h"
+
+namespace cura52
+{
+
+class SliceDataStorage;
+class SliceLayer;
+
+/*!
+ * Keeps the layers of the meshes of a slice data storage within a memory
+ * budget by moving them to a file in the temporary directory while they are
+ * not in use.
+ *
+ * A layer here means the \ref SliceLayer with the same index of every mesh.
+ * Whoever reads layers asks for a window of them with \ref require first. The
+ * layers in the window are read back from disk if they were spilled, and stay
+ * in memory until the returned \ref Window is destroyed. Whenever the layers in
+ * memory take more than the high-water mark, layers outside of all windows are
+ * spilled: first the ones below the lowest window, since those are done, then
+ * the ones farthest above.
+ *
+ * The layers are treated as read-only once spilling has started. A layer which
+ * was read back is dropped again without writing it if it has to make room.
+ * Only the parts, open polylines and top surfaces of the layers are spilled;
+ * the print height and thickness always stay in memory.
+ *
+ * The store is only used while the g-code is written, after all layers have
+ * been generated. It lowers the memory taken during the export, so that the
+ * layer plans and the g-code buffers fit next to the layers, but not the peak
+ * of the slice: that is reached before, with every layer generated and in
+ * memory.
+ */
+class LayerSpillStore : public NoCopy
+{
+public:
+    /*!
+     * Statistics on how much was moved to and from the disk.
+     */
+    struct Statistics
+    {
+        size_t spilled_layer_count = 0; //!< How many times a layer was written to disk.
+        size_t spilled_bytes = 0; //!< How much was written to disk.
+        size_t dropped_layer_count = 0; //!< How many times a layer which was already on disk was freed.
+        size_t faulted_layer_count = 0; //!< How many times a layer was read back from disk.
+        size_t faulted_bytes = 0; //!< How much was read back from disk.
+        size_t peak_resident_bytes = 0; //!< The most memory the layers took at any time, by estimate.
+    };
+
+    /*!
+     * Keeps a range of layers in memory for as long as it exists.
+     */
+    class Window
+    {
+    public:
+        Window() = default;
+        Window(Window&& other);
+        Window& operator=(Window&& other);
+        ~Window();
+
+    private:
+        friend class LayerSpillStore;
+        Window(LayerSpillStore* store, size_t first, size_t last);
+
+        LayerSpillStore* store = nullptr;
+        size_t first = 0;
+        size_t last = 0; //!< Inclusive.
+    };
+
+    /*!
+     * \param storage The storage of which to spill the mesh layers.
+     * \param directory The directory in which to create the spill file.
+     * \param high_water_bytes How much memory the mesh layers may take before
+     * they are spilled.
+     */
+    LayerSpillStore(SliceDataStorage& storage, const std::string& directory, const size_t high_water_bytes);
+
+    /*!
+     * Logs the statistics and removes the spill file. Doesn't read spilled
+     * layers back.
+     */
+    ~LayerSpillStore();
+
+    /*!
+     * Make sure the layers from \p first up to and including \p last are in
+     * memory, and keep them there until the returned window is destroyed.
+     *
+     * Layer numbers outside of the range of the meshes are ignored. May be
+     * called from multiple threads.
+     */
+    Window require(const LayerIndex first, const LayerIndex last);
+
+    /*!
+     * Get the statistics so far.
+     */
+    Statistics getStatistics() const;
+
+private:
+    struct LayerState
+    {
+        bool resident = true; //!< Whether the layer is in memory.
+        bool on_disk = false; //!< Whether the spill file has a copy of the layer.
+        uint64_t file_offset = 0; //!< Where the copy starts in the spill file.
+        uint64_t file_size = 0; //!< The size of the copy in the spill file.
+        size_t bytes = 0; //!< Estimate of the memory the layer takes when resident.
+        size_t pin_count = 0; //!< Number of windows which contain this layer.
+    };
+
+    void release(const size_t first, const size_t last);
+
+    /*!
+     * Spill layers which aren't in any window until the resident layers fit
+     * under the high-water mark again, or until there are no such layers left.
+     */
+    void enforceHighWater();
+
+    void spill(const size_t layer_nr);
+    void fault(const size_t layer_nr);
+
+    /*!
+     * Estimate of how much memory the layers of all meshes with this index take.
+     */
+    size_t residentBytes(const size_t layer_nr) const;
+
+    SliceDataStorage& storage;
+    const size_t high_water_bytes;
+    std::string file_name;
+    std::fstream file;
+    bool file_failed = false; //!< Stop spilling if the file can't be written.
+    uint64_t file_end = 0;
+
+    mutable std::mutex mutex;
+    std::vector<LayerState> layers;
+    size_t resident_bytes = 0;
+    size_t spill_below = 0; //!< All layers below this one are not resident.
+    size_t spill_above = 0; //!< All layers from this one upwards are not resident.
+    Statistics statistics;
+};
+
+} // namespace cura52
+
+#endif // LAYER_SPILL_STORE_H
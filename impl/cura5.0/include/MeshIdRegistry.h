@@ -0,0 +1,75 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef MESH_ID_REGISTRY_H
+#define MESH_ID_REGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cura52
+{
+
+/*!
+ * A small handle identifying a mesh by its name.
+ *
+ * Meshes with the same name get the same handle, so comparing handles is
+ * equivalent to comparing the names.
+ */
+using MeshId = uint32_t;
+
+/*!
+ * Maps mesh names to \ref MeshId handles and back, for one slice.
+ *
+ * Paths only store the handle; the name is looked up when it is written to
+ * the g-code. Names are registered while the meshes are put in the storage,
+ * after which the registry is only read, so it can be shared by the layer
+ * plans of all threads.
+ */
+class MeshIdRegistry
+{
+public:
+    static constexpr MeshId no_mesh = 0; //!< The handle of paths which don't belong to a mesh. Also used for meshes with an empty name.
+
+    MeshIdRegistry()
+    : names{ "" }
+    {
+    }
+
+    /*!
+     * Get the handle for a mesh name, registering it if it is new.
+     *
+     * Not thread-safe; only call this while setting up the storage.
+     */
+    MeshId intern(const std::string& name)
+    {
+        if (name.empty())
+        {
+            return no_mesh;
+        }
+        const auto inserted = ids.emplace(name, static_cast<MeshId>(names.size()));
+        if (inserted.second)
+        {
+            names.push_back(name);
+        }
+        return inserted.first->second;
+    }
+
+    /*!
+     * Get the name of the mesh with the given handle.
+     */
+    const std::string& getName(const MeshId id) const
+    {
+        return names[id];
+    }
+
+private:
+    std::vector<std::string> names; //!< The name of every handle, indexed by handle.
+    std::unordered_map<std::string, MeshId> ids;
+};
+
+} // namespace cura52
+
+#endif // MESH_ID_REGISTRY_H
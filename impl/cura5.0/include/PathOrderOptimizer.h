@@ -13,6 +13,7 @@
 #include "pathPlanning/LinePolygonsCrossings.h" //To prevent calculating combing distances if we don't cross the combing borders.
 #include "settings/EnumSettings.h" //To get the seam settings.
 #include "settings/ZSeamConfig.h" //To read the seam configuration.
+#include "utils/OrderConstraints.h"
 #include "utils/linearAlg2D.h" //To find the angle of corners to hide seams.
 #include "utils/polygonUtils.h"
 #include "utils/Simplify.h"
@@ -104,6 +105,22 @@ public:
         z_seam_max_angle = 0.;
     }
 
+    /*!
+     * Construct a new optimizer with order requirements given by the index
+     * in which the paths will be added.
+     *
+     * This avoids looking up the paths of each requirement, for callers which
+     * know the order in which they add the paths.
+     * \param order_constraints Which paths go before which others, by the
+     * index in which they are added with \ref addPolygon and
+     * \ref addPolyline. Must be finalized and outlive the optimizer.
+     */
+    PathOrderOptimizer(const Point start_point, const ZSeamConfig seam_config, const bool detect_loops, const Polygons* combing_boundary, const bool reverse_direction, const OrderConstraints& order_constraints)
+    : PathOrderOptimizer(start_point, seam_config, detect_loops, combing_boundary, reverse_direction)
+    {
+        this->order_constraints = &order_constraints;
+    }
+
     /*!
      * Add a new polygon to be optimized.
      * \param polygon The polygon to optimize.
@@ -212,22 +229,38 @@ public:
             }
         }
         
-        std::vector<size_t> blocked(paths.size(), 0); // Flag for seeing whether a path is blocked by a preceding toolpath to be printed first (and how many such blocking toolpaths there are)
-        std::vector<std::vector<size_t>> is_blocking(paths.size()); // For each path all paths that it is blocking, i.e. each path that it should precede
-        std::unordered_map<PathType, size_t> path_to_index;
-        for (size_t idx = 0; idx < paths.size(); idx++)
+        OrderConstraints requirement_constraints(paths.size()); // The order requirements given by path, translated to indices.
+        const OrderConstraints* constraints = order_constraints;
+        if (! constraints)
         {
-            path_to_index.emplace(paths[idx].vertices, idx);
+            if (! order_requirements->empty())
+            {
+                std::unordered_map<PathType, size_t> path_to_index;
+                for (size_t idx = 0; idx < paths.size(); idx++)
+                {
+                    path_to_index.emplace(paths[idx].vertices, idx);
+                }
+                for (auto [before, after] : *order_requirements)
+                {
+                    auto before_it = path_to_index.find(before);
+                    assert(before_it != path_to_index.end());
+                    auto after_it = path_to_index.find(after);
+                    assert(after_it != path_to_index.end());
+                    requirement_constraints.add(before_it->second, after_it->second);
+                }
+                requirement_constraints.finalize();
+            }
+            constraints = &requirement_constraints;
         }
-        for (auto [before, after] : *order_requirements)
-        {
-            auto after_it = path_to_index.find(after);
-            assert(after_it != path_to_index.end());
-            blocked[after_it->second]++;
+        assert(constraints->size() == paths.size());
 
-            auto before_it = path_to_index.find(before);
-            assert(before_it != path_to_index.end());
-            is_blocking[before_it->second].emplace_back(after_it->second);
+        std::vector<size_t> blocked(paths.size(), 0); // Flag for seeing whether a path is blocked by a preceding toolpath to be printed first (and how many such blocking toolpaths there are)
+        if (! constraints->empty())
+        {
+            for (size_t idx = 0; idx < paths.size(); idx++)
+            {
+                blocked[idx] = constraints->predecessorCount(idx);
+            }
         }
 
 
@@ -300,9 +333,12 @@ public:
             PathOrderPath<PathType>& best_path = paths[best_candidate];
             optimized_order.push_back(best_path);
             picked[best_candidate] = true;
-            for (size_t unlocked_idx : is_blocking[best_candidate])
+            if (! constraints->empty())
             {
-                blocked[unlocked_idx]--;
+                for (size_t unlocked_idx : constraints->successors(best_candidate))
+                {
+                    blocked[unlocked_idx]--;
+                }
             }
 
             if(!best_path.converted->empty()) //If all paths were empty, the best path is still empty. We don't upate the current position then.
@@ -429,6 +465,13 @@ protected:
      */
     const std::unordered_set<std::pair<PathType, PathType>>* order_requirements;
 
+    /*!
+     * Order requirements on the paths by the index in which they are added,
+     * if the optimizer was constructed with those instead of
+     * \ref order_requirements.
+     */
+    const OrderConstraints* order_constraints = nullptr;
+
     /*!
      * Find the vertex which will be the starting point of printing a polygon or
      * polyline.
@@ -158,11 +158,39 @@ protected:
     /*!
      * mapping each voronoi VD edge to the corresponding halfedge HE edge
      * In case the result segment is discretized, we map the VD edge to the *last* HE edge
+     *
+     * Indexed by the position of the VD edge / vertex in the diagram, see \ref heEdgeOf and \ref heNodeOf.
      */
-    std::unordered_map<vd_t::edge_type*, edge_t*> vd_edge_to_he_edge;
-    std::unordered_map<vd_t::vertex_type*, node_t*> vd_node_to_he_node;
+    std::vector<edge_t*> vd_edge_to_he_edge;
+    std::vector<node_t*> vd_node_to_he_node;
+    const vd_t::edge_type* vd_edges_begin = nullptr; //!< The first edge of the diagram which is being transferred.
+    const vd_t::vertex_type* vd_vertices_begin = nullptr; //!< The first vertex of the diagram which is being transferred.
     node_t& makeNode(vd_t::vertex_type& vd_node, Point p); //!< Get the node which the VD node maps to, or create a new mapping if there wasn't any yet.
 
+    /*!
+     * Start mapping the elements of a (newly constructed) diagram, with no
+     * half-edge counterparts yet.
+     */
+    void resetVoronoiMapping(const vd_t& vd);
+
+    /*!
+     * The half-edge mapped to a VD edge, or nullptr if it isn't mapped yet.
+     */
+    edge_t*& heEdgeOf(const vd_t::edge_type* vd_edge)
+    {
+        assert(vd_edge && static_cast<size_t>(vd_edge - vd_edges_begin) < vd_edge_to_he_edge.size());
+        return vd_edge_to_he_edge[vd_edge - vd_edges_begin];
+    }
+
+    /*!
+     * The node mapped to a VD vertex, or nullptr if it isn't mapped yet.
+     */
+    node_t*& heNodeOf(const vd_t::vertex_type* vd_node)
+    {
+        assert(vd_node && static_cast<size_t>(vd_node - vd_vertices_begin) < vd_node_to_he_node.size());
+        return vd_node_to_he_node[vd_node - vd_vertices_begin];
+    }
+
     /*!
      * (Eventual) returned 'polylines per index' result (from generateToolpaths):
      * 
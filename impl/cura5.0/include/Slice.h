@@ -4,11 +4,29 @@
 #ifndef SLICE_H
 #define SLICE_H
 
+#include <map>
+#include <mutex>
+
 #include "Scene.h" //To store the scene to slice.
+#include "utils/AABB.h"
+#include "utils/PolygonOffsetCache.h"
+#include "utils/polygon.h"
 
 namespace cura52
 {
     class Application;
+
+/*!
+ * The split lines of \ref Slice::ploygonFile, widened into polygons by the
+ * split gap, with the bounding box of each path so that layers can skip the
+ * paths they don't touch.
+ */
+struct SplitPolygons
+{
+    Polygons polygons;
+    std::vector<AABB> path_boxes; //!< One for each path of \ref polygons.
+};
+
 /*
  * \brief Represents a command to slice something.
  *
@@ -30,6 +48,13 @@ public:
     Scene scene;
     std::string gcodeFile;
     std::string ploygonFile;
+
+    /*!
+     * The offset caches of this slice keep their offsets within this budget,
+     * so that slices which run at the same time don't take from each other.
+     */
+    PolygonOffsetCache::Budget offset_cache_budget;
+
     /*
      * \brief Slice the scene, producing g-code output.
      *
@@ -48,7 +73,25 @@ public:
     void reset();
 
     void finalize();
+
+    /*!
+     * \brief Get the split polygons to subtract from the layers of a mesh.
+     *
+     * The polygon file is read once per slice and the widened polygons are
+     * kept per split gap, since every mesh subtracts them. May be called from
+     * multiple threads.
+     * \param mesh_settings The settings of the mesh, for the split gap. Only
+     * read if there are split lines.
+     * \return Empty if there is no polygon file or it has no lines.
+     */
+    const SplitPolygons& getSplitPolygons(const Settings& mesh_settings);
 private:
+    std::mutex split_polygons_mutex;
+    bool split_lines_loaded = false;
+    Polygons split_lines; //!< As read from \ref ploygonFile.
+    std::map<coord_t, SplitPolygons> split_polygons; //!< Per split gap.
+
+
     /*
      * \brief Disallow copying slice objects since they are heavyweight.
      *
@@ -0,0 +1,79 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef SLICE_LISTENER_H
+#define SLICE_LISTENER_H
+
+#include <cstddef> //For size_t.
+#include <string>
+
+#include "progress/Progress.h"
+#include "settings/types/LayerIndex.h"
+
+namespace cura52
+{
+
+/*!
+ * A piece of the g-code file, handed out as soon as it is written.
+ *
+ * Layer chunks and the end chunk are consecutive: each one starts where the
+ * previous one ended, so appending them gives the file. The header is only
+ * known when all layers are done; it is written over the placeholder at the
+ * start of the file, and then handed out again as a header chunk with offset 0
+ * which replaces the same number of bytes.
+ */
+struct GCodeChunk
+{
+    enum class Type
+    {
+        LAYER, //!< Everything up to and including a layer.
+        HEADER, //!< Replaces the start of what was handed out before.
+        END //!< Everything after the last layer. No chunks follow.
+    };
+
+    Type type = Type::LAYER;
+    LayerIndex layer_nr = 0; //!< The layer which was written last, for layer chunks.
+    size_t offset = 0; //!< Where the data goes in the file.
+    std::string data;
+};
+
+/*!
+ * Receives what a slice produces while it runs.
+ *
+ * The calls come from the worker threads of the slice, not from one thread in
+ * particular, but never more than one at a time. They should return quickly,
+ * since slicing waits for them.
+ */
+class SliceListener
+{
+public:
+    virtual ~SliceListener()
+    {
+    }
+
+    /*!
+     * \param stage The stage which is running.
+     * \param stage_progress How far the stage is, from 0 to 1.
+     * \param overall_progress How far the whole slice is, from 0 to 1.
+     */
+    virtual void onProgress(const Progress::Stage stage, const float stage_progress, const float overall_progress)
+    {
+    }
+
+    /*!
+     * Whether the g-code should be handed out in chunks. Reading the chunks back
+     * from the file costs a little, so this is off unless a listener asks.
+     */
+    virtual bool wantsGCodeChunks() const
+    {
+        return false;
+    }
+
+    virtual void onGCodeChunk(const GCodeChunk& chunk)
+    {
+    }
+};
+
+} // namespace cura52
+
+#endif // SLICE_LISTENER_H
@@ -0,0 +1,164 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef TREEMODELVOLUMESDISKCACHE_H
+#define TREEMODELVOLUMESDISKCACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "settings/types/LayerIndex.h"
+#include "utils/NoCopy.h"
+#include "utils/polygon.h"
+
+namespace cura54
+{
+
+/*!
+ * \brief Keeps the areas of \ref TreeModelVolumesT in a file, so that slicing
+ * the same models with the same support distances again can read them instead
+ * of calculating them.
+ *
+ * There is a file per key, in which the areas are stored with their points
+ * delta encoded. When a file for the key exists, only its index is read; every
+ * area is read when it is asked for. The least recently used files are removed
+ * when all files together take more than the size limit.
+ */
+class TreeModelVolumesDiskCache : public NoCopy
+{
+public:
+    /*!
+     * \brief The caches of \ref TreeModelVolumesT the areas belong to.
+     */
+    enum class Area : uint8_t
+    {
+        COLLISION,
+        COLLISION_HOLEFREE,
+        ACCUMULATED_PLACEABLE_0,
+        AVOIDANCE_COLLISION,
+        AVOIDANCE,
+        AVOIDANCE_SLOW,
+        AVOIDANCE_TO_MODEL,
+        AVOIDANCE_TO_MODEL_SLOW,
+        PLACEABLE,
+        AVOIDANCE_HOLE,
+        AVOIDANCE_HOLE_TO_MODEL,
+        WALL_RESTRICTION,
+        WALL_RESTRICTION_MIN
+    };
+
+    /*!
+     * \brief An area to store, by reference.
+     */
+    struct Entry
+    {
+        Area area;
+        cura52::coord_t radius;
+        cura52::LayerIndex layer_idx;
+        const cura52::Polygons* polygons;
+    };
+
+    /*!
+     * \brief Builds the key of a cache file from everything the areas depend on.
+     *
+     * Not meant to withstand an attacker, only to make accidental collisions unlikely.
+     */
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder();
+
+        void word(const uint64_t value);
+        void polygons(const cura52::Polygons& polygons);
+
+        /*!
+         * \brief The key as 32 hexadecimal digits.
+         */
+        std::string hex() const;
+
+    private:
+        uint64_t lane_a;
+        uint64_t lane_b;
+    };
+
+    /*!
+     * \brief Open the file of \p key in \p directory, if there is one.
+     * \param max_bytes How much all files together may take. Zero for no limit.
+     */
+    TreeModelVolumesDiskCache(const std::string& directory, const std::string& key, const size_t max_bytes);
+
+    /*!
+     * \brief Logs how much was read.
+     */
+    ~TreeModelVolumesDiskCache();
+
+    /*!
+     * \brief Whether a file with the areas of the key was found.
+     */
+    bool isComplete() const;
+
+    /*!
+     * \brief Read an area from the file. May be called from multiple threads.
+     * \param result[out] The area, if it was found.
+     * \return Whether the area was found.
+     */
+    bool load(const Area area, const cura52::coord_t radius, const cura52::LayerIndex layer_idx, cura52::Polygons& result);
+
+    /*!
+     * \brief Write the file of the key, replacing the one that was found if any,
+     * and remove the least recently used files if they take too much space.
+     */
+    void store(const std::vector<Entry>& entries);
+
+private:
+    struct EntryKey
+    {
+        uint8_t area;
+        int64_t radius;
+        int64_t layer_idx;
+
+        bool operator==(const EntryKey& other) const
+        {
+            return area == other.area && radius == other.radius && layer_idx == other.layer_idx;
+        }
+    };
+
+    struct EntryKeyHash
+    {
+        size_t operator()(const EntryKey& key) const;
+    };
+
+    struct Location
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    /*!
+     * \brief Read the header and the index of the file, if it exists and is valid.
+     */
+    void open();
+
+    /*!
+     * \brief Remove the least recently used files until they fit in max_bytes.
+     */
+    void evict() const;
+
+    std::string directory;
+    std::string file_name;
+    size_t max_bytes;
+
+    std::mutex mutex;
+    std::ifstream file;
+    std::unordered_map<EntryKey, Location, EntryKeyHash> index;
+    size_t loaded_count = 0;
+    size_t loaded_bytes = 0;
+};
+
+} // namespace cura54
+
+#endif // TREEMODELVOLUMESDISKCACHE_H
@@ -14,6 +14,7 @@
 #include "utils/Simplify.h"
 
 #include "TreeSupportEnums.h"
+#include "TreeModelVolumesDiskCache.h"
 
 //namespace cura52
 //{
@@ -356,6 +357,24 @@ namespace cura54
 
         static cura52::Polygons calculateMachineBorderCollision(const cura52::Polygons&& machine_border);
 
+        /*!
+         * \brief Key of the file in which the areas are kept between slices: a hash of the outlines, excluded areas and every setting the areas depend on.
+         * \param max_layer Up to which layer the areas are precalculated.
+         */
+        std::string getDiskCacheKey(cura52::coord_t max_layer) const;
+
+        /*!
+         * \brief Read an area from the file of the disk cache into the cache in memory, if the file has it.
+         * \return Whether the area is in the cache in memory now.
+         */
+        template <typename KEY>
+        bool loadFromDiskCache(TreeModelVolumesDiskCache::Area area, cura52::coord_t radius, cura52::LayerIndex layer_idx, std::unordered_map<KEY, cura52::Polygons>& cache, const KEY key, std::mutex& mutex);
+
+        /*!
+         * \brief Write everything that was precalculated to the file of the disk cache.
+         */
+        void storeToDiskCache();
+
         cura52::Application* application = nullptr;
         /*!
          * \brief The maximum distance that the center point of a tree branch may move in consecutive layers if it has to avoid the model.
@@ -524,6 +543,21 @@ namespace cura54
 
         std::unique_ptr<std::mutex> critical_progress = std::make_unique<std::mutex>();
 
+        /*!
+         * \brief Whether the areas are kept in a file in the temporary directory, to be read when slicing the same again.
+         */
+        bool disk_cache_enabled_ = false;
+
+        /*!
+         * \brief How many bytes the files of the disk cache may take together. Zero for no limit.
+         */
+        size_t disk_cache_max_bytes_ = 0;
+
+        /*!
+         * \brief The file of the disk cache of this mesh group, opened by precalculate.
+         */
+        std::unique_ptr<TreeModelVolumesDiskCache> disk_cache_;
+
         cura52::Simplify simplifier = cura52::Simplify(0, 0, 0); // a simplifier to simplify polygons. Will be properly initialised in the constructor.
     };
 
@@ -95,11 +95,14 @@ private:
     /*!
      * \brief Merges Influence Areas if possible.
      *
-     * Branches which do overlap have to be merged. This helper merges all elements in input with the elements into reduced_new_layer.
-     * Elements in input_aabb are merged together if possible, while elements reduced_new_layer_aabb are not checked against each other.
+     * Branches which do overlap have to be merged. This helper merges the elements of one cluster: each element is checked against the ones
+     * before it whose AABB hits its own, and merged with the first one it can be merged with. The result of a merge can merge again with
+     * the elements after it.
      *
-     * \param reduced_aabb[in,out] The already processed elements.
-     * \param input_aabb[in] Not yet processed elements
+     * \param cluster[in] The elements to merge, in the order to check them in.
+     * \param cluster_aabb[in] The AABB of each element of the cluster.
+     * \param cluster_unchanged[in] For each element of the cluster, whether it was checked against all other unchanged elements already.
+     *  Two of those are not checked again.
      * \param to_bp_areas[in] The Elements of the current Layer that will reach the buildplate. Value is the influence area where the center of a circle of support may be placed.
      * \param to_model_areas[in] The Elements of the current Layer that do not have to reach the buildplate. Also contains main as every element that can reach the buildplate is not forced to.
      *     Value is the influence area where the center of a circle of support may be placed.
@@ -107,19 +110,22 @@ private:
      * \param insert_bp_areas[out] Elements to be inserted into the main dictionary after the Helper terminates.
      * \param insert_model_areas[out] Elements to be inserted into the secondary dictionary after the Helper terminates.
      * \param insert_influence[out] Elements to be inserted into the dictionary containing the largest possibly valid influence area (ignoring if the area may not be there because of avoidance)
+     * \param insert_aabb[out] The AABBs of the elements which are inserted.
      * \param erase[out] Elements that should be deleted from the above dictionaries.
      * \param layer_idx[in] The Index of the current Layer.
      */
     void mergeHelper
     (
-        std::map<TreeSupportElementT, cura52::AABB>& reduced_aabb,
-        std::map<TreeSupportElementT, cura52::AABB>& input_aabb,
+        const std::vector<const TreeSupportElementT*>& cluster,
+        const std::vector<cura52::AABB>& cluster_aabb,
+        const std::vector<bool>& cluster_unchanged,
         const PropertyAreasUnordered& to_bp_areas,
         const PropertyAreas& to_model_areas,
         const PropertyAreas& influence_areas,
         PropertyAreasUnordered& insert_bp_areas,
         PropertyAreasUnordered& insert_model_areas,
         PropertyAreasUnordered& insert_influence,
+        std::unordered_map<TreeSupportElementT, cura52::AABB>& insert_aabb,
         std::vector<TreeSupportElementT>& erase,
         const cura52::LayerIndex layer_idx
     );
@@ -127,8 +133,8 @@ private:
     /*!
      * \brief Merges Influence Areas if possible.
      *
-     * Branches which do overlap have to be merged. This manages the helper and uses a divide and conquer approach to parallelize this problem.
-     * This parallelization can at most accelerate the merging by a factor of 2.
+     * Branches which do overlap have to be merged. The areas are put on a grid by their AABB to find the ones which may overlap, and grouped
+     * into clusters which can't merge with each other. The clusters are merged in parallel, as many at a time as there are threads.
      *
      * \param to_bp_areas[in] The Elements of the current Layer that will reach the buildplate.
      *  Value is the influence area where the center of a circle of support may be placed.
@@ -14,6 +14,8 @@
 
 namespace cura52
 {
+class SliceLayerPart;
+
 class WallToolPaths
 {
 public:
@@ -85,7 +87,49 @@ public:
      */
     static bool removeEmptyToolPaths(std::vector<VariableWidthLines>& toolpaths);
 
+    /*!
+     * Whether the toolpaths were generated with plain offsets of the outline
+     * rather than with the skeletal trapezoidation.
+     */
+    bool usedOffsetWalls() const;
+
+    /*!
+     * Take the offsets of the outline from the offset cache of \p part, when the
+     * outline is that of the part.
+     */
+    void setOutlinePart(const SliceLayerPart* part);
+
 protected:
+    /*!
+     * The outline offset like \ref Polygons::offset does, from the cache of the
+     * part if the outline belongs to one.
+     */
+    std::shared_ptr<const Polygons> offsetOutline(const coord_t distance, const ClipperLib::JoinType join_type = ClipperLib::jtMiter, const double miter_limit = 1.2) const;
+
+    /*!
+     * Whether the outline is nowhere thinner than the walls on both sides plus
+     * some margin, and has no corners sharp enough to get walls in their
+     * center. For such outlines the skeletal trapezoidation only produces
+     * walls of the nominal width, parallel to the outline, so plain offsets
+     * give the same walls.
+     *
+     * This is checked by eroding the outline by the wall thickness and growing
+     * it back. Parts which are too thin disappear or get cut off in the erosion
+     * and can't be grown back.
+     * \param wall_thickness The total width of all walls.
+     * \param transitioning_angle Corners sharper than this get walls in their
+     * center.
+     */
+    bool isUniformWidthOutline(const coord_t wall_thickness, const AngleRadians transitioning_angle) const;
+
+    /*!
+     * Generate the toolpaths and the inner contour with plain offsets of the
+     * outline. Only valid if \ref isUniformWidthOutline holds.
+     * \param spacing_0 The width of the outer wall.
+     * \param spacing_x The width of the inner walls.
+     */
+    void generateOffsetWalls(const coord_t spacing_0, const coord_t spacing_x);
+
     /*!
      * Stitch the polylines together and form closed polygons.
      * 
@@ -109,6 +153,7 @@ protected:
 
 private:
     const Polygons& outline; //<! A reference to the outline polygon that is the designated area
+    const SliceLayerPart* outline_part = nullptr; //<! The part of which outline is the outline, if any, to reuse its offsets.
     coord_t bead_width_0; //<! The nominal or first extrusion line width with which libArachne generates its walls
     coord_t bead_width_x; //<! The subsequently extrusion line width with which libArachne generates its walls if WallToolPaths was called with the nominal_bead_width Constructor this is the same as bead_width_0
     size_t inset_count; //<! The maximum number of walls to generate
@@ -119,6 +164,7 @@ private:
     double small_area_length; //<! The length of the small features which are to be filtered out, this is squared into a surface
     coord_t transition_length; //<! The transitioning length when the amount of extrusion lines changes
     bool toolpaths_generated; //<! Are the toolpaths generated
+    bool offset_walls = false; //<! Were the toolpaths generated with plain offsets
     std::vector<VariableWidthLines> toolpaths; //<! The generated toolpaths binned by inset_idx.
     Polygons inner_contour;  //<! The inner contour of the generated toolpaths
     const Settings& settings;
@@ -58,8 +58,10 @@ namespace cura52
          * Generates the walls / inner area for a single layer part.
          *
          * \param part The part for which to generate the insets.
+         * \return Whether the walls were generated with plain offsets of the
+         * outline, because the part is thick enough everywhere.
          */
-        void generateWalls(SliceLayerPart* part, SliceLayer* layer_upper = nullptr, SliceLayer* layer_lower = nullptr);
+        bool generateWalls(SliceLayerPart* part, SliceLayer* layer_upper = nullptr, SliceLayer* layer_lower = nullptr);
 
         /*!
          * Generates the outer inset / perimeter used in spiralize mode for a single layer part. The spiral inset is
@@ -4,30 +4,81 @@
 #ifndef BRIDGE_H
 #define BRIDGE_H
 
+#include <memory>
+#include <vector>
+
+#include "settings/types/Ratio.h"
+#include "utils/AABB.h"
+#include "utils/polygon.h"
+
 namespace cura52
 {
 
-class Polygons;
 class Settings;
 class SliceDataStorage;
 class SupportLayer;
 
+/*!
+ * \brief The model areas on a layer below a skin which a bridge could rest
+ * on.
+ *
+ * This only depends on the layer and on whether sparse infill is considered
+ * solid, so it is computed once and shared by all skin parts of all meshes
+ * above it.
+ */
+struct BridgeSolidBelow
+{
+    /*!
+     * \param storage The slice data storage where to find the layer parts.
+     * \param below_layer_nr The layer below the bridge.
+     * \param subtract_sparse_infill Whether the infill of parts with sparse
+     * infill can't support a bridge (only for the first bridge layer).
+     * \param sparse_infill_max_density The maximum infill density which is
+     * considered sparse.
+     */
+    BridgeSolidBelow(const SliceDataStorage& storage, const unsigned below_layer_nr, const bool subtract_sparse_infill, const Ratio sparse_infill_max_density);
+
+    unsigned below_layer_nr;
+    bool subtract_sparse_infill;
+    Ratio sparse_infill_max_density;
+
+    Polygons outline; //!< The solid areas of all parts together.
+    std::vector<Polygons> part_solid_below; //!< The solid area of each part, in mesh and part order.
+    std::vector<AABB> part_boxes; //!< The bounding box of each part, checked one by one to skip intersecting the parts which don't overlap a skin.
+};
+
+/*!
+ * \brief The \ref BridgeSolidBelow of the layers below one layer plan, created
+ * when first needed.
+ */
+class BridgeSolidBelowCache
+{
+public:
+    /*!
+     * Get the solid areas below a bridge, computing them on first use.
+     *
+     * See \ref BridgeSolidBelow::BridgeSolidBelow for the parameters.
+     */
+    const BridgeSolidBelow& get(const SliceDataStorage& storage, const unsigned below_layer_nr, const bool subtract_sparse_infill, const Ratio sparse_infill_max_density);
+
+private:
+    std::vector<std::unique_ptr<BridgeSolidBelow>> entries; //!< Only a few entries per layer: one per bridge layer and sparse infill threshold.
+};
+
 /*!
  * \brief Computes the angle that lines have to take to bridge a certain shape
- * best.
+ * best, using solid areas below which have been computed before.
  *
  * If the area should not be bridged, an angle of -1 is returned.
  * \param settings The settings container to get settings from.
  * \param skin_outline The shape to fill with lines.
- * \param storage The slice data storage where to find objects that the bridge
- * could rest on in previous layers.
- * \param layer_nr The layer currently being printed.
- * \param bridge_layer The bridge layer number (1, 2 or 3).
+ * \param solid_below The model areas on the layer below that the bridge
+ * could rest on.
  * \param support_layer Support that the bridge could rest on.
  * \param supported_regions Pre-computed regions that the support layer would
  * support.
  */
-int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const SliceDataStorage& storage, const unsigned layer_nr, const unsigned bridge_layer, const SupportLayer* support_layer, Polygons& supported_regions);
+int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const BridgeSolidBelow& solid_below, const SupportLayer* support_layer, Polygons& supported_regions);
 
 }//namespace cura52
 
@@ -5,6 +5,7 @@
 #define GCODEEXPORT_H
 
 #include <deque> // for extrusionAmountAtPreviousRetractions
+#include <fstream> // To read chunks back for the slice listener.
 #ifdef BUILD_TESTS
     #include <gtest/gtest_prod.h> //To allow tests to use protected members.
 #endif
@@ -190,6 +191,10 @@ private:
     Temperature build_volume_temperature;  //!< build volume temperature
     bool machine_heated_build_volume;  //!< does the machine have the ability to control/stabilize build-volume-temperature
     size_t m_preFixLen;
+
+    std::string chunk_source; //!< The file the output stream writes to, to read chunks back from. Empty if no chunks are handed out.
+    std::ifstream chunk_reader;
+    size_t emitted_bytes; //!< How much of the file was handed out in layer chunks.
 protected:
     /*!
      * Convert an E value to a value in mm (if it wasn't already in mm) for the current extruder.
@@ -277,6 +282,27 @@ public:
 
     void setOutputStream(std::ostream* stream);
 
+    /*!
+     * Hand the g-code to the slice listener in chunks, by reading back what was
+     * written to the output stream from the file it writes to.
+     *
+     * Only has an effect if the listener of the application wants chunks.
+     * \param file_name The file the output stream writes to.
+     */
+    void setChunkSource(const std::string& file_name);
+
+    /*!
+     * Hand everything written since the previous chunk to the slice listener,
+     * as the chunk of a layer.
+     */
+    void emitLayerChunk(const LayerIndex layer_nr);
+
+    /*!
+     * Hand the rest of the file to the slice listener. Call when no more g-code
+     * will be written.
+     */
+    void emitEndChunk();
+
     int getExtruderNum();
     bool getExtruderIsUsed(const int extruder_nr) const; //!< return whether the extruder has been used throughout printing all meshgroup up till now
 
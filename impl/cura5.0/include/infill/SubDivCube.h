@@ -4,28 +4,21 @@
 #ifndef INFILL_SUBDIVCUBE_H
 #define INFILL_SUBDIVCUBE_H
 
-#include "../settings/types/Ratio.h"
+#include <memory>
+#include <vector>
+
 #include "../utils/IntPoint.h"
 #include "../utils/Point3.h"
 
 namespace cura52
 {
 
-struct LayerIndex;
 class Polygons;
 class SliceMeshStorage;
 
 class SubDivCube
 {
 public:
-    /*!
-     * Constructor for SubDivCube. Recursively calls itself eight times to flesh out the octree.
-     * \param mesh contains infill layer data and settings
-     * \param my_center the center of the cube
-     * \param depth the recursion depth of the cube (0 is most recursed)
-     */
-    SubDivCube(SliceMeshStorage& mesh, Point3& center, size_t depth);
-
     ~SubDivCube(); //!< destructor (also destroys children)
 
     /*!
@@ -41,14 +34,6 @@ public:
      */
     void generateSubdivisionLines(const coord_t z, Polygons& result);
 private:
-    /*!
-     * Generates the lines of subdivision of the specific cube at the specific layer. It recursively calls itself, so it ends up drawing all the subdivision lines of sub-cubes too.
-     * \param z the specified layer height
-     * \param result (output) The resulting lines
-     * \param directional_line_groups Array of 3 times a polylines. Used to keep track of line segments that are all pointing the same direction for line segment combining
-     */
-    void generateSubdivisionLines(const coord_t z, Polygons (&directional_line_groups)[3]);
-
     struct CubeProperties
     {
         coord_t side_length; //!< side length of cubes
@@ -58,6 +43,50 @@ private:
         coord_t max_line_offset; //!< maximum line offsets. This is the maximum distance at which subdivision lines should be drawn from the 2d cube center.
     };
 
+    /*!
+     * The properties shared by all cubes of one octree.
+     *
+     * These used to be static members, which made it impossible to have two octrees (i.e. two slices) alive at the same time.
+     * They are owned by the root cube and referenced by all of its descendants.
+     */
+    struct OctreeProperties
+    {
+        std::vector<CubeProperties> cube_properties_per_recursion_step; //!< precomputed array of basic properties of cubes based on recursion depth.
+        Point3Matrix rotation_matrix; //!< The rotation matrix to get from axis aligned cubes to cubes standing on a corner point aligned with the infill_angle
+        PointMatrix infill_rotation_matrix; //!< Horizontal rotation applied to infill
+        coord_t radius_addition = 0; //!< addition to the bounding radius when determining if a cube should be subdivided
+    };
+
+    /*!
+     * The infill areas of a single layer along with the structures to query them quickly.
+     * Only alive while the octree is being constructed.
+     */
+    struct LayerInfillOutline;
+
+    /*!
+     * Construct a cube without any children.
+     * \param properties The properties of the octree this cube is part of
+     * \param center the center of the cube
+     * \param depth the recursion depth of the cube (0 is most recursed)
+     */
+    SubDivCube(const OctreeProperties* properties, const Point3& center, size_t depth);
+
+    /*!
+     * Create the children of this cube which need to be subdivided further.
+     * The children themselves are not subdivided; see \ref precomputeOctree.
+     * \param layer_outlines the infill outlines of all layers of the mesh
+     * \param layer_height the layer height of the mesh
+     */
+    void subdivide(const std::vector<LayerInfillOutline>& layer_outlines, const coord_t layer_height);
+
+    /*!
+     * Generates the lines of subdivision of the specific cube at the specific layer. It recursively calls itself, so it ends up drawing all the subdivision lines of sub-cubes too.
+     * \param z the specified layer height
+     * \param result (output) The resulting lines
+     * \param directional_line_groups Array of 3 times a polylines. Used to keep track of line segments that are all pointing the same direction for line segment combining
+     */
+    void generateSubdivisionLines(const coord_t z, Polygons (&directional_line_groups)[3]);
+
     /*!
      * Rotates a point 120 degrees about the origin.
      * \param target the point to rotate.
@@ -68,26 +97,17 @@ private:
      * Rotates a point to align it with the orientation of the infill.
      * \param target the point to rotate.
      */
-    static void rotatePointInitial(Point& target);
+    void rotatePointInitial(Point& target) const;
 
     /*!
      * Determines if a described theoretical cube should be subdivided based on if a sphere that encloses the cube touches the infill mesh.
-     * \param mesh contains infill layer data and settings
+     * \param layer_outlines the infill outlines of all layers of the mesh
+     * \param layer_height the layer height of the mesh
      * \param center the center of the described cube
      * \param radius the radius of the enclosing sphere
      * \return the described cube should be subdivided
      */
-    static bool isValidSubdivision(SliceMeshStorage& mesh, Point3& center, coord_t radius);
-
-    /*!
-     * Finds the distance to the infill border at the specified layer from the specified point.
-     * \param mesh contains infill layer data and settings
-     * \param layer_nr the number of the specified layer
-     * \param location the location of the specified point
-     * \param[out] distance2 the squared distance to the infill border
-     * \return Code 0: outside, 1: inside, 2: boundary does not exist at specified layer
-     */
-    static coord_t distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point& location, coord_t* distance2);
+    static bool isValidSubdivision(const std::vector<LayerInfillOutline>& layer_outlines, const coord_t layer_height, const Point3& center, coord_t radius);
 
     /*!
      * Adds the defined line to the specified polygons. It assumes that the specified polygons are all parallel lines. Combines line segments with touching ends closer than epsilon.
@@ -97,14 +117,11 @@ private:
      */
     void addLineAndCombine(Polygons& group, Point from, Point to);
 
+    const OctreeProperties* properties; //!< the properties of the octree this cube is part of
+    std::unique_ptr<OctreeProperties> owned_properties; //!< the storage of \ref properties. Only set for the root cube.
     size_t depth; //!< the recursion depth of the cube (0 is most recursed)
     Point3 center; //!< center location of the cube in absolute coordinates
     SubDivCube* children[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr}; //!< pointers to this cube's eight octree children
-    static std::vector<CubeProperties> cube_properties_per_recursion_step; //!< precomputed array of basic properties of cubes based on recursion depth.
-    static Ratio radius_multiplier; //!< multiplier for the bounding radius when determining if a cube should be subdivided
-    static Point3Matrix rotation_matrix; //!< The rotation matrix to get from axis aligned cubes to cubes standing on a corner point aligned with the infill_angle
-    static PointMatrix infill_rotation_matrix; //!< Horizontal rotation applied to infill
-    static coord_t radius_addition; //!< addition to the bounding radius when determining if a cube should be subdivided
 };
 
 }
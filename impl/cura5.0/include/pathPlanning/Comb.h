@@ -8,6 +8,7 @@
 #include <limits> // To find the maximum for coord_t.
 
 #include "../settings/types/LayerIndex.h" // To store the layer on which we comb.
+#include "CombBoundaryCache.h"
 #include "../utils/polygon.h"
 #include "../utils/polygonUtils.h"
 
@@ -125,12 +126,13 @@ private:
     static constexpr coord_t offset_dist_to_get_from_on_the_polygon_to_outside = 40; //!< in order to prevent on-boundary vs crossing boundary confusions (precision thing)
     static constexpr coord_t offset_extra_start_end = 100; //!< Distance to move start point and end point toward eachother to extra avoid collision with the boundaries.
 
-    Polygons boundary_inside_minimum; //!< The boundary within which to comb. (Will be reordered by the partsView_inside_minimum)
-    Polygons boundary_inside_optimal; //!< The boundary within which to comb. (Will be reordered by the partsView_inside_optimal)
-    const PartsView partsView_inside_minimum; //!< Structured indices onto boundary_inside_minimum which shows which polygons belong to which part.
-    const PartsView partsView_inside_optimal; //!< Structured indices onto boundary_inside_optimal which shows which polygons belong to which part.
-    std::unique_ptr<LocToLineGrid> inside_loc_to_line_minimum; //!< The SparsePointGridInclusive mapping locations to line segments of the inner boundary.
-    std::unique_ptr<LocToLineGrid> inside_loc_to_line_optimal; //!< The SparsePointGridInclusive mapping locations to line segments of the inner boundary.
+    const std::shared_ptr<const CombBoundaries> boundaries; //!< The inside boundaries, possibly shared with other layers with the same outlines.
+    const Polygons& boundary_inside_minimum; //!< The boundary within which to comb. (Reordered by the partsView_inside_minimum)
+    const Polygons& boundary_inside_optimal; //!< The boundary within which to comb. (Reordered by the partsView_inside_optimal)
+    const PartsView& partsView_inside_minimum; //!< Structured indices onto boundary_inside_minimum which shows which polygons belong to which part.
+    const PartsView& partsView_inside_optimal; //!< Structured indices onto boundary_inside_optimal which shows which polygons belong to which part.
+    const LocToLineGrid* const inside_loc_to_line_minimum; //!< The SparsePointGridInclusive mapping locations to line segments of the inner boundary.
+    const LocToLineGrid* const inside_loc_to_line_optimal; //!< The SparsePointGridInclusive mapping locations to line segments of the inner boundary.
     std::unordered_map<size_t, Polygons> boundary_outside; //!< The boundary outside of which to stay to avoid collision with other layer parts. This is a pointer cause we only compute it when we move outside the boundary (so not when there is only a single part in the layer)
     std::unordered_map<size_t, Polygons> model_boundary; //!< The boundary of the model itself
     std::unordered_map<size_t, std::unique_ptr<LocToLineGrid>> outside_loc_to_line; //!< The SparsePointGridInclusive mapping locations to line segments of the outside boundary.
@@ -165,9 +167,9 @@ private:
      * \param start_inside_poly[out] The polygon in which the point has been moved
      * \return Whether we have moved the point inside
      */
-    bool moveInside(Polygons& boundary_inside, bool is_inside, LocToLineGrid* inside_loc_to_line, Point& dest_point, unsigned int& start_inside_poly);
+    bool moveInside(const Polygons& boundary_inside, bool is_inside, const LocToLineGrid* inside_loc_to_line, Point& dest_point, unsigned int& start_inside_poly);
 
-    void moveCombPathInside(Polygons& boundary_inside, Polygons& boundary_inside_optimal, CombPath& comb_path_input, CombPath& comb_path_output);
+    void moveCombPathInside(const Polygons& boundary_inside, const Polygons& boundary_inside_optimal, CombPath& comb_path_input, CombPath& comb_path_output);
 
 public:
     /*!
@@ -179,10 +181,9 @@ public:
      * \param storage Where the layer polygon data is stored.
      * \param layer_nr The number of the layer for which to generate the combing
      * areas.
-     * \param comb_boundary_inside_optimal The better comb boundary within which
-     * to comb within layer parts.
-     * \param comb_boundary_inside_minimum The minimum comb boundary within
-     * which to comb within layer parts.
+     * \param boundaries The minimum and the better comb boundary within which
+     * to comb within layer parts, together with their parts views and location
+     * to line grids. Shared with other layers with the same outlines.
      * \param offset_from_outlines The offset from the outline polygon, to
      * create the combing boundary in case there is no second wall.
      * \param travel_avoid_distance The distance by which to avoid other layer
@@ -191,7 +192,7 @@ public:
      * combing it tries to move points inside by this amount after calculating
      * the path to move it from the border a bit.
      */
-    Comb(const SliceDataStorage& storage, const LayerIndex layer_nr, const Polygons& comb_boundary_inside_minimum, const Polygons& comb_boundary_inside_optimal, coord_t offset_from_outlines, coord_t travel_avoid_distance, coord_t move_inside_distance);
+    Comb(const SliceDataStorage& storage, const LayerIndex layer_nr, std::shared_ptr<const CombBoundaries> boundaries, coord_t offset_from_outlines, coord_t travel_avoid_distance, coord_t move_inside_distance);
 
     /*!
      * \brief Calculate the comb paths (if any), one for each polygon combed
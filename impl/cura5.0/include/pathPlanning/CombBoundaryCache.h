@@ -0,0 +1,141 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef PATH_PLANNING_COMB_BOUNDARY_CACHE_H
+#define PATH_PLANNING_COMB_BOUNDARY_CACHE_H
+
+#include <functional>
+#include <memory> // shared_ptr, weak_ptr
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../settings/types/LayerIndex.h"
+#include "../utils/polygon.h"
+#include "../utils/polygonUtils.h"
+
+namespace cura52
+{
+
+class SliceDataStorage;
+
+/*!
+ * The inside combing boundaries of a layer, together with the structures which
+ * \ref Comb builds on top of them.
+ *
+ * Everything in here only depends on the part outlines of the layer and the
+ * comb boundary offset, so layers with identical outlines can share a single
+ * instance. Once constructed it is never modified, which makes it safe to use
+ * from the layer plans of several threads at once.
+ */
+struct CombBoundaries
+{
+    /*!
+     * \param minimum The minimum comb boundary within which to comb within
+     * layer parts.
+     * \param preferred The better comb boundary within which to comb within
+     * layer parts.
+     * \param comb_boundary_offset The offset from the outline polygon, used as
+     * the cell size of the location to line grids.
+     */
+    CombBoundaries(Polygons&& minimum, Polygons&& preferred, const coord_t comb_boundary_offset);
+
+    CombBoundaries(const CombBoundaries&) = delete;
+    CombBoundaries& operator=(const CombBoundaries&) = delete;
+
+    const Polygons minimum; //!< The minimum boundary within which to comb, or to move into when performing a retraction.
+    const Polygons preferred; //!< The boundary preferably within which to comb, or to move into when performing a retraction.
+    Polygons inside_minimum; //!< Copy of \ref CombBoundaries::minimum, reordered by the partsView_inside_minimum
+    Polygons inside_optimal; //!< Copy of \ref CombBoundaries::preferred, reordered by the partsView_inside_optimal
+    const PartsView partsView_inside_minimum; //!< Structured indices onto inside_minimum which shows which polygons belong to which part.
+    const PartsView partsView_inside_optimal; //!< Structured indices onto inside_optimal which shows which polygons belong to which part.
+    const std::unique_ptr<LocToLineGrid> inside_loc_to_line_minimum; //!< The SparsePointGridInclusive mapping locations to line segments of inside_minimum.
+    const std::unique_ptr<LocToLineGrid> inside_loc_to_line_optimal; //!< The SparsePointGridInclusive mapping locations to line segments of inside_optimal.
+};
+
+/*!
+ * Shares the combing boundaries between layers whose part outlines are
+ * identical, which is very common for prismatic models.
+ *
+ * The cache only keeps weak references: the boundaries are freed as soon as
+ * the last \ref LayerPlan using them is destroyed. Layers are matched on a
+ * hash of the polygons which \ref LayerPlan::computeCombBoundary reads, and a
+ * hash match is only accepted after comparing those polygons exactly, so the
+ * shared boundaries are always the ones the layer would have computed itself.
+ * Every entry keeps its own copy of the polygons it was computed from, so that
+ * no other layer than the one being planned is ever read from the storage;
+ * that layer may be spilled to disk by then.
+ */
+class CombBoundaryCache
+{
+public:
+    using ComputeFunction = std::function<std::shared_ptr<const CombBoundaries>()>;
+
+    /*!
+     * Get the combing boundaries of a layer, reusing the ones of an earlier
+     * layer with the same outlines if some layer plan still holds them.
+     *
+     * \param storage Where the layer polygon data is stored.
+     * \param layer_nr The layer for which to get the boundaries.
+     * \param comb_boundary_offset The offset with which the boundaries are
+     * computed.
+     * \param compute Computes the boundaries when nothing can be shared.
+     * Called without holding the cache lock.
+     * \return The (possibly shared) boundaries of the layer.
+     */
+    std::shared_ptr<const CombBoundaries> get(const SliceDataStorage& storage, const LayerIndex layer_nr, const coord_t comb_boundary_offset, const ComputeFunction& compute);
+
+private:
+    /*!
+     * A copy of the polygons collected by \ref collectInputs. An empty optional
+     * takes the place of a nullptr separator.
+     */
+    using OwnedInputs = std::vector<std::optional<Polygons>>;
+
+    struct Entry
+    {
+        bool is_raft; //!< Whether the boundaries have been computed for a raft layer.
+        coord_t comb_boundary_offset;
+        OwnedInputs inputs; //!< The polygons from which the boundaries have been computed.
+        std::weak_ptr<const CombBoundaries> boundaries;
+    };
+
+    /*!
+     * Collect the polygons from which the combing boundaries of a layer are
+     * computed, in the order in which they are used.
+     *
+     * A nullptr separates the polygons of consecutive meshes, so that
+     * identical outlines which belong to different meshes (and thus get
+     * different offsets) are not confused.
+     */
+    static void collectInputs(const SliceDataStorage& storage, const LayerIndex layer_nr, std::vector<const Polygons*>& inputs);
+
+    static size_t hashInputs(const std::vector<const Polygons*>& inputs, const bool is_raft, const coord_t comb_boundary_offset);
+
+    static OwnedInputs copyInputs(const std::vector<const Polygons*>& inputs);
+
+    static bool haveSameInputs(const std::vector<const Polygons*>& inputs, const OwnedInputs& owned);
+
+    /*!
+     * Find a live entry computed from the same inputs.
+     *
+     * Should be called with the mutex locked.
+     */
+    std::shared_ptr<const CombBoundaries> find(const bool is_raft, const coord_t comb_boundary_offset, const size_t hash, const std::vector<const Polygons*>& inputs);
+
+    /*!
+     * Remove the entries of which all layer plans have been destroyed.
+     *
+     * Should be called with the mutex locked.
+     */
+    void removeExpired();
+
+    std::mutex mutex;
+    std::unordered_multimap<size_t, Entry> entries;
+    size_t next_cleanup_size = 64; //!< Remove expired entries once the map grows to this size.
+};
+
+} // namespace cura52
+
+#endif // PATH_PLANNING_COMB_BOUNDARY_CACHE_H
@@ -4,6 +4,7 @@
 #ifndef PATH_PLANNING_G_CODE_PATH_H
 #define PATH_PLANNING_G_CODE_PATH_H
 
+#include "../MeshIdRegistry.h"
 #include "../SpaceFillType.h"
 #include "../settings/types/Ratio.h"
 #include "../utils/IntPoint.h"
@@ -29,7 +30,7 @@ class GCodePath
 {
 public:
     const GCodePathConfig* config; //!< The configuration settings of the path.
-    std::string mesh_id; //!< Which mesh this path belongs to, if any. If it's not part of any mesh, the mesh ID should be 0.
+    MeshId mesh_id; //!< Which mesh this path belongs to, if any. If it's not part of any mesh, the mesh ID should be MeshIdRegistry::no_mesh.
     SpaceFillType space_fill_type; //!< The type of space filling of which this path is a part
     Ratio flow; //!< A type-independent flow configuration
     Ratio width_factor; //!< Adjustment to the line width. Similar to flow, but causes the speed_back_pressure_factor to be adjusted.
@@ -55,7 +56,7 @@ public:
      * \brief Creates a new g-code path.
      *
      * \param config The line configuration to use when printing this path.
-     * \param mesh_id The mesh that this path is part of.
+     * \param mesh_id The handle of the mesh that this path is part of.
      * \param space_fill_type The type of space filling of which this path is a
      * part.
      * \param flow The flow rate to print this path with.
@@ -64,7 +65,7 @@ public:
      * \param speed_factor The factor that the travel speed will be multiplied with
      * this path.
      */
-    GCodePath(const GCodePathConfig& config, std::string mesh_id, const SpaceFillType space_fill_type, const Ratio flow, const Ratio width_factor, const bool spiralize, const Ratio speed_factor = 1.0);
+    GCodePath(const GCodePathConfig& config, const MeshId mesh_id, const SpaceFillType space_fill_type, const Ratio flow, const Ratio width_factor, const bool spiralize, const Ratio speed_factor = 1.0);
 
     /*!
      * Whether this config is the config of a travel path.
@@ -14,6 +14,7 @@
 #define MAX_INFILL_COMBINE 8
 
 #include <map>
+#include <memory> // shared_ptr
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +32,7 @@ namespace cura52
  * using the add() function.
  */
     class Application;
+class SharedSettings;
 class Settings
 {
 public:
@@ -52,8 +54,8 @@ public:
      * \brief Get the value of a setting.
      *
      * This value is then evaluated using the following technique:
-     *  1. If this container contains a value for the setting, it uses that
-     *     value directly.
+     *  1. If this container contains a value for the setting, or the shared
+     *     values below it do, it uses that value directly.
      *  2. Otherwise it checks if the setting is limited to an extruder, and if
      *     so, takes the setting value from that extruder. It applies the
      *     limiting only once at most.
@@ -97,6 +99,14 @@ public:
      */
     void setParent(Settings* new_parent);
 
+    /*
+     * Set the values to use below the own values of this container.
+     *
+     * They count as values of this container itself, but are shared with the
+     * containers of other slices instead of being copied into each of them.
+     */
+    void setShared(std::shared_ptr<const SharedSettings> new_shared);
+
 public:
     /*!
      * Optionally, a parent setting container to ask for the value of a setting
@@ -109,6 +119,12 @@ public:
      */
     std::unordered_map<std::string, std::string> settings;
 
+    /*!
+     * \brief Values which this container has unless \ref settings overrides
+     * them, shared with other containers.
+     */
+    std::shared_ptr<const SharedSettings> shared;
+
     /*!
      * \brief Get the value of a setting, but without looking at the limiting to
      * extruder.
@@ -119,6 +135,17 @@ public:
      * \return The setting's value.
      */
     std::string getWithoutLimiting(const std::string& key) const;
+
+private:
+    /*!
+     * \brief Find the serialised value of a setting, the way ``get`` does.
+     * \param key The key of the setting to find.
+     * \param number[out] If not nullptr, set to the value read as a number
+     * when the value is a shared one, or else to nullptr.
+     * \param limit Whether to look at the limiting to extruder.
+     * \return The setting's value.
+     */
+    const std::string& lookup(const std::string& key, const double** number, const bool limit) const;
 };
 
 } //namespace cura52
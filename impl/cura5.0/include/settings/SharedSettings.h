@@ -0,0 +1,54 @@
+// Copyright (c) 2022 Ultimaker B.V.
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef SETTINGS_SHARED_SETTINGS_H
+#define SETTINGS_SHARED_SETTINGS_H
+
+#include <string>
+#include <unordered_map>
+
+namespace cura52
+{
+
+/*!
+ * \brief Setting values which the settings containers of many slices read,
+ * but which none of them changes.
+ *
+ * A machine, material and profile give the same values for every slice. The
+ * containers of a slice refer to one instance of this instead of each getting
+ * a copy, and only hold the values the slice changes. Besides their serialised
+ * form, the values are kept read as numbers, since most settings are asked for
+ * as numbers and many of them are asked for very often.
+ */
+class SharedSettings
+{
+public:
+    struct Value
+    {
+        std::string serialised; //!< The value as it would have been added to the container.
+        double number; //!< The value read as a number, the same way \ref Settings::get<double> reads it.
+    };
+
+    /*!
+     * \brief Adds a value, replacing the one there was.
+     *
+     * Only to be used while filling the instance, before any container refers
+     * to it.
+     */
+    void add(const std::string& key, const std::string& value);
+
+    /*!
+     * \brief Get the value of a setting.
+     * \return The value, or nullptr if there is none for the setting.
+     */
+    const Value* find(const std::string& key) const;
+
+    const std::unordered_map<std::string, Value>& getValues() const;
+
+private:
+    std::unordered_map<std::string, Value> values;
+};
+
+} // namespace cura52
+
+#endif // SETTINGS_SHARED_SETTINGS_H
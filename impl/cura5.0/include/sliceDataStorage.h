@@ -5,8 +5,11 @@
 #define SLICE_DATA_STORAGE_H
 
 #include <map>
+#include <memory>
 #include <optional>
 
+#include "LayerSpillStore.h"
+#include "MeshIdRegistry.h"
 #include "PrimeTower.h"
 #include "RetractionConfig.h"
 #include "SupportInfillPart.h"
@@ -19,7 +22,9 @@
 #include "utils/IntPoint.h"
 #include "utils/NoCopy.h"
 #include "utils/polygon.h"
+#include "utils/PolygonOffsetCache.h"
 #include "WipeScriptConfig.h"
+#include "pathPlanning/CombBoundaryCache.h"
 
 // libArachne
 #include "utils/ExtrusionLine.h"
@@ -148,12 +153,33 @@ public:
      */
     const Polygons& getOwnInfillArea() const;
 
+    /*!
+     * Get the outline offset like \ref Polygons::offset does, reusing the result
+     * if another stage asked for the same offset of the same outline before.
+     * \param stage Which stage asks, for the statistics.
+     * \param budget The offset cache budget of the slice, \ref Slice::offset_cache_budget.
+     */
+    std::shared_ptr<const Polygons> getOutlineOffset(const coord_t distance, const PolygonOffsetCache::Stage stage, PolygonOffsetCache::Budget& budget, const ClipperLib::JoinType join_type = ClipperLib::jtMiter, const double miter_limit = 1.2) const;
+
+    /*!
+     * Get the own infill area offset like \ref Polygons::offset does, reusing the
+     * result if another stage asked for the same offset before.
+     * \see SliceLayerPart::getOwnInfillArea
+     * \param stage Which stage asks, for the statistics.
+     * \param budget The offset cache budget of the slice, \ref Slice::offset_cache_budget.
+     */
+    std::shared_ptr<const Polygons> getOwnInfillAreaOffset(const coord_t distance, const PolygonOffsetCache::Stage stage, PolygonOffsetCache::Budget& budget, const ClipperLib::JoinType join_type = ClipperLib::jtMiter, const double miter_limit = 1.2) const;
+
     /*!
      * Searches whether the part has any walls in the specified inset index
      * \param inset_idx The index of the wall
      * \return true if there is at least one ExtrusionLine at the specified wall index, false otherwise
      */
     bool hasWallAtInsetIndex(size_t inset_idx) const;
+
+private:
+    PolygonOffsetCache outline_offsets; //!< Offsets of \ref SliceLayerPart::outline which were asked for before.
+    PolygonOffsetCache infill_area_offsets; //!< Offsets of the own infill area which were asked for before.
 };
 
 /*!
@@ -166,6 +192,7 @@ public:
     coord_t thickness;  //!< The thickness of this layer. Can be different when using variable layer heights.
     std::vector<SliceLayerPart> parts;  //!< An array of LayerParts which contain the actual data. The parts are printed one at a time to minimize travel outside of the 3D model.
     Polygons openPolyLines; //!< A list of lines which were never hooked up into a 2D polygon. (Currently unused in normal operation)
+    size_t offset_wall_part_count = 0; //!< How many of the parts got their walls from plain offsets of the outline, rather than from the skeletal trapezoidation.
 
     /*!
      * \brief The parts of the model that are exposed at the very top of the
@@ -249,6 +276,7 @@ public:
     Settings& settings;
     std::vector<SliceLayer> layers;
     std::string mesh_name;
+    MeshId mesh_id = MeshIdRegistry::no_mesh; //!< The handle of mesh_name in SliceDataStorage::mesh_ids.
 
     LayerIndex layer_nr_max_filled_layer; //!< the layer number of the uppermost layer with content (modified while infill meshes are processed)
 
@@ -301,6 +329,18 @@ public:
      * \return the mesh's user specified z seam hint
      */
     Point getZSeamHint() const;
+
+    /*!
+     * Estimate how much work a layer of this mesh is, relative to the other
+     * layers: the number of vertices of the outlines of its parts.
+     */
+    double getLayerCost(const LayerIndex layer_nr) const;
+
+    /*!
+     * The estimated cost of every layer, for scheduling the layers over the
+     * threads. Never zero, so empty layers are cheap but not free.
+     */
+    std::vector<double> getLayerCosts() const;
 };
 
 class SliceDataStorage
@@ -312,12 +352,15 @@ public:
     Point3 model_size, model_min, model_max;
     AABB3D machine_size; //!< The bounding box with the width, height and depth of the printer.
     std::vector<SliceMeshStorage> meshes;
+    MeshIdRegistry mesh_ids; //!< Handles for the names of the meshes, used to tag the planned paths.
 
     std::vector<WipeScriptConfig> wipe_config_per_extruder; //!< Wipe configs per extruder.
 
     std::vector<RetractionConfig> retraction_config_per_extruder; //!< Retraction config per extruder.
     std::vector<RetractionConfig> extruder_switch_retraction_config_per_extruder; //!< Retraction config per extruder for when performing an extruder switch
 
+    mutable CombBoundaryCache comb_boundary_cache; //!< Combing boundaries shared between the layer plans of layers with the same outlines.
+
     SupportStorage support;
 
     Polygons skirt_brim[MAX_EXTRUDERS]; //!< Skirt and brim polygons per extruder, ordered from inner to outer polygons.
@@ -339,6 +382,8 @@ public:
 
     std::vector<ClipperLib::IntPoint> polyOrderUserDef; //polygon order
 
+    std::unique_ptr<LayerSpillStore> layer_spill; //!< Moves the mesh layers to disk while writing g-code, if they take too much memory. Null when not spilling.
+
     /*!
      * \brief Creates a new slice data storage that stores the slice data of the
      * current mesh group.
@@ -362,6 +407,13 @@ public:
      */
     Polygons getLayerOutlines(const LayerIndex layer_nr, const bool include_support, const bool include_prime_tower, const bool external_polys_only = false, const bool for_brim = false) const;
 
+    /*!
+     * Estimate of the work to plan each layer from \p first up to but not
+     * including \p last: the vertices of the outlines of the meshes, the
+     * support and the raft, plus one.
+     */
+    std::vector<double> getLayerCosts(const LayerIndex first, const LayerIndex last) const;
+
     /*!
      * Get the extruders used.
      * 
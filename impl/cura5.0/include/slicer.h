@@ -32,6 +32,11 @@ namespace cura52
         // with the vertex that it ended on.
         const MeshVertex* endVertex = nullptr;
         bool addedToPolygon = false;
+        // The segments of the same layer that may continue this one, from the face
+        // across the end edge or the faces around endVertex. This is the range
+        // [nextCandidatesBegin, nextCandidatesEnd) of SlicerLayer::next_segment_candidates.
+        uint32_t nextCandidatesBegin = 0;
+        uint32_t nextCandidatesEnd = 0;
     };
 
     class ClosePolygonResult
@@ -56,7 +61,7 @@ namespace cura52
     {
     public:
         std::vector<SlicerSegment> segments;
-        std::unordered_map<int, int> face_idx_to_segment_idx; // topology
+        std::vector<int> next_segment_candidates; // topology, see SlicerSegment::nextCandidatesBegin
 
         int z = -1;
         Polygons polygons;
@@ -394,14 +399,14 @@ namespace cura52
         };
 
         /*!
-         * Try to find a segment from face \p face_idx to continue \p segment.
+         * Try whether the segment with index \p candidate_segment_idx continues \p segment.
          *
          * \param[in] segment The previous segment that we want to find a continuation for.
-         * \param[in] face_idx The index of the face that might have generated a continuation segment.
+         * \param[in] candidate_segment_idx The index of a segment whose face touches the end of \p segment.
          * \param[in] start_segment_idx The index of the segment that started this polyline.
          */
-        int tryFaceNextSegmentIdx(const SlicerSegment& segment,
-            const int face_idx, const size_t start_segment_idx) const;
+        int tryNextSegmentIdx(const SlicerSegment& segment,
+            const int candidate_segment_idx, const size_t start_segment_idx) const;
 
         /*!
          * Find possible allowed stitches in goodness order.
@@ -572,6 +577,11 @@ namespace cura52
             std::vector<SlicerLayer>& layers
         );
 
+        /*!
+         * Find for each segment of \p layer which segments may continue it, see
+         * SlicerSegment::nextCandidatesBegin.
+         */
+        static void linkSegments(const Mesh& mesh, SlicerLayer& layer);
     };
 
 }//namespace cura52
@@ -209,6 +209,24 @@ private:
      */
     static Polygons join(const SliceDataStorage& storage, const Polygons& supportLayer_up, Polygons& supportLayer_this, const coord_t smoothing_distance);
 
+    /*!
+     * \brief Join current support layer with the support of the layer above.
+     *
+     * Same as \ref AreaSupport::join but with the border for conical support
+     * precomputed, so that it isn't recomputed for every layer.
+     * \param machine_volume_border The area within which conical support may
+     * grow, see \ref AreaSupport::getConicalSupportBorder.
+     */
+    static Polygons join(const SliceDataStorage& storage, const Polygons& supportLayer_up, Polygons& supportLayer_this, const coord_t smoothing_distance, const Polygons& machine_volume_border);
+
+    /*!
+     * Get the area within which conical support may grow: the build volume
+     * minus the room needed for the platform adhesion.
+     * \param storage Where the machine size and used extruders are stored.
+     * \return The border polygons.
+     */
+    static Polygons getConicalSupportBorder(const SliceDataStorage& storage);
+
     /*!
      * Move the support up from model (cut away polygons to ensure bottom z distance)
      * and apply stair step transformation.
@@ -217,7 +235,7 @@ private:
      * the top half of the step will be as wide as the stair step width
      * and the bottom half will follow the model.
      * 
-     * \param storage Where to get model outlines from
+     * \param outlines_per_layer The model outlines of every layer (without support or prime tower)
      * \param[in,out] stair_removal The polygons to be removed for stair stepping on the current layer (input) and for the next layer (output). Only changed every [step_height] layers.
      * \param[in,out] support_areas The support areas before and after this function
      * \param layer_idx The layer number of the support layer we are processing
@@ -225,7 +243,7 @@ private:
      * \param bottom_stair_step_layer_count The max height (in nr of layers) of the support bottom stairs
      * \param support_bottom_stair_step_width The max width of the support bottom stairs
      */
-    static void moveUpFromModel(const SliceDataStorage& storage, Polygons& stair_removal, Polygons& sloped_areas, Polygons& support_areas, const size_t layer_idx, const size_t bottom_empty_layer_count, const size_t bottom_stair_step_layer_count, const coord_t support_bottom_stair_step_width);
+    static void moveUpFromModel(const std::vector<Polygons>& outlines_per_layer, Polygons& stair_removal, Polygons& sloped_areas, Polygons& support_areas, const size_t layer_idx, const size_t bottom_empty_layer_count, const size_t bottom_stair_step_layer_count, const coord_t support_bottom_stair_step_width);
 
     /*!
      * Joins the layer part outlines of all meshes and collects the overhang
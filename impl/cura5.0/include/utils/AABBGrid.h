@@ -0,0 +1,83 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_AABB_GRID_H
+#define UTILS_AABB_GRID_H
+
+#include <unordered_map>
+#include <utility> //For pair.
+#include <vector>
+
+#include "AABB.h"
+#include "SquareGrid.h"
+
+namespace cura52
+{
+
+/*!
+ * Bounding boxes on a uniform grid, to find the boxes which overlap without
+ * checking every pair of them.
+ *
+ * The boxes are referred to by an index, which the caller chooses; usually the
+ * position of what the box belongs to in some list. Every box is listed in each
+ * cell it covers, so the cell size should be about the size of a typical box.
+ */
+class AABBGrid : public SquareGrid
+{
+public:
+    AABBGrid(const coord_t cell_size);
+
+    /*!
+     * A cell size for \p boxes: the median of their sizes, but large enough that
+     * no box covers more than about 64 by 64 cells.
+     */
+    static coord_t getCellSize(const std::vector<AABB>& boxes);
+
+    /*!
+     * Add a box. Boxes without area (like the box of no polygons) are ignored.
+     * \param index The index to refer to the box by. Must not be in the grid.
+     */
+    void insert(const size_t index, const AABB& box);
+
+    /*!
+     * Remove the box which was inserted with \p index.
+     */
+    void remove(const size_t index);
+
+    /*!
+     * The indices of the boxes in the grid which hit \p box, in ascending order.
+     */
+    std::vector<size_t> getHits(const AABB& box) const;
+
+    /*!
+     * All pairs of boxes in the grid which hit each other, each pair once, with
+     * the smaller index first.
+     */
+    std::vector<std::pair<size_t, size_t>> getHittingPairs() const;
+
+private:
+    /*!
+     * Call \p process_cell with every cell \p box covers.
+     */
+    template<typename ProcessFunc>
+    void processCells(const AABB& box, const ProcessFunc& process_cell) const
+    {
+        const GridPoint min_grid = toGridPoint(box.min);
+        const GridPoint max_grid = toGridPoint(box.max);
+        for (coord_t grid_y = min_grid.Y; grid_y <= max_grid.Y; ++grid_y)
+        {
+            for (coord_t grid_x = min_grid.X; grid_x <= max_grid.X; ++grid_x)
+            {
+                process_cell(GridPoint(grid_x, grid_y));
+            }
+        }
+    }
+
+    std::unordered_map<GridPoint, std::vector<size_t>> cells; //!< The indices of the boxes which cover each cell.
+    std::vector<AABB> boxes; //!< The boxes by index.
+    std::vector<bool> inserted; //!< Whether the box of each index is in the grid.
+};
+
+} // namespace cura52
+
+#endif // UTILS_AABB_GRID_H
@@ -0,0 +1,96 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_CLIPPER_POOL_H
+#define UTILS_CLIPPER_POOL_H
+
+#include <cstddef> //For size_t.
+#include <memory>
+#include <polyclipping/clipper.hpp>
+
+#include "NoCopy.h"
+
+namespace cura52
+{
+
+/*!
+ * Clipper engines which each thread keeps and reuses, instead of constructing
+ * one for every polygon operation.
+ *
+ * An engine is leased with \ref PooledClipper or \ref PooledClipperOffset. When
+ * the lease ends the engine is cleared and goes back to the thread it was
+ * leased on, keeping the memory it allocated for its internal lists. A thread
+ * which leases an engine while it holds one (an operation inside an operation)
+ * gets a second one, so a thread keeps as many engines as it ever nested.
+ */
+class ClipperPool
+{
+public:
+    /*!
+     * How often engines were leased, and how often a new one had to be
+     * constructed for it. Without the pool these would be the same.
+     */
+    struct Statistics
+    {
+        size_t leases = 0;
+        size_t constructed = 0;
+    };
+
+    /*!
+     * The totals of all threads since the start of the process. Slices which
+     * run at the same time count towards the same totals.
+     */
+    static Statistics getStatistics();
+};
+
+/*!
+ * A \ref ClipperLib::Clipper leased from the pool of this thread, set to the
+ * given init options. Use it like a pointer.
+ */
+class PooledClipper : public NoCopy
+{
+public:
+    explicit PooledClipper(const int init_options = 0);
+    ~PooledClipper();
+
+    ClipperLib::Clipper* operator->()
+    {
+        return engine.get();
+    }
+
+    ClipperLib::Clipper& operator*()
+    {
+        return *engine;
+    }
+
+private:
+    std::unique_ptr<ClipperLib::Clipper> engine;
+};
+
+/*!
+ * A \ref ClipperLib::ClipperOffset leased from the pool of this thread, set to
+ * the given miter limit and arc tolerance. Use it like a pointer.
+ */
+class PooledClipperOffset : public NoCopy
+{
+public:
+    PooledClipperOffset(const double miter_limit = 2.0, const double arc_tolerance = 0.25);
+    ~PooledClipperOffset();
+
+    ClipperLib::ClipperOffset* operator->()
+    {
+        return engine.get();
+    }
+
+    ClipperLib::ClipperOffset& operator*()
+    {
+        return *engine;
+    }
+
+private:
+    std::unique_ptr<ClipperLib::ClipperOffset> engine;
+};
+
+} // namespace cura52
+
+#endif // UTILS_CLIPPER_POOL_H
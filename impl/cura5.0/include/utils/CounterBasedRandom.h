@@ -0,0 +1,75 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_COUNTER_BASED_RANDOM_H
+#define UTILS_COUNTER_BASED_RANDOM_H
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace cura52
+{
+
+/*!
+ * A stateless pseudo random number generator.
+ *
+ * Every number is a hash of a key and the index of the draw, so the sequence
+ * only depends on the key it was constructed with. Unlike rand() it has no
+ * hidden global state: generators can be created anywhere, from any thread,
+ * and the same key always produces the same numbers regardless of the order in
+ * which the work is done.
+ */
+class CounterBasedRandom
+{
+public:
+    /*!
+     * \param key The values identifying this stream of random numbers, e.g.
+     * mesh, layer and vertex index.
+     */
+    CounterBasedRandom(std::initializer_list<uint64_t> key)
+    {
+        for (const uint64_t k : key)
+        {
+            this->key = mix(this->key ^ k);
+        }
+    }
+
+    /*!
+     * Get the next random number of this stream.
+     */
+    uint64_t next()
+    {
+        return mix(key + ++counter * golden_gamma);
+    }
+
+    /*!
+     * Get the next random number of this stream, in the range [0, \p range).
+     * \param range Must be positive.
+     */
+    int64_t next(const int64_t range)
+    {
+        return static_cast<int64_t>(next() % static_cast<uint64_t>(range));
+    }
+
+private:
+    static constexpr uint64_t golden_gamma = 0x9E3779B97F4A7C15ull;
+
+    /*!
+     * SplitMix64 finalizer: a bijective mix in which every input bit affects
+     * every output bit.
+     */
+    static uint64_t mix(uint64_t x)
+    {
+        x += golden_gamma;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t key = 0;
+    uint64_t counter = 0; //!< How many numbers have been drawn from this stream.
+};
+
+} // namespace cura52
+
+#endif // UTILS_COUNTER_BASED_RANDOM_H
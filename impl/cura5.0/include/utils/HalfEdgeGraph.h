@@ -5,13 +5,13 @@
 #define UTILS_HALF_EDGE_GRAPH_H
 
 
-#include <list>
 #include <cassert>
 
 
 
 #include "HalfEdge.h"
 #include "HalfEdgeNode.h"
+#include "PooledList.h"
 #include "SVG.h"
 
 namespace cura52
@@ -22,8 +22,8 @@ class HalfEdgeGraph
 public:
     using edge_t = derived_edge_t;
     using node_t = derived_node_t;
-    std::list<edge_t> edges;
-    std::list<node_t> nodes;
+    PooledList<edge_t> edges;
+    PooledList<node_t> nodes;
 };
 
 } // namespace cura52
@@ -0,0 +1,154 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_ORDER_CONSTRAINTS_H
+#define UTILS_ORDER_CONSTRAINTS_H
+
+#include <algorithm> //For sort and unique.
+#include <assert.h>
+#include <stddef.h> //For size_t.
+#include <utility> //For pair.
+#include <vector>
+
+namespace cura52
+{
+
+/*!
+ * Requirements on the order in which a list of items is processed.
+ *
+ * The items are referred to by their index in the list. Each requirement says
+ * that one item must come before another. After adding all requirements,
+ * \ref finalize turns them into a directed graph in compressed sparse row
+ * form: the successors of an item are one contiguous range, and the number of
+ * predecessors of each item is known without searching.
+ *
+ * Duplicate requirements are only counted once.
+ */
+class OrderConstraints
+{
+public:
+    /*!
+     * A contiguous range of item indices.
+     */
+    struct Range
+    {
+        const size_t* first;
+        const size_t* last;
+
+        const size_t* begin() const
+        {
+            return first;
+        }
+        const size_t* end() const
+        {
+            return last;
+        }
+    };
+
+    /*!
+     * \param item_count The number of items which are being ordered.
+     */
+    explicit OrderConstraints(const size_t item_count = 0)
+    : item_count(item_count)
+    {
+    }
+
+    /*!
+     * Require that the item with index \p before goes before the item with
+     * index \p after.
+     */
+    void add(const size_t before, const size_t after)
+    {
+        assert(before < item_count && after < item_count);
+        const std::pair<size_t, size_t> edge(before, after);
+        if (! edges.empty() && edges.back() == edge)
+        {
+            return; // Neighbouring junctions often produce the same requirement many times in a row.
+        }
+        edges.push_back(edge);
+        finalized = false;
+    }
+
+    /*!
+     * Build the graph from the requirements added so far.
+     *
+     * Must be called before querying the constraints.
+     */
+    void finalize()
+    {
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        offsets.assign(item_count + 1, 0);
+        predecessor_counts.assign(item_count, 0);
+        successors_.clear();
+        successors_.reserve(edges.size());
+        for (const std::pair<size_t, size_t>& edge : edges)
+        {
+            offsets[edge.first + 1]++;
+            predecessor_counts[edge.second]++;
+            successors_.push_back(edge.second);
+        }
+        for (size_t item_idx = 0; item_idx < item_count; item_idx++)
+        {
+            offsets[item_idx + 1] += offsets[item_idx];
+        }
+        finalized = true;
+    }
+
+    /*!
+     * The number of items which are being ordered.
+     */
+    size_t size() const
+    {
+        return item_count;
+    }
+
+    /*!
+     * Whether there are no requirements at all.
+     */
+    bool empty() const
+    {
+        return edges.empty();
+    }
+
+    /*!
+     * The number of distinct requirements.
+     */
+    size_t requirementCount() const
+    {
+        assert(finalized);
+        return successors_.size();
+    }
+
+    /*!
+     * The items which must go after the given item.
+     */
+    Range successors(const size_t item_idx) const
+    {
+        assert(finalized);
+        const size_t* data = successors_.data();
+        return Range{ data + offsets[item_idx], data + offsets[item_idx + 1] };
+    }
+
+    /*!
+     * The number of items which must go before the given item.
+     */
+    size_t predecessorCount(const size_t item_idx) const
+    {
+        assert(finalized);
+        return predecessor_counts[item_idx];
+    }
+
+private:
+    size_t item_count;
+    bool finalized = true; //!< Whether the graph is up to date with the added requirements.
+    std::vector<std::pair<size_t, size_t>> edges; //!< The requirements, as (before, after) pairs. Sorted after finalizing.
+    std::vector<size_t> offsets; //!< Where the successors of each item start in \ref successors_. One extra element marks the end.
+    std::vector<size_t> successors_; //!< The successors of all items, grouped per item.
+    std::vector<size_t> predecessor_counts; //!< For each item the number of items which must go before it.
+};
+
+} // namespace cura52
+
+#endif // UTILS_ORDER_CONSTRAINTS_H
@@ -0,0 +1,312 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_PACKED_SPARSE_POINT_GRID_H
+#define UTILS_PACKED_SPARSE_POINT_GRID_H
+
+#include <algorithm> //For sort.
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "IntPoint.h"
+#include "SquareGrid.h"
+
+namespace cura52 {
+
+/*! \brief Sparse grid which can locate spatially nearby elements efficiently,
+ * for grids which are filled completely before they are queried.
+ *
+ * This has the same interface as \ref SparsePointGrid, but stores the elements
+ * of each cell contiguously in one array, and finds the cells through a flat
+ * open addressing hash table rather than a node based multimap. Elements are
+ * inserted first; \ref finalize then sorts them by cell in one go. Querying
+ * doesn't allocate and visits the elements of a cell in the order in which they
+ * were inserted.
+ *
+ * \tparam ElemT The element type to store.
+ * \tparam Locator The functor to get the location from ElemT.  Locator
+ *    must have: Point operator()(const ElemT &elem) const
+ *    which returns the location associated with val.
+ */
+template<class ElemT, class Locator>
+class PackedSparsePointGrid : public SquareGrid
+{
+public:
+    using Elem = ElemT;
+    using GridPoint = SquareGrid::GridPoint;
+    using const_iterator = typename std::vector<Elem>::const_iterator;
+
+    /*! \brief Constructs a sparse grid with the specified cell size.
+     *
+     * \param[in] cell_size The size to use for a cell (square) in the grid.
+     *    Typical values would be around 0.5-2x of expected query radius.
+     * \param[in] elem_reserve Number of elements to reserve space for.
+     */
+    PackedSparsePointGrid(coord_t cell_size, size_t elem_reserve = 0U)
+    : SquareGrid(cell_size)
+    {
+        elems.reserve(elem_reserve);
+        elem_cells.reserve(elem_reserve);
+    }
+
+    /*! \brief Inserts elem into the sparse grid.
+     *
+     * The element can only be found after the next call to \ref finalize.
+     * \param[in] elem The element to be inserted.
+     */
+    void insert(const Elem& elem)
+    {
+        elem_cells.push_back(toGridPoint(m_locator(elem)));
+        elems.push_back(elem);
+        finalized = false;
+    }
+
+    /*! \brief Sort the inserted elements into their cells and build the cell
+     * table. Must be called after inserting and before querying.
+     */
+    void finalize();
+
+    /*!
+     * Iterate over all elements, grouped by cell.
+     */
+    const_iterator begin() const
+    {
+        assert(finalized);
+        return elems.begin();
+    }
+
+    const_iterator end() const
+    {
+        return elems.end();
+    }
+
+    size_t size() const
+    {
+        return elems.size();
+    }
+
+    /*! \brief Returns all data within radius of query_pt.
+     *
+     * Finds all elements with location within radius of \p query_pt.  May
+     * return additional elements that are beyond radius.
+     *
+     * \param[in] query_pt The point to search around.
+     * \param[in] radius The search radius.
+     * \return Vector of elements found
+     */
+    std::vector<Elem> getNearby(const Point& query_pt, coord_t radius) const
+    {
+        std::vector<Elem> ret;
+        processNearby(query_pt, radius, [&ret](const Elem& elem)
+            {
+                ret.push_back(elem);
+                return true;
+            });
+        return ret;
+    }
+
+    /*!
+     * Find the nearest element to a given \p query_pt within \p radius.
+     *
+     * \param[in] query_pt The point for which to find the nearest object.
+     * \param[in] radius The search radius.
+     * \param[out] elem_nearest the nearest element. Only valid if function returns true.
+     * \param[in] precondition A precondition which must return true for an element
+     *    to be considered for output
+     * \return True if and only if an object has been found within the radius.
+     */
+    template<typename Precondition>
+    bool getNearest(const Point& query_pt, coord_t radius, Elem& elem_nearest, const Precondition& precondition) const
+    {
+        bool found = false;
+        int64_t best_dist2 = static_cast<int64_t>(radius) * radius;
+        processNearby(query_pt, radius, [&](const Elem& elem)
+            {
+                if (!precondition(elem))
+                {
+                    return true;
+                }
+                const int64_t dist2 = vSize2(m_locator(elem) - query_pt);
+                if (dist2 < best_dist2)
+                {
+                    found = true;
+                    elem_nearest = elem;
+                    best_dist2 = dist2;
+                }
+                return true;
+            });
+        return found;
+    }
+
+    bool getNearest(const Point& query_pt, coord_t radius, Elem& elem_nearest) const
+    {
+        return getNearest(query_pt, radius, elem_nearest, [](const Elem&) { return true; });
+    }
+
+    /*! \brief Process elements from cells that might contain sought after points.
+     *
+     * Processes all elements that are within radius of query_pt.  May process
+     * elements that are up to radius + cell_size from query_pt.
+     *
+     * \param[in] query_pt The point to search around.
+     * \param[in] radius The search radius.
+     * \param[in] process_func Processes each element.  process_func(elem) is
+     *    called for each element in the cell. Processing stops if function returns false.
+     * \return Whether we need to continue processing after this function
+     */
+    template<typename ProcessFunc>
+    bool processNearby(const Point& query_pt, coord_t radius, const ProcessFunc& process_func) const
+    {
+        return processNearbyCells(query_pt, radius, [&process_func, this](const GridPoint& grid_pt)
+            {
+                return processFromCell(grid_pt, process_func);
+            });
+    }
+
+    /*! \brief Process elements from the cell indicated by \p grid_pt.
+     *
+     * \param[in] grid_pt The grid coordinates of the cell.
+     * \param[in] process_func Processes each element.  process_func(elem) is
+     *    called for each element in the cell. Processing stops if function returns false.
+     * \return Whether we need to continue processing a next cell.
+     */
+    template<typename ProcessFunc>
+    bool processFromCell(const GridPoint& grid_pt, const ProcessFunc& process_func) const
+    {
+        assert(finalized);
+        const Cell* cell = findCell(grid_pt);
+        if (!cell)
+        {
+            return true;
+        }
+        for (uint32_t elem_idx = cell->begin; elem_idx < cell->end; ++elem_idx)
+        {
+            if (!process_func(elems[elem_idx]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+protected:
+    /*!
+     * A slot of the cell table: a cell and the range of its elements in
+     * \ref elems. Empty slots have an empty range.
+     */
+    struct Cell
+    {
+        GridPoint location;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    size_t slotOf(const GridPoint& grid_pt) const
+    {
+        uint64_t hash = (static_cast<uint64_t>(grid_pt.X) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(grid_pt.Y) * 0xC2B2AE3D27D4EB4Full);
+        hash ^= hash >> 31;
+        return static_cast<size_t>(hash ^ (hash >> 17)) & slot_mask;
+    }
+
+    const Cell* findCell(const GridPoint& grid_pt) const
+    {
+        if (cells.empty())
+        {
+            return nullptr;
+        }
+        for (size_t slot = slotOf(grid_pt);; slot = (slot + 1) & slot_mask)
+        {
+            const Cell& cell = cells[slot];
+            if (cell.begin == cell.end)
+            {
+                return nullptr; // Reached an empty slot: not in the table.
+            }
+            if (cell.location == grid_pt)
+            {
+                return &cell;
+            }
+        }
+    }
+
+    /*! \brief Accessor for getting locations from elements. */
+    Locator m_locator;
+
+    std::vector<Elem> elems; //!< All elements, grouped by cell after finalizing.
+    std::vector<GridPoint> elem_cells; //!< The cell of each element in \ref elems.
+    std::vector<Cell> cells; //!< Open addressing table with linear probing, at most half full.
+    size_t slot_mask = 0;
+    bool finalized = true;
+};
+
+template<class ElemT, class Locator>
+void PackedSparsePointGrid<ElemT, Locator>::finalize()
+{
+    assert(elems.size() < std::numeric_limits<uint32_t>::max());
+
+    // Sort by cell, keeping the insertion order within each cell.
+    std::vector<uint32_t> order(elems.size());
+    for (uint32_t elem_idx = 0; elem_idx < order.size(); ++elem_idx)
+    {
+        order[elem_idx] = elem_idx;
+    }
+    std::sort(order.begin(), order.end(), [this](const uint32_t a, const uint32_t b)
+        {
+            const GridPoint& cell_a = elem_cells[a];
+            const GridPoint& cell_b = elem_cells[b];
+            if (cell_a.X != cell_b.X)
+            {
+                return cell_a.X < cell_b.X;
+            }
+            if (cell_a.Y != cell_b.Y)
+            {
+                return cell_a.Y < cell_b.Y;
+            }
+            return a < b;
+        });
+    std::vector<Elem> sorted_elems;
+    std::vector<GridPoint> sorted_cells;
+    sorted_elems.reserve(elems.size());
+    sorted_cells.reserve(elems.size());
+    size_t cell_count = 0;
+    for (const uint32_t elem_idx : order)
+    {
+        if (sorted_cells.empty() || !(sorted_cells.back() == elem_cells[elem_idx]))
+        {
+            cell_count++;
+        }
+        sorted_elems.push_back(std::move(elems[elem_idx]));
+        sorted_cells.push_back(elem_cells[elem_idx]);
+    }
+    elems.swap(sorted_elems);
+    elem_cells.swap(sorted_cells);
+
+    size_t slot_count = 8;
+    while (slot_count < cell_count * 2)
+    {
+        slot_count *= 2;
+    }
+    slot_mask = slot_count - 1;
+    cells.assign(slot_count, Cell());
+    for (uint32_t begin = 0; begin < elems.size();)
+    {
+        uint32_t end = begin + 1;
+        while (end < elems.size() && elem_cells[end] == elem_cells[begin])
+        {
+            ++end;
+        }
+        size_t slot = slotOf(elem_cells[begin]);
+        while (cells[slot].begin != cells[slot].end)
+        {
+            slot = (slot + 1) & slot_mask;
+        }
+        cells[slot] = Cell{ elem_cells[begin], begin, end };
+        begin = end;
+    }
+    finalized = true;
+}
+
+} // namespace cura52
+
+#endif // UTILS_PACKED_SPARSE_POINT_GRID_H
@@ -0,0 +1,136 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_POLYGON_OFFSET_CACHE_H
+#define UTILS_POLYGON_OFFSET_CACHE_H
+
+#include <atomic>
+#include <cstddef> //For size_t.
+#include <memory> //For shared_ptr.
+#include <mutex>
+#include <vector>
+
+#include "polygon.h"
+
+namespace cura52
+{
+
+/*!
+ * Remembers the last few offsets of one polygon, so that stages which offset
+ * the same outline by the same distance don't each run Clipper for it.
+ *
+ * Entries are keyed by distance, join type and miter limit. The cache keeps a
+ * hash of the points of the polygons it was filled for, computed once per
+ * lookup; if the source hashes differently, all entries are dropped. Results
+ * are shared, not copied, and stay valid after the entry is dropped.
+ *
+ * The caches of a slice together stay within the byte budget of that slice:
+ * when it is used up, offsets are computed but not kept. Copying a cache gives
+ * an empty one, so parts can be copied and moved freely.
+ */
+class PolygonOffsetCache
+{
+public:
+    /*!
+     * The stages which use the cache, to keep statistics per stage.
+     */
+    enum class Stage
+    {
+        WALLS,
+        COMBING,
+        SUPPORT,
+        INFILL,
+        NUM_STAGES
+    };
+
+    struct Statistics
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t uncached = 0; //!< Misses which weren't kept because the byte budget was used up.
+    };
+
+    //! How many offsets one cache keeps; the least recently used one goes first.
+    static constexpr size_t max_entries = 4;
+
+    //! The budget of all caches together when the slice doesn't set one.
+    static constexpr size_t default_byte_budget = 64 * 1024 * 1024;
+
+    /*!
+     * The bytes which the caches of one slice may keep together, and the
+     * statistics of that slice. Every \ref Slice has its own, so slices which
+     * run at the same time don't share them.
+     */
+    class Budget
+    {
+    public:
+        Budget();
+        Budget(const Budget&) = delete;
+        Budget& operator=(const Budget&) = delete;
+
+        void setBytes(const size_t bytes);
+
+        Statistics getStatistics(const Stage stage) const;
+
+    private:
+        friend class PolygonOffsetCache;
+
+        /*!
+         * Take bytes from the budget, if there are that many left.
+         */
+        bool reserve(const size_t bytes);
+
+        void release(const size_t bytes);
+
+        std::atomic<size_t> byte_budget;
+        std::atomic<size_t> bytes_used;
+        std::atomic<size_t> hits[static_cast<size_t>(Stage::NUM_STAGES)];
+        std::atomic<size_t> misses[static_cast<size_t>(Stage::NUM_STAGES)];
+        std::atomic<size_t> uncached[static_cast<size_t>(Stage::NUM_STAGES)];
+    };
+
+    PolygonOffsetCache() = default;
+    PolygonOffsetCache(const PolygonOffsetCache&) noexcept;
+    PolygonOffsetCache(PolygonOffsetCache&&) noexcept;
+    PolygonOffsetCache& operator=(const PolygonOffsetCache&);
+    PolygonOffsetCache& operator=(PolygonOffsetCache&&);
+    ~PolygonOffsetCache();
+
+    /*!
+     * Get \p source offset like \ref Polygons::offset does, from the cache if it
+     * was asked for before. May be called from multiple threads.
+     *
+     * \param source The polygons this cache belongs to.
+     * \param stage Which stage asks, for the statistics.
+     * \param budget The budget of the slice the source belongs to.
+     * \return The offset, shared with the cache if it is kept there.
+     */
+    std::shared_ptr<const Polygons> offset(const Polygons& source, const coord_t distance, const ClipperLib::JoinType join_type, const double miter_limit, const Stage stage, Budget& budget) const;
+
+    static const char* getStageName(const Stage stage);
+
+private:
+    struct Entry
+    {
+        coord_t distance;
+        ClipperLib::JoinType join_type;
+        double miter_limit;
+        std::shared_ptr<const Polygons> result;
+        size_t bytes;
+    };
+
+    /*!
+     * Drop everything and give the bytes back to the budget. The lock must be
+     * held, or the cache not shared.
+     */
+    void clear() const;
+
+    mutable std::mutex mutex;
+    mutable size_t source_hash = 0; //!< Hash of the source the entries were computed for.
+    mutable Budget* entries_budget = nullptr; //!< The budget the bytes of the entries were taken from.
+    mutable std::vector<Entry> entries; //!< Least recently used first.
+};
+
+} // namespace cura52
+
+#endif // UTILS_POLYGON_OFFSET_CACHE_H
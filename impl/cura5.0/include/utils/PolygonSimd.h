@@ -0,0 +1,53 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_POLYGON_SIMD_H
+#define UTILS_POLYGON_SIMD_H
+
+#include <cstddef> //For size_t.
+#include <cstdint>
+
+#include "IntPoint.h"
+
+namespace cura52
+{
+
+/*!
+ * Loops over the vertices of a polygon which handle four vertices at a time
+ * with AVX2 when the processor has it, and one at a time otherwise.
+ *
+ * Both give exactly the same results. Only integer comparisons and products
+ * are done in vector registers. Whatever needs floating point or has to be
+ * decided in order (a point on the border, a product that doesn't fit in 32
+ * bits) is handled one vertex at a time, the way the scalar loop does it.
+ */
+class PolygonSimd
+{
+public:
+    /*!
+     * Whether the AVX2 loops are used. Checked once per process.
+     */
+    static bool hasAvx2();
+
+    /*!
+     * Grow \p min and \p max to include all vertices of \p path.
+     */
+    static void includeBounds(const ClipperLib::Path& path, Point& min, Point& max);
+
+    /*!
+     * The same as ClipperLib::PointInPolygon.
+     * \return 0 if \p point is outside \p path, 1 if it is inside and -1 if it is on the border.
+     */
+    static int pointInPolygon(const Point& point, const ClipperLib::Path& path);
+
+    /*!
+     * Find the vertex of \p path closest to \p from, the first one if several are as close.
+     * \param best_dist2[in,out] The squared distance to beat. Lowered to that of the vertex which is found.
+     * \return The index of the closest vertex, or the size of \p path if no vertex is closer than \p best_dist2.
+     */
+    static size_t findNearestVert(const Point& from, const ClipperLib::Path& path, int64_t& best_dist2);
+};
+
+} // namespace cura52
+
+#endif // UTILS_POLYGON_SIMD_H
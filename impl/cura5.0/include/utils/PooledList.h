@@ -0,0 +1,293 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_POOLED_LIST_H
+#define UTILS_POOLED_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cura52
+{
+
+/*!
+ * A doubly linked list which allocates its nodes from chunks of memory.
+ *
+ * This behaves like the subset of std::list which the half-edge graphs use:
+ * elements never move, so pointers to them stay valid until they are erased,
+ * and iteration follows the order of insertion at the front and back. Rather
+ * than allocating every node separately, nodes are carved from chunks of
+ * \ref chunk_size nodes and erased nodes are reused.
+ *
+ * When a list is destroyed its chunks are kept in a cache of the current
+ * thread, so building the next graph on the same thread doesn't have to
+ * allocate again.
+ */
+template<typename T>
+class PooledList
+{
+    struct Node
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; //!< The element. Must be the first member, so that an element can be converted back to its node.
+        Node* prev;
+        Node* next;
+
+        T& value()
+        {
+            return *std::launder(reinterpret_cast<T*>(&storage));
+        }
+    };
+
+    static constexpr size_t chunk_size = 256; //!< Nodes per chunk.
+    static constexpr size_t max_cached_chunks = 1024; //!< How many unused chunks each thread keeps for later lists.
+
+    using Chunk = std::unique_ptr<Node[]>;
+
+public:
+    template<typename Value, typename NodePtr>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator(NodePtr node = nullptr)
+        : node(node)
+        {
+        }
+
+        template<typename OtherValue, typename OtherNodePtr>
+        Iterator(const Iterator<OtherValue, OtherNodePtr>& other)
+        : node(other.node)
+        {
+        }
+
+        reference operator*() const
+        {
+            return const_cast<Node*>(node)->value();
+        }
+        pointer operator->() const
+        {
+            return &**this;
+        }
+        Iterator& operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator ret = *this;
+            node = node->next;
+            return ret;
+        }
+        Iterator& operator--()
+        {
+            node = node->prev;
+            return *this;
+        }
+        Iterator operator--(int)
+        {
+            Iterator ret = *this;
+            node = node->prev;
+            return ret;
+        }
+        template<typename OtherValue, typename OtherNodePtr>
+        bool operator==(const Iterator<OtherValue, OtherNodePtr>& other) const
+        {
+            return node == other.node;
+        }
+        template<typename OtherValue, typename OtherNodePtr>
+        bool operator!=(const Iterator<OtherValue, OtherNodePtr>& other) const
+        {
+            return node != other.node;
+        }
+
+    private:
+        friend class PooledList;
+        template<typename, typename>
+        friend class Iterator;
+        NodePtr node;
+    };
+
+    using value_type = T;
+    using iterator = Iterator<T, Node*>;
+    using const_iterator = Iterator<const T, const Node*>;
+
+    PooledList()
+    {
+        sentinel.prev = &sentinel;
+        sentinel.next = &sentinel;
+    }
+
+    PooledList(const PooledList&) = delete;
+    PooledList& operator=(const PooledList&) = delete;
+
+    ~PooledList()
+    {
+        clear();
+        std::vector<Chunk>& cache = cachedChunks();
+        for (Chunk& chunk : chunks)
+        {
+            if (cache.size() >= max_cached_chunks)
+            {
+                break;
+            }
+            cache.emplace_back(std::move(chunk));
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator(sentinel.next);
+    }
+    iterator end()
+    {
+        return iterator(&sentinel);
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(sentinel.next);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(&sentinel);
+    }
+
+    size_t size() const
+    {
+        return element_count;
+    }
+    bool empty() const
+    {
+        return element_count == 0;
+    }
+
+    T& front()
+    {
+        assert(! empty());
+        return sentinel.next->value();
+    }
+    T& back()
+    {
+        assert(! empty());
+        return sentinel.prev->value();
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    /*!
+     * Construct an element before \p position.
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        Node* node = allocateNode();
+        new (&node->storage) T(std::forward<Args>(args)...);
+        Node* next = const_cast<Node*>(position.node);
+        node->next = next;
+        node->prev = next->prev;
+        next->prev->next = node;
+        next->prev = node;
+        element_count++;
+        return iterator(node);
+    }
+
+    /*!
+     * Remove an element.
+     * \return The element after the removed one.
+     */
+    iterator erase(const_iterator position)
+    {
+        Node* node = const_cast<Node*>(position.node);
+        assert(node != &sentinel);
+        Node* next = node->next;
+        node->prev->next = next;
+        next->prev = node->prev;
+        node->value().~T();
+        node->next = free_nodes;
+        free_nodes = node;
+        element_count--;
+        return iterator(next);
+    }
+
+    /*!
+     * Get the iterator pointing to an element of this list, in constant time.
+     */
+    iterator iteratorTo(T* element)
+    {
+        return iterator(reinterpret_cast<Node*>(element));
+    }
+
+    /*!
+     * Remove all elements. The memory is kept for new elements.
+     */
+    void clear()
+    {
+        for (iterator it = begin(); it != end();)
+        {
+            it = erase(it);
+        }
+    }
+
+private:
+    Node* allocateNode()
+    {
+        if (! free_nodes)
+        {
+            std::vector<Chunk>& cache = cachedChunks();
+            if (! cache.empty())
+            {
+                chunks.emplace_back(std::move(cache.back()));
+                cache.pop_back();
+            }
+            else
+            {
+                chunks.emplace_back(new Node[chunk_size]);
+            }
+            Node* chunk = chunks.back().get();
+            for (size_t node_idx = chunk_size; node_idx > 0; node_idx--)
+            {
+                chunk[node_idx - 1].next = free_nodes;
+                free_nodes = &chunk[node_idx - 1];
+            }
+        }
+        Node* node = free_nodes;
+        free_nodes = node->next;
+        return node;
+    }
+
+    static std::vector<Chunk>& cachedChunks()
+    {
+        static thread_local std::vector<Chunk> cache;
+        return cache;
+    }
+
+    Node sentinel; //!< Before the first and after the last element. Has no value.
+    Node* free_nodes = nullptr; //!< Singly linked through Node::next.
+    std::vector<Chunk> chunks;
+    size_t element_count = 0;
+};
+
+} // namespace cura52
+
+#endif // UTILS_POOLED_LIST_H
@@ -0,0 +1,111 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_RESOURCE_GOVERNOR_H
+#define UTILS_RESOURCE_GOVERNOR_H
+
+#include <cstddef> //For size_t.
+#include <thread>
+#include <vector>
+
+namespace cura52
+{
+
+class Settings;
+
+/*!
+ * What the machine and the container the engine runs in allow it to use.
+ */
+struct ResourceLimits
+{
+    size_t hardware_threads = 1; //!< The CPUs this process may run on.
+    double cpu_quota = 0; //!< CPUs worth of time the cgroup allows, or 0 if it doesn't limit it.
+    size_t memory_limit = 0; //!< Bytes the cgroup allows, or 0 if it doesn't limit it.
+    std::vector<int> cpus; //!< The CPUs this process may run on, if known. Used for pinning.
+
+    /*!
+     * Read the limits of this process: its CPU affinity, and the CPU quota and
+     * memory limit of its cgroup (v2, or v1 if that is what is mounted). The
+     * tightest limit of the cgroup and its parents counts. Outside of Linux only
+     * the number of hardware threads is known.
+     */
+    static ResourceLimits detect();
+};
+
+/*!
+ * Decides how many threads and how much memory a slice may use.
+ *
+ * The limits of the container are detected once. The caller of the engine can
+ * make them tighter per job, through the settings or directly; the tightest
+ * limit wins. Stages which keep a lot in memory ask for \ref memoryBudget and
+ * trade memory for time when it is set.
+ */
+class ResourceGovernor
+{
+public:
+    ResourceGovernor();
+
+    /*!
+     * Tighten the limits with the settings of a slice:
+     * - engine_max_threads: Threads including the main thread, 0 for no cap.
+     * - engine_memory_limit: MB, 0 for no cap.
+     * - engine_pin_threads: Whether to pin the workers to CPUs.
+     * Settings which don't exist are ignored.
+     */
+    void applySettings(const Settings& settings);
+
+    /*!
+     * Cap the number of threads, including the main thread. Caps only get
+     * tighter: 0 or a larger cap than before changes nothing.
+     */
+    void setThreadCap(const size_t threads);
+
+    /*!
+     * Cap the memory in bytes. Like the thread cap, it only gets tighter.
+     */
+    void setMemoryCap(const size_t bytes);
+
+    void setPinThreads(const bool pin);
+
+    /*!
+     * How many threads to slice with, including the main thread. The CPU quota is
+     * rounded up, since a thread which waits for its share of the quota costs
+     * less than an idle CPU. At least one.
+     */
+    size_t threadCount() const;
+
+    /*!
+     * How much memory the slice should stay within, in bytes, or 0 if there is
+     * no limit.
+     */
+    size_t memoryBudget() const;
+
+    /*!
+     * Whether the memory was capped for the job, through the settings or
+     * directly, rather than only by the container. Stages which go to disk
+     * to stay within the budget only do so when the job asked for a cap.
+     */
+    bool hasMemoryCap() const;
+
+    bool pinThreads() const;
+
+    /*!
+     * Pin a worker thread to a CPU. Worker i goes to the (i + 1)th CPU this
+     * process may run on, wrapping around, so that the first CPU is left to the
+     * thread which called the engine. Does nothing unless pinning is on and the
+     * CPUs are known.
+     */
+    void pin(std::thread& thread, const size_t worker_idx) const;
+
+    const ResourceLimits& detected() const;
+
+private:
+    ResourceLimits limits;
+    size_t thread_cap = 0;
+    size_t memory_cap = 0;
+    bool pin_threads = false;
+};
+
+} // namespace cura52
+
+#endif // UTILS_RESOURCE_GOVERNOR_H
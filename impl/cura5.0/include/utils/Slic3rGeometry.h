@@ -0,0 +1,81 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_SLIC3R_GEOMETRY_H
+#define UTILS_SLIC3R_GEOMETRY_H
+
+#include "Slice3rBase/ClipperUtils.hpp"
+
+#include "polygon.h"
+
+namespace cura52
+{
+
+/*!
+ * Conversions between our polygons (polyclipping) and the Slic3r geometry
+ * types (Clipper3r), which use different point classes and can't share their
+ * containers.
+ *
+ * The conversions read the source through const references, size the result
+ * once for all points and append into a caller-provided buffer where that
+ * allows the buffer to be reused between calls.
+ */
+class Slic3rGeometry
+{
+public:
+    /*!
+     * Append a sequence of our points to Slic3r points.
+     * \param points Any contiguous sequence of \ref Point, e.g. a
+     * ClipperLib::Path or the points of a GCodePath.
+     * \param scale The factor to multiply the coordinates with.
+     * \param[out] result The points to append to.
+     */
+    template<typename PointRange>
+    static void appendPoints(const PointRange& points, const coord_t scale, Slic3r::Points& result)
+    {
+        result.reserve(result.size() + points.size());
+        for (const Point& p : points)
+        {
+            result.emplace_back(static_cast<Slic3r::coord_t>(p.X * scale), static_cast<Slic3r::coord_t>(p.Y * scale));
+        }
+    }
+
+    /*!
+     * Get the points of all polygons concatenated, as Slic3r points.
+     * \param polygons The polygons to convert.
+     * \param scale The factor to multiply the coordinates with.
+     */
+    static Slic3r::Points toPoints(const Polygons& polygons, const coord_t scale)
+    {
+        Slic3r::Points result;
+        result.reserve(polygons.pointCount());
+        for (const ClipperLib::Path& path : polygons)
+        {
+            appendPoints(path, scale, result);
+        }
+        return result;
+    }
+
+    /*!
+     * Convert Slic3r polygons to Clipper3r paths, without rescaling.
+     */
+    static Slic3r::Clipper3r::Paths toClipperPaths(const Slic3r::Polygons& polygons)
+    {
+        Slic3r::Clipper3r::Paths result;
+        result.reserve(polygons.size());
+        for (const Slic3r::Polygon& polygon : polygons)
+        {
+            Slic3r::Clipper3r::Path& path = result.emplace_back();
+            path.reserve(polygon.size());
+            for (size_t point_idx = 0; point_idx < polygon.size(); point_idx++)
+            {
+                path.emplace_back(polygon[point_idx].x(), polygon[point_idx].y());
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace cura52
+
+#endif // UTILS_SLIC3R_GEOMETRY_H
@@ -107,10 +107,11 @@ public:
      * \param[in] radius The search radius.
      * \param[in] process_func Processes each element.  process_func(elem) is
      *    called for each element in the cell. Processing stops if function returns false.
+     *    Any callable works; it is called directly rather than through a std::function.
      * \return Whether we need to continue processing after this function
      */
-    bool processNearby(const Point &query_pt, coord_t radius,
-                       const std::function<bool (const ElemT&)>& process_func) const;
+    template<typename ProcessFunc>
+    bool processNearby(const Point &query_pt, coord_t radius, const ProcessFunc& process_func) const;
 
     /*! \brief Process elements from cells that might contain sought after points along a line.
      *
@@ -122,8 +123,8 @@ public:
      *    called for each element in the cells. Processing stops if function returns false.
      * \return Whether we need to continue processing after this function
      */
-    bool processLine(const std::pair<Point, Point> query_line,
-                       const std::function<bool (const Elem&)>& process_elem_func) const;
+    template<typename ProcessFunc>
+    bool processLine(const std::pair<Point, Point> query_line, const ProcessFunc& process_elem_func) const;
 
 protected:
     /*! \brief Process elements from the cell indicated by \p grid_pt.
@@ -133,8 +134,8 @@ protected:
      *    called for each element in the cell. Processing stops if function returns false.
      * \return Whether we need to continue processing a next cell.
      */
-    bool processFromCell(const GridPoint &grid_pt,
-                         const std::function<bool (const Elem&)>& process_func) const;
+    template<typename ProcessFunc>
+    bool processFromCell(const GridPoint &grid_pt, const ProcessFunc& process_func) const;
 
     /*! \brief Map from grid locations (GridPoint) to elements (Elem). */
     GridMap m_grid;
@@ -157,9 +158,8 @@ SGI_THIS::SparseGrid(coord_t cell_size, size_t elem_reserve, float max_load_fact
 }
 
 SGI_TEMPLATE
-bool SGI_THIS::processFromCell(
-    const GridPoint &grid_pt,
-    const std::function<bool (const Elem&)>& process_func) const
+template<typename ProcessFunc>
+bool SGI_THIS::processFromCell(const GridPoint &grid_pt, const ProcessFunc& process_func) const
 {
     auto grid_range = m_grid.equal_range(grid_pt);
     for (auto iter = grid_range.first; iter != grid_range.second; ++iter)
@@ -173,19 +173,19 @@ bool SGI_THIS::processFromCell(
 }
 
 SGI_TEMPLATE
-bool SGI_THIS::processNearby(const Point &query_pt, coord_t radius,
-                             const std::function<bool (const Elem&)>& process_func) const
+template<typename ProcessFunc>
+bool SGI_THIS::processNearby(const Point &query_pt, coord_t radius, const ProcessFunc& process_func) const
 {
-    return SquareGrid::processNearby(query_pt, radius,
-                                     [&process_func, this](const GridPoint& grid_pt)
-                                     {
-                                         return processFromCell(grid_pt, process_func);
-                                     });
+    return SquareGrid::processNearbyCells(query_pt, radius,
+                                          [&process_func, this](const GridPoint& grid_pt)
+                                          {
+                                              return processFromCell(grid_pt, process_func);
+                                          });
 }
 
 SGI_TEMPLATE
-bool SGI_THIS::processLine(const std::pair<Point, Point> query_line,
-                            const std::function<bool (const Elem&)>& process_elem_func) const
+template<typename ProcessFunc>
+bool SGI_THIS::processLine(const std::pair<Point, Point> query_line, const ProcessFunc& process_elem_func) const
 {
     const std::function<bool (const GridPoint&)> process_cell_func = [&process_elem_func, this](GridPoint grid_loc)
         {
@@ -199,7 +199,7 @@ std::vector<typename SGI_THIS::Elem>
 SGI_THIS::getNearby(const Point &query_pt, coord_t radius) const
 {
     std::vector<Elem> ret;
-    const std::function<bool (const Elem&)> process_func = [&ret](const Elem &elem)
+    const auto process_func = [&ret](const Elem &elem)
         {
             ret.push_back(elem);
             return true;
@@ -223,7 +223,7 @@ bool SGI_THIS::getNearest(
 {
     bool found = false;
     int64_t best_dist2 = static_cast<int64_t>(radius) * radius;
-    const std::function<bool (const Elem&)> process_func =
+    const auto process_func =
         [&query_pt, &elem_nearest, &found, &best_dist2, &precondition](const Elem &elem)
         {
             if (!precondition(elem))
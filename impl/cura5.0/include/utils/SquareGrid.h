@@ -107,6 +107,31 @@ public:
     bool processNearby(const Point &query_pt, coord_t radius,
                        const std::function<bool (const GridPoint&)>& process_func) const;
 
+    /*! \brief Process cells that might contain sought after points.
+     *
+     * Same as \ref processNearby, but calls the function directly rather than
+     * through a std::function, which matters when the function is called for
+     * many cells.
+     */
+    template<typename ProcessFunc>
+    bool processNearbyCells(const Point &query_pt, coord_t radius, const ProcessFunc& process_func) const
+    {
+        const GridPoint min_grid = toGridPoint(Point(query_pt.X - radius, query_pt.Y - radius));
+        const GridPoint max_grid = toGridPoint(Point(query_pt.X + radius, query_pt.Y + radius));
+
+        for (coord_t grid_y = min_grid.Y; grid_y <= max_grid.Y; ++grid_y)
+        {
+            for (coord_t grid_x = min_grid.X; grid_x <= max_grid.X; ++grid_x)
+            {
+                if (!process_func(GridPoint(grid_x, grid_y)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     /*! \brief Compute the grid coordinates of a point.
      * \param point The actual location.
      * \return The grid coordinates that correspond to \p point.
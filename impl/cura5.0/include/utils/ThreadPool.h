@@ -7,6 +7,7 @@
 #include "../Application.h" // accessing singleton's Application::thread_pool
 #include "../utils/math.h" // round_up_divide
 
+#include <algorithm> // stable_sort
 #include <cassert>
 #include <condition_variable>
 #include <deque>
@@ -25,14 +26,16 @@ namespace cura52
  * ThreadPool can be described as a synchronized FIFO queue shared by a fleet of `std::thread`s.
  * Tasks have the responsibility of unlocking the queue's lock passed as an argument while they do asynchronous work.
  */
+class ResourceGovernor;
+
 class ThreadPool
 {
   public:
     using lock_t = std::unique_lock<std::mutex>;
     using task_t = std::function<void(lock_t&)>;
 
-    //! Spawns a thread pool with `nthreads` threads
-    ThreadPool(size_t nthreads);
+    //! Spawns a thread pool with `nthreads` threads, pinned to CPUs if the `governor` says so
+    ThreadPool(size_t nthreads, const ResourceGovernor* governor = nullptr);
 
     ~ThreadPool() { join(); }
 
@@ -202,6 +205,106 @@ auto parallel_for(Application* application, Container& container, F&& loop_body,
 }
 
 
+/*!
+ * \brief parallel_for for loops of which the cost of each item is known in advance.
+ *
+ * The range is cut into contiguous chunks of about equal estimated cost rather than of equal size, so an expensive
+ * item gets a chunk of its own and cheap items are batched. The chunks are queued most expensive first, so that
+ * the longest running ones don't start last and hold up the end of the loop.
+ *
+ * \param from, to: The [inclusive, exclusive) range of iteration. Integers or random access iterators
+ * \param costs The estimated cost of each item in the range, in any unit. Must have one entry per item.
+ * \param body The loop-body, as a closure. Receives the index on invocation.
+ * \param chunks_per_worker Aim for this many chunks per worker.
+ */
+template<typename T, typename F>
+void parallel_for_weighted(Application* application, T first, T last, const std::vector<double>& costs, F&& loop_body, const size_t chunks_per_worker=8)
+{
+    using lock_t = ThreadPool::lock_t;
+
+    const auto dist = distance(first, last);
+    if (dist <= 0)
+    {
+        return;
+    }
+    const size_t nitems = dist;
+    assert(costs.size() == nitems);
+
+    ThreadPool* const thread_pool = application->thread_pool;
+    assert(thread_pool);
+    const size_t nworkers = thread_pool->thread_count() + 1; // One task per std::thread + 1 for main thread
+
+    double total_cost = 0;
+    for (const double cost : costs)
+    {
+        total_cost += std::max(cost, 0.0);
+    }
+    if (! (total_cost > 0)) // Nothing to go by.
+    {
+        parallel_for(application, first, last, std::forward<F>(loop_body), 1, chunks_per_worker);
+        return;
+    }
+
+    struct Chunk
+    {
+        size_t first;
+        size_t last;
+        double cost;
+    };
+    std::vector<Chunk> chunks;
+    const double chunk_cost_target = total_cost / (chunks_per_worker * nworkers);
+    Chunk chunk{ 0, 0, 0.0 };
+    for (size_t item = 0; item < nitems; item++)
+    {
+        const double cost = std::max(costs[item], 0.0);
+        if (item > chunk.first && chunk.cost + cost > chunk_cost_target)
+        {
+            chunk.last = item;
+            chunks.push_back(chunk);
+            chunk = Chunk{ item, item, 0.0 };
+        }
+        chunk.cost += cost;
+    }
+    chunk.last = nitems;
+    chunks.push_back(chunk);
+    std::stable_sort(chunks.begin(), chunks.end(), [](const Chunk& a, const Chunk& b) { return a.cost > b.cost; });
+
+    struct
+    {
+        std::decay_t<F> loop_body; // User's closure data
+        size_t chunks_remaining;
+        std::condition_variable work_done = {};
+    } shared_state = { std::forward<F>(loop_body), chunks.size() };
+
+    lock_t lock = thread_pool->get_lock();
+    for (const Chunk& queued : chunks)
+    {
+        const T chunk_first = first + static_cast<decltype(dist)>(queued.first);
+        const T chunk_last = first + static_cast<decltype(dist)>(queued.last);
+        thread_pool->push(lock, [&application, &shared_state, chunk_first, chunk_last](lock_t& th_lock)
+            {
+                th_lock.unlock(); // Enter unsynchronized region
+                for (T i = chunk_first ; i < chunk_last ; ++i)
+                {
+                    INTERRUPT_BREAK("parallel_for_weighted ");
+                    shared_state.loop_body(i);
+                }
+                th_lock.lock();
+                if (--shared_state.chunks_remaining == 0)
+                {
+                    shared_state.work_done.notify_one();
+                }
+            });
+    }
+
+    thread_pool->work_while(lock, [&]{ return shared_state.chunks_remaining > 0; });
+    while(shared_state.chunks_remaining > 0) // Wait until all the task are completed
+    {
+        shared_state.work_done.wait(lock);
+    }
+}
+
+
 //! \private Internal state for run_multiple_producers_ordered_consumer()
 template<typename Producer, typename Consumer> class MultipleProducersOrderedConsumer;
 
@@ -233,6 +336,28 @@ void run_multiple_producers_ordered_consumer(Application* application, ptrdiff_t
     MultipleProducersOrderedConsumer<P, C>(first, last, std::forward<P>(producer), std::forward<C>(consumer), max_pending).run(*thread_pool);
 }
 
+/*!
+ * \brief Like run_multiple_producers_ordered_consumer(), but with the estimated cost of producing each item.
+ *
+ * Producers still only work on items within max_pending of the next item to consume, but within that window they
+ * take the most expensive item that hasn't been started yet instead of the first one. Expensive items then start as
+ * soon as they enter the window, and are more likely to be done by the time the consumer gets to them.
+ *
+ * \param costs The estimated cost of producing each item in [first, last), in any unit.
+ */
+template<typename P, typename C>
+void run_multiple_producers_ordered_consumer(Application* application, ptrdiff_t first, ptrdiff_t last, P&& producer, C&& consumer, const std::vector<double>& costs, size_t max_pending_per_worker=8)
+{
+    ThreadPool* thread_pool = application->thread_pool;
+    assert(thread_pool);
+    assert(max_pending_per_worker > 0);
+    assert(costs.empty() || costs.size() == static_cast<size_t>(std::max(ptrdiff_t(0), last - first)));
+    const size_t max_pending = max_pending_per_worker * (thread_pool->thread_count() + 1);
+    MultipleProducersOrderedConsumer<P, C> state(first, last, std::forward<P>(producer), std::forward<C>(consumer), max_pending);
+    state.setCosts(costs);
+    state.run(*thread_pool);
+}
+
 template<typename Producer, typename Consumer>
 class MultipleProducersOrderedConsumer
 {
@@ -249,9 +374,16 @@ class MultipleProducersOrderedConsumer
       : producer(std::forward<P>(producer)), consumer(std::forward<C>(consumer)),
         max_pending(max_pending),
         queue(std::make_unique<item_t[]>(max_pending)),
-        last_idx(last), write_idx(first), read_idx(first), consumer_wait_idx(first)
+        started(std::make_unique<bool[]>(max_pending)),
+        first_idx(first), last_idx(last), write_idx(first), read_idx(first), consumer_wait_idx(first)
     {}
 
+    //! Estimated cost of producing each item, to produce the expensive items in the window first. Empty to produce in order.
+    void setCosts(const std::vector<double>& costs_)
+    {
+        costs = costs_;
+    }
+
     //! Schedules the tasks on thread_pool, then run one on the main thread until completion.
     void run(ThreadPool& thread_pool)
     {
@@ -286,7 +418,7 @@ class MultipleProducersOrderedConsumer
                 return false;
             }
             if (write_idx - read_idx < max_pending)
-            {   // Continue as a producer
+            {   // Continue as a producer (write_idx is not started yet, so there is an item to produce in the window)
                 return true;
             }
             else
@@ -299,7 +431,7 @@ class MultipleProducersOrderedConsumer
     //! Produces an item and store in in the ring buffer. Assumes that there is items to produce and free space in the ring
     ptrdiff_t produce(lock_t& lock)
     {
-        ptrdiff_t produced_idx = write_idx++;
+        ptrdiff_t produced_idx = pick();
         item_t* slot = &queue[(produced_idx + max_pending) % max_pending];
         assert(produced_idx < last_idx);
 
@@ -315,6 +447,32 @@ class MultipleProducersOrderedConsumer
         return produced_idx;
     }
 
+    /*!
+     * Chooses the item to produce next and marks it as started: write_idx, or with costs the most expensive item in
+     * the window which isn't started yet. Assumes that write_idx is in the window.
+     */
+    ptrdiff_t pick()
+    {
+        const ptrdiff_t window_end = std::min(last_idx, read_idx + max_pending);
+        ptrdiff_t picked_idx = write_idx;
+        if (! costs.empty())
+        {
+            for (ptrdiff_t idx = write_idx + 1; idx < window_end; idx++)
+            {
+                if (! started[(idx + max_pending) % max_pending] && costs[idx - first_idx] > costs[picked_idx - first_idx])
+                {
+                    picked_idx = idx;
+                }
+            }
+        }
+        started[(picked_idx + max_pending) % max_pending] = true;
+        while (write_idx < window_end && started[(write_idx + max_pending) % max_pending])
+        {
+            write_idx++;
+        }
+        return picked_idx;
+    }
+
     //! Consumes items, until an empty slot (not yet produced) is found.
     void consume_many(lock_t& lock)
     {
@@ -326,6 +484,7 @@ class MultipleProducersOrderedConsumer
             consumer(std::move(*slot));
             *slot = {};
             lock.lock();
+            started[(read_idx + max_pending) % max_pending] = false; // The slot now belongs to item read_idx + max_pending.
 
             // Increment read index and signal a waiting worker if there is one
             bool queue_was_full = write_idx - read_idx >= max_pending;
@@ -369,9 +528,12 @@ class MultipleProducersOrderedConsumer
     Consumer consumer;
     const ptrdiff_t max_pending; // Number of produced items that can wait in the queue
     const std::unique_ptr<item_t[]> queue; // Ring buffer mapping each intermediary result to a slot
+    const std::unique_ptr<bool[]> started; // For each slot of the ring whether its item is being or has been produced
+    const ptrdiff_t first_idx;
     const ptrdiff_t last_idx;
+    std::vector<double> costs; // Estimated cost of each item, from first_idx. Empty to produce in order
 
-    ptrdiff_t write_idx; // Next slot to produce
+    ptrdiff_t write_idx; // First item which isn't started
     ptrdiff_t read_idx; // Next slot to consume
     ptrdiff_t consumer_wait_idx; // First slot that is waited for by the consumer
     std::condition_variable free_slot_cond; // Condition to wait for available space in the buffer
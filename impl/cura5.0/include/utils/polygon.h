@@ -21,7 +21,9 @@
 
 #include "../settings/types/Angle.h" //For angles between vertices.
 #include "../settings/types/Ratio.h"
+#include "ClipperPool.h"
 #include "IntPoint.h"
+#include "PolygonSimd.h"
 
 #define CHECK_POLY_ACCESS
 #ifdef CHECK_POLY_ACCESS
@@ -284,14 +286,14 @@ public:
     bool _inside(Point p, bool border_result = false) const;
 
     /*!
-     * Clipper function.
+     * Clipper function, with AVX2 where available (see \ref PolygonSimd).
      * Returns false if outside, true if inside; if the point lies exactly on the border, will return 'border_result'.
      *
      * http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Functions/PointInPolygon.htm
      */
     bool inside(Point p, bool border_result = false) const
     {
-        int res = ClipperLib::PointInPolygon(p, *path);
+        int res = PolygonSimd::pointInPolygon(p, *path);
         if (res == -1)
         {
             return border_result;
@@ -931,19 +933,19 @@ public:
     Polygons difference(const Polygons& other) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctDifference, ret.paths);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctDifference, ret.paths);
         return ret;
     }
     Polygons unionPolygons(const Polygons& other, ClipperLib::PolyFillType fill_type = ClipperLib::pftNonZero) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctUnion, ret.paths, fill_type, fill_type);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctUnion, ret.paths, fill_type, fill_type);
         return ret;
     }
     /*!
@@ -956,10 +958,10 @@ public:
     Polygons intersection(const Polygons& other) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctIntersection, ret.paths);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctIntersection, ret.paths);
         return ret;
     }
 
@@ -992,19 +994,19 @@ public:
     Polygons xorPolygons(const Polygons& other, ClipperLib::PolyFillType pft = ClipperLib::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctXor, ret.paths, pft);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctXor, ret.paths, pft);
         return ret;
     }
 
     Polygons execute (ClipperLib::PolyFillType pft = ClipperLib::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctXor, ret.paths, pft);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctXor, ret.paths, pft);
         return ret;
     }
 
@@ -1015,10 +1017,10 @@ public:
         Polygons ret;
         double miterLimit = 1.2;
         ClipperLib::EndType end_type = (joinType == ClipperLib::jtMiter)? ClipperLib::etOpenSquare : ClipperLib::etOpenRound;
-        ClipperLib::ClipperOffset clipper(miterLimit, 10.0);
-        clipper.AddPaths(paths, joinType, end_type);
-        clipper.MiterLimit = miterLimit;
-        clipper.Execute(ret.paths, distance);
+        PooledClipperOffset clipper(miterLimit, 10.0);
+        clipper->AddPaths(paths, joinType, end_type);
+        clipper->MiterLimit = miterLimit;
+        clipper->Execute(ret.paths, distance);
         return ret;
     }
 
@@ -1314,9 +1316,9 @@ public:
     Polygons processEvenOdd(ClipperLib::PolyFillType poly_fill_type = ClipperLib::PolyFillType::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctUnion, ret.paths, poly_fill_type);
+        PooledClipper clipper(clipper_init);
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctUnion, ret.paths, poly_fill_type);
         return ret;
     }
 
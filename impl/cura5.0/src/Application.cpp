@@ -16,6 +16,8 @@
 #include "Slice.h"
 #include "FffProcessor.h"
 #include "progress/Progress.h"
+#include "utils/ClipperPool.h"
+#include "utils/PolygonOffsetCache.h"
 #include "utils/ThreadPool.h"
 #include "utils/string.h" //For stringcasecompare.
 
@@ -52,22 +54,47 @@ namespace cura52
             tracer->progress(r);
     }
 
-    bool Application::checkInterrupt(const std::string& message)
+    void Application::notifyProgress(const Progress::Stage stage, const float stage_progress, const float overall_progress)
     {
-        if (m_error)
+        if (listener)
+        {
+            std::lock_guard<std::mutex> lock(listener_mutex);
+            listener->onProgress(stage, stage_progress, overall_progress);
+        }
+    }
+
+    void Application::notifyGCodeChunk(const GCodeChunk& chunk)
+    {
+        if (listener)
+        {
+            std::lock_guard<std::mutex> lock(listener_mutex);
+            listener->onGCodeChunk(chunk);
+        }
+    }
+
+    bool Application::checkInterrupt(const char* message)
+    {
+        if (m_error.load(std::memory_order_relaxed))
             return true;
 
-        if (!tracer)
+        bool rupt = cancel_flag && cancel_flag->load(std::memory_order_relaxed);
+        if (!rupt && tracer)
+            rupt = tracer->interrupt();
+        if (!rupt)
             return false;
 
-        bool rupt = tracer->interrupt();
-        if (rupt)
+        // Only the first thread to see the interrupt reports it.
+        if (!m_error.exchange(true) && tracer)
         {
-            m_error = true;
-            std::string msg = "slice interrupt for -->" + message;
+            std::string msg = std::string("slice interrupt for -->") + message;
             tracer->failed(msg.c_str());
         }
-        return rupt;
+        return true;
+    }
+
+    bool Application::interrupted() const
+    {
+        return m_error;
     }
 
     void Application::tick(const std::string& tag)
@@ -83,12 +110,14 @@ namespace cura52
 
         CALLTICK("slice 0");
         progressor.init();
-        startThreadPool(); // Start the thread pool
         if (_communication->hasSlice())
         {
             std::shared_ptr<Slice> slice(_communication->createSlice());
             if (slice)
             {
+                // The settings of the slice can cap the threads, so start the thread pool once they are known.
+                resources.applySettings(slice->scene.settings);
+                startThreadPool();
                 processor.time_keeper.restart();
 
                 current_slice = slice.get();
@@ -97,11 +126,27 @@ namespace cura52
 
                 processor.setTargetFile(current_slice->gcodeFile.c_str());
 
+                current_slice->offset_cache_budget.setBytes(resources.memoryBudget() > 0 ? resources.memoryBudget() / 16 : PolygonOffsetCache::default_byte_budget);
+                const ClipperPool::Statistics clipper_before = ClipperPool::getStatistics();
                 current_slice->finalize();
                 current_slice->compute();
                 // Finalize the processor. This adds the end g-code and reports statistics.
                 processor.finalize();
+
+                // Without the pool every lease would have constructed an engine.
+                const ClipperPool::Statistics clipper_after = ClipperPool::getStatistics();
+                LOGI("Clipper engines: { %zu } operations, { %zu } engines constructed.", clipper_after.leases - clipper_before.leases, clipper_after.constructed - clipper_before.constructed);
+                for (size_t stage = 0; stage < static_cast<size_t>(PolygonOffsetCache::Stage::NUM_STAGES); stage++)
+                {
+                    const PolygonOffsetCache::Stage offset_stage = static_cast<PolygonOffsetCache::Stage>(stage);
+                    const PolygonOffsetCache::Statistics offsets = current_slice->offset_cache_budget.getStatistics(offset_stage);
+                    LOGI("Offset cache, %s: { %zu } hits, { %zu } misses, { %zu } not kept.", PolygonOffsetCache::getStageName(offset_stage), offsets.hits, offsets.misses, offsets.uncached);
+                }
             }
+        }
+        if (!thread_pool)
+        {
+            startThreadPool();
         }
 		CALLTICK("slice 1");
     }
@@ -115,7 +160,7 @@ namespace cura52
             {
                 return; // Keep the previous ThreadPool
             }
-            nthreads = std::thread::hardware_concurrency() - 1;
+            nthreads = resources.threadCount() - 1;
         }
         else
         {
@@ -126,6 +171,14 @@ namespace cura52
             return; // Keep the previous ThreadPool
         }
         delete thread_pool;
-        thread_pool = new ThreadPool(nthreads);
+        thread_pool = new ThreadPool(nthreads, &resources);
+
+        const ResourceLimits& limits = resources.detected();
+        LOGI("Resources: { %zu } threads ({ %zu } hardware threads, cpu quota %.2f), memory budget { %zu } bytes, pinned %d.",
+             nthreads + 1, limits.hardware_threads, limits.cpu_quota, resources.memoryBudget(), (int)resources.pinThreads());
+        sliceResult.thread_count = nthreads + 1;
+        sliceResult.cpu_quota = limits.cpu_quota;
+        sliceResult.memory_budget = resources.memoryBudget();
+        sliceResult.pinned_threads = resources.pinThreads() && ! limits.cpus.empty();
     }
 } // namespace cura52
\ No newline at end of file
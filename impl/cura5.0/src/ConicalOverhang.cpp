@@ -7,6 +7,7 @@
 #include "utils/Simplify.h" //Simplifying at every step to prevent getting lots of vertices from all the insets.
 #include "slicer.h"
 #include "settings/types/Angle.h" //To process the overhang angle.
+#include "utils/ThreadPool.h"
 
 namespace cura52
 {
@@ -19,58 +20,90 @@ void ConicalOverhang::apply(Slicer* slicer, const Mesh& mesh)
     const coord_t layer_thickness = mesh.settings.get<coord_t>("layer_height");
     coord_t max_dist_from_lower_layer = tan_angle * layer_thickness; // max dist which can be bridged
 
-    for(unsigned int layer_nr = slicer->layers.size() - 2; static_cast<int>(layer_nr) >= 0; layer_nr--)
+    std::vector<SlicerLayer>& layers = slicer->layers;
+    if (layers.size() < 2)
     {
-        SlicerLayer& layer = slicer->layers[layer_nr];
-        SlicerLayer& layer_above = slicer->layers[layer_nr + 1];
-        if (std::abs(max_dist_from_lower_layer) < 5)
-        { // magically nothing happens when max_dist_from_lower_layer == 0
-            // below magic code solves that
-            constexpr coord_t safe_dist = 20;
-            Polygons diff = layer_above.polygons.difference(layer.polygons.offset(-safe_dist));
+        return;
+    }
+    const size_t processed_layer_count = layers.size() - 1; // The top layer stays as it is.
+
+    // Each layer is grown by the layer above it after that one was grown, so the layers have to be processed from the top down.
+    // What only depends on the layer itself is computed for all layers in parallel first, leaving the growing for the serial loop.
+    if (std::abs(max_dist_from_lower_layer) < 5)
+    { // magically nothing happens when max_dist_from_lower_layer == 0
+        // below magic code solves that
+        constexpr coord_t safe_dist = 20;
+        std::vector<Polygons> insets(processed_layer_count);
+        cura52::parallel_for<size_t>(slicer->application, 0, processed_layer_count,
+            [&](size_t layer_nr)
+            {
+                insets[layer_nr] = layers[layer_nr].polygons.offset(-safe_dist);
+            });
+
+        for (int layer_nr = processed_layer_count - 1; layer_nr >= 0; layer_nr--)
+        {
+            SlicerLayer& layer = layers[layer_nr];
+            SlicerLayer& layer_above = layers[layer_nr + 1];
+            Polygons diff = layer_above.polygons.difference(insets[layer_nr]);
+            insets[layer_nr].clear();
             layer.polygons = layer.polygons.unionPolygons(diff);
             layer.polygons = layer.polygons.smooth(safe_dist);
-                            layer.polygons = Simplify(safe_dist, safe_dist / 2, 0).polygon(layer.polygons);
+            layer.polygons = Simplify(safe_dist, safe_dist / 2, 0).polygon(layer.polygons);
             // somehow layer.polygons get really jagged lines with a lot of vertices
             // without the above steps slicing goes really slow
         }
-        else
-        {
-            // Get the current layer and split it into parts
-            std::vector<PolygonsPart> layerParts = layer.polygons.splitIntoParts();
-            // Get a copy of the layer above to prune away before we shrink it
-            Polygons above = layer_above.polygons;
+        return;
+    }
 
-            // Now go through all the holes in the current layer and check if they intersect anything in the layer above
-            // If not, then they're the top of a hole and should be cut from the layer above before the union
-            for(unsigned int part = 0; part < layerParts.size(); part++)
+    // The holes of each layer which are small enough to be closed, if the layer above covers them.
+    std::vector<std::vector<Polygons>> small_holes(processed_layer_count);
+    if (maxHoleArea > 0.0)
+    {
+        cura52::parallel_for<size_t>(slicer->application, 0, processed_layer_count,
+            [&](size_t layer_nr)
             {
-                if(layerParts[part].size() > 1) // first poly is the outer contour, 1..n are the holes
+                // Split the current layer into parts; the first poly of a part is the outer contour, 1..n are the holes
+                for (const PolygonsPart& part : layers[layer_nr].polygons.splitIntoParts())
                 {
-                    for(unsigned int hole_nr = 1; hole_nr < layerParts[part].size(); ++hole_nr)
+                    for (unsigned int hole_nr = 1; hole_nr < part.size(); ++hole_nr)
                     {
                         Polygons holePoly;
-                        holePoly.add(layerParts[part][hole_nr]);
-                        if (maxHoleArea > 0.0 && INT2MM2(std::abs(holePoly.area())) < maxHoleArea)
+                        holePoly.add(part[hole_nr]);
+                        if (INT2MM2(std::abs(holePoly.area())) < maxHoleArea)
                         {
-                            Polygons holeWithAbove = holePoly.intersection(above);
-                            if(!holeWithAbove.empty())
-                            {
-                                // The hole had some intersection with the above layer, check if it's a complete overlap
-                                Polygons holeDifference = holePoly.xorPolygons(holeWithAbove);
-                                if(holeDifference.empty())
-                                {
-                                    // The hole was returned unchanged, so the layer above must completely cover it.  Remove the hole from the layer above.
-                                    above = above.difference(holePoly);
-                                }
-                            }
+                            small_holes[layer_nr].push_back(std::move(holePoly));
                         }
                     }
                 }
+            });
+    }
+
+    for (int layer_nr = processed_layer_count - 1; layer_nr >= 0; layer_nr--)
+    {
+        SlicerLayer& layer = layers[layer_nr];
+        SlicerLayer& layer_above = layers[layer_nr + 1];
+        // Get a copy of the layer above to prune away before we shrink it
+        Polygons above = layer_above.polygons;
+
+        // Now go through the small holes in the current layer and check if they intersect anything in the layer above
+        // If not, then they're the top of a hole and should be cut from the layer above before the union
+        for (const Polygons& holePoly : small_holes[layer_nr])
+        {
+            Polygons holeWithAbove = holePoly.intersection(above);
+            if(!holeWithAbove.empty())
+            {
+                // The hole had some intersection with the above layer, check if it's a complete overlap
+                Polygons holeDifference = holePoly.xorPolygons(holeWithAbove);
+                if(holeDifference.empty())
+                {
+                    // The hole was returned unchanged, so the layer above must completely cover it.  Remove the hole from the layer above.
+                    above = above.difference(holePoly);
+                }
             }
-            // And now union with offset of the resulting above layer 
-            layer.polygons = layer.polygons.unionPolygons(above.offset(-max_dist_from_lower_layer));
         }
+        small_holes[layer_nr].clear();
+        // And now union with offset of the resulting above layer 
+        layer.polygons = layer.polygons.unionPolygons(above.offset(-max_dist_from_lower_layer));
     }
 }
 
@@ -66,6 +66,7 @@ bool FffGcodeWriter::setTargetFile(const char* filename)
     if (output_file.is_open())
     {
         gcode.setOutputStream(&output_file);
+        gcode.setChunkSource(filename);
         return true;
     }
     return false;
@@ -326,6 +327,29 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage)
         }
     }
   
+    // Estimated before anything is spilled, since this reads all layers.
+    const std::vector<double> layer_costs = storage.getLayerCosts(process_layer_starting_layer_nr, total_layers);
+
+    // From here on the layers are only read in order, so they can be kept under layer_spill_high_water by spilling the others to disk.
+    // This only lowers the memory during the export; the peak, with all layers generated, was reached before.
+    const Settings& mesh_group_settings = scene.current_mesh_group->settings;
+    size_t spill_high_water = mesh_group_settings.has("layer_spill_high_water") ? mesh_group_settings.get<size_t>("layer_spill_high_water") * 1024 * 1024 : 0;
+    if (spill_high_water == 0 && application->resources.hasMemoryCap())
+    {
+        // The job capped the memory without a limit for the layers: they get half of it, the rest is for the layer plans and everything else.
+        spill_high_water = application->resources.memoryBudget() / 2;
+    }
+    if (spill_high_water > 0 && ! application->tempDirectory.empty() && ! mesh_group_settings.get<bool>("magic_spiralize")) // Spiralize keeps pointers into the layers.
+    {
+        layer_window_below = 3; // Bridges look at the skin of up to three layers below.
+        layer_window_above = 1;
+        for (const SliceMeshStorage& mesh : storage.meshes)
+        {
+            layer_window_above = std::max(layer_window_above, LayerIndex(mesh.settings.get<size_t>("skin_edge_support_layers")));
+        }
+        storage.layer_spill = std::make_unique<LayerSpillStore>(storage, application->tempDirectory, spill_high_water);
+    }
+
     //引擎调试多线程
     if (scene.current_mesh_group->settings.get<RoutePlanning>("route_planning") == RoutePlanning::TOANDFRO)
     {
@@ -350,11 +374,13 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage)
             {
                 application->progressor.messageProgress(Progress::Stage::EXPORT, std::max(0, gcode_layer->getLayerNr()) + 1, total_layers);
                 layer_plan_buffer.handle(*gcode_layer, gcode);
-            });
+            },
+            layer_costs);
         CALLTICK("processLayer & handle 1");
     }
 
     layer_plan_buffer.flush();
+    storage.layer_spill.reset();
 
     INTERRUPT_RETURN("FffGcodeWriter::writeGCode");
 
@@ -1813,6 +1839,11 @@ LayerPlan& FffGcodeWriter::processLayer(const SliceDataStorage& storage, LayerIn
 {
     //LOGD("GcodeWriter processing layer {} of {}", layer_nr, total_layers);
     const Settings& mesh_group_settings = application->current_slice->scene.current_mesh_group->settings;
+    LayerSpillStore::Window layer_window; // Keeps the layers which this layer reads in memory, handed to the layer plan once it exists.
+    if (storage.layer_spill)
+    {
+        layer_window = storage.layer_spill->require(layer_nr - layer_window_below, layer_nr + layer_window_above);
+    }
     coord_t layer_thickness = mesh_group_settings.get<coord_t>("layer_height");
     coord_t z;
     bool include_helper_parts = true;
@@ -1903,6 +1934,7 @@ LayerPlan& FffGcodeWriter::processLayer(const SliceDataStorage& storage, LayerIn
 
     const coord_t first_outer_wall_line_width = scene.extruders[extruder_order.front()].settings.get<coord_t>("wall_line_width_0");
     LayerPlan& gcode_layer = *new LayerPlan(storage, layer_nr, z, layer_thickness, extruder_order.front(), fan_speed_layer_time_settings_per_extruder, comb_offset_from_outlines, first_outer_wall_line_width, avoid_distance);
+    gcode_layer.keepLayersInMemory(std::move(layer_window)); // Combing the travels to the next layer still reads them.
 	
 	//keliji 
 	if (mesh_group_settings.get<RoutePlanning>("route_planning") == RoutePlanning::TOANDFRO)
@@ -2396,7 +2428,7 @@ void FffGcodeWriter::addMeshLayerToGCode(const SliceDataStorage& storage, const
         return;
     }
 
-    gcode_layer.setMesh(mesh.mesh_name);
+    gcode_layer.setMesh(mesh.mesh_id);
 
     ZSeamConfig z_seam_config;
     if (mesh.isPrinted()) //"normal" meshes with walls, skin, infill, etc. get the traditional part ordering based on the z-seam settings.
@@ -2460,8 +2492,8 @@ void FffGcodeWriter::addMeshLayerToGCode(const SliceDataStorage& storage, const
         addMeshOpenPolyLinesToGCode(mesh, mesh_config, gcode_layer);
     }
     INTERRUPT_RETURN("addMeshOpenPolyLinesToGCode");
-    gcode_layer.setMesh2(mesh.mesh_name);
-    gcode_layer.setMesh("");
+    gcode_layer.setMesh2(mesh.mesh_id);
+    gcode_layer.setMesh(MeshIdRegistry::no_mesh);
 }
 
 void FffGcodeWriter::addMeshPartToGCode(const SliceDataStorage& storage, const SliceMeshStorage& mesh, const size_t extruder_nr, const PathConfigStorage::MeshPathConfigs& mesh_config, const SliceLayerPart& part, LayerPlan& gcode_layer)
@@ -3532,7 +3564,8 @@ void FffGcodeWriter::processTopBottom(const SliceDataStorage& storage,
 
         Polygons supported_skin_part_regions;
 
-        const int angle = bridgeAngle(mesh.settings, skin_part.skin_fill, storage, layer_nr, bridge_layer, support_layer, supported_skin_part_regions);
+        const BridgeSolidBelow& solid_below = gcode_layer.getBridgeSolidBelow(bridge_layer, mesh.settings.get<Ratio>("bridge_sparse_infill_max_density"));
+        const int angle = bridgeAngle(mesh.settings, skin_part.skin_fill, solid_below, support_layer, supported_skin_part_regions);
 
         if (angle > -1 || (support_threshold > 0 && (supported_skin_part_regions.area() / (skin_part.skin_fill.area() + 1) < support_threshold)))
         {
@@ -4491,6 +4524,7 @@ bool FffGcodeWriter::closeGcodeWriterFile()
 {
     if (output_file.is_open())
     {
+        gcode.emitEndChunk();
         output_file.close();
         return true;
     }
@@ -46,6 +46,7 @@
 #include "settings/AdaptiveLayerHeights.h"
 #include "settings/types/Angle.h"
 #include "settings/types/LayerIndex.h"
+#include "utils/CounterBasedRandom.h"
 #include "utils/algorithm.h"
 #include "utils/ThreadPool.h"
 #include "utils/gettime.h"
@@ -284,6 +285,7 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, SliceDataStorage& sto
         storage.meshes.emplace_back(&meshgroup->meshes[meshIdx], slicer->layers.size()); // new mesh in storage had settings from the Mesh
         SliceMeshStorage& meshStorage = storage.meshes.back();
         meshStorage.appliction = storage.application;
+        meshStorage.mesh_id = storage.mesh_ids.intern(meshStorage.mesh_name);
 
         // only create layer parts for normal meshes
         const bool is_support_modifier = AreaSupport::handleSupportModifierMesh(storage, mesh.settings, slicer);
@@ -497,11 +499,11 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage)
 
     LOGD("Meshes post-processing");
     // meshes post processing
-    for (SliceMeshStorage& mesh : storage.meshes)
+    for (size_t mesh_idx = 0; mesh_idx < storage.meshes.size(); mesh_idx++)
     {
         INTERRUPT_RETURN("FffPolygonGenerator::slices2polygons");
 
-        processDerivedWallsSkinInfill(mesh);
+        processDerivedWallsSkinInfill(storage.meshes[mesh_idx], mesh_idx);
     }
 
     LOGD("Processing gradual support");
@@ -571,8 +573,10 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(SliceDataStorage& storage,
 #else
 	// walls
 	CALLTICK("processWalls 0");
-	cura52::parallel_for<size_t>(application, 0,
+	const std::vector<double> layer_costs = mesh.getLayerCosts(); // Walls and skins both scale with the outlines.
+	cura52::parallel_for_weighted<size_t>(application, 0,
 		mesh_layer_count,
+		layer_costs,
 		[&](size_t layer_number)
 		{
 			INTERRUPT_RETURN("FffPolygonGenerator::processBasicWallsSkinInfill");
@@ -583,6 +587,15 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(SliceDataStorage& storage,
 	CALLTICK("processWalls 1");
 #endif
 
+    size_t wall_part_count = 0;
+    size_t offset_wall_part_count = 0;
+    for (const SliceLayer& layer : mesh.layers)
+    {
+        wall_part_count += layer.parts.size();
+        offset_wall_part_count += layer.offset_wall_part_count;
+    }
+    LOGI("Walls of { %zu } out of { %zu } parts generated with offsets.", offset_wall_part_count, wall_part_count);
+
     ProgressEstimatorLinear* skin_estimator = new ProgressEstimatorLinear(mesh_layer_count);
     mesh_inset_skin_progress_estimator->nextStage(skin_estimator);
 
@@ -617,8 +630,9 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(SliceDataStorage& storage,
     }
 
     guarded_progress.reset();
-    cura52::parallel_for<size_t>(application, 0,
+    cura52::parallel_for_weighted<size_t>(application, 0,
                                mesh_layer_count,
+                               layer_costs,
                                [&](size_t layer_number)
                                {
                                     INTERRUPT_RETURN("FffPolygonGenerator::processBasicWallsSkinInfill");
@@ -741,7 +755,7 @@ void FffPolygonGenerator::processInfillMesh(SliceDataStorage& storage, const siz
     }
 }
 
-void FffPolygonGenerator::processDerivedWallsSkinInfill(SliceMeshStorage& mesh)
+void FffPolygonGenerator::processDerivedWallsSkinInfill(SliceMeshStorage& mesh, const size_t mesh_idx)
 {
     if (mesh.settings.get<bool>("infill_support_enabled"))
     { // create gradual infill areas
@@ -791,7 +805,7 @@ void FffPolygonGenerator::processDerivedWallsSkinInfill(SliceMeshStorage& mesh)
     // fuzzy skin
     if (mesh.settings.get<bool>("magic_fuzzy_skin_enabled"))
     {
-        processFuzzyWalls(mesh);
+        processFuzzyWalls(mesh, mesh_idx);
     }
 }
 
@@ -1175,7 +1189,7 @@ void FffPolygonGenerator::processPlatformAdhesion(SliceDataStorage& storage)
 }
 
 
-void FffPolygonGenerator::processFuzzyWalls(SliceMeshStorage& mesh)
+void FffPolygonGenerator::processFuzzyWalls(SliceMeshStorage& mesh, const size_t mesh_idx)
 {
     if (mesh.settings.get<size_t>("wall_line_count") == 0)
     {
@@ -1189,108 +1203,120 @@ void FffPolygonGenerator::processFuzzyWalls(SliceMeshStorage& mesh)
     const coord_t min_dist_between_points = avg_dist_between_points * 3 / 4; // hardcoded: the point distance may vary between 3/4 and 5/4 the supplied value
     const coord_t range_random_point_dist = avg_dist_between_points / 2;
     unsigned int start_layer_nr = (mesh.settings.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM) ? 1 : 0; // don't make fuzzy skin on first layer if there's a brim
-
-    auto hole_area = Polygons();
-    std::function<bool(const bool&, const ExtrusionJunction&)> accumulate_is_in_hole = [](const bool& prev_result, const ExtrusionJunction& junction) { return false; };
-
-    for (unsigned int layer_nr = start_layer_nr; layer_nr < mesh.layers.size(); layer_nr++)
+    if (start_layer_nr >= mesh.layers.size())
     {
-        INTERRUPT_RETURN("FffPolygonGenerator::processFuzzyWalls");
+        return;
+    }
 
-        SliceLayer& layer = mesh.layers[layer_nr];
-        for (SliceLayerPart& part : layer.parts)
+    cura52::parallel_for<size_t>(application, start_layer_nr,
+        mesh.layers.size(),
+        [&](size_t layer_nr)
         {
-            std::vector<VariableWidthLines> result_paths;
-            for (auto& toolpath : part.wall_toolpaths)
-            {
-                if (toolpath.front().inset_idx != 0)
-                {
-                    result_paths.push_back(toolpath);
-                    continue;
-                }
+            INTERRUPT_RETURN("FffPolygonGenerator::processFuzzyWalls");
 
-                auto& result_lines = result_paths.emplace_back();
+            auto hole_area = Polygons();
+            std::function<bool(const bool&, const ExtrusionJunction&)> accumulate_is_in_hole = [](const bool& prev_result, const ExtrusionJunction& junction) { return false; };
 
-                if (apply_outside_only)
-                {
-                    hole_area = part.print_outline.getOutsidePolygons().offset(-line_width);
-                    accumulate_is_in_hole = [&hole_area](const bool& prev_result, const ExtrusionJunction& junction) { return prev_result || hole_area.inside(junction.p); };
-                }
-                for (auto& line : toolpath)
+            size_t wall_idx = 0; // Identifies the line within the layer for the random generator.
+            SliceLayer& layer = mesh.layers[layer_nr];
+            for (SliceLayerPart& part : layer.parts)
+            {
+                std::vector<VariableWidthLines> result_paths;
+                for (auto& toolpath : part.wall_toolpaths)
                 {
-                    if (apply_outside_only && std::accumulate(line.begin(), line.end(), false, accumulate_is_in_hole))
+                    if (toolpath.front().inset_idx != 0)
                     {
-                        result_lines.push_back(line);
+                        result_paths.push_back(toolpath);
                         continue;
                     }
 
-                    auto& result = result_lines.emplace_back();
-                    result.inset_idx = line.inset_idx;
-                    result.is_odd = line.is_odd;
-                    result.is_closed = line.is_closed;
+                    auto& result_lines = result_paths.emplace_back();
 
-                    // generate points in between p0 and p1
-                    int64_t dist_left_over = (min_dist_between_points / 4) + rand() % (min_dist_between_points / 4); // the distance to be traversed on the line before making the first new point
-                    auto* p0 = &line.front();
-                    for (auto& p1 : line)
+                    if (apply_outside_only)
                     {
-                        if (p0->p == p1.p) // avoid seams
+                        hole_area = part.print_outline.getOutsidePolygons().offset(-line_width);
+                        accumulate_is_in_hole = [&hole_area](const bool& prev_result, const ExtrusionJunction& junction) { return prev_result || hole_area.inside(junction.p); };
+                    }
+                    for (auto& line : toolpath)
+                    {
+                        wall_idx++;
+                        if (apply_outside_only && std::accumulate(line.begin(), line.end(), false, accumulate_is_in_hole))
                         {
-                            result.emplace_back(p1.p, p1.w, p1.perimeter_index);
+                            result_lines.push_back(line);
                             continue;
                         }
 
-                        // 'a' is the (next) new point between p0 and p1
-                        const Point p0p1 = p1.p - p0->p;
-                        const int64_t p0p1_size = vSize(p0p1);
-                        int64_t p0pa_dist = dist_left_over;
-                        if (p0pa_dist >= p0p1_size)
+                        auto& result = result_lines.emplace_back();
+                        result.inset_idx = line.inset_idx;
+                        result.is_odd = line.is_odd;
+                        result.is_closed = line.is_closed;
+
+                        // generate points in between p0 and p1
+                        // The first vertex never starts a segment, so its random stream is used for the initial distance.
+                        CounterBasedRandom start_random({ mesh_idx, layer_nr, wall_idx, 0 });
+                        int64_t dist_left_over = (min_dist_between_points / 4) + start_random.next(min_dist_between_points / 4); // the distance to be traversed on the line before making the first new point
+                        auto* p0 = &line.front();
+                        for (size_t vertex_idx = 0; vertex_idx < line.size(); vertex_idx++)
                         {
-                            const Point p = p1.p - (p0p1 / 2);
-                            const double width = (p1.w * vSize(p1.p - p) + p0->w * vSize(p0->p - p)) / p0p1_size;
-                            result.emplace_back(p, width, p1.perimeter_index);
+                            auto& p1 = line[vertex_idx];
+                            if (p0->p == p1.p) // avoid seams
+                            {
+                                result.emplace_back(p1.p, p1.w, p1.perimeter_index);
+                                continue;
+                            }
+
+                            CounterBasedRandom random({ mesh_idx, layer_nr, wall_idx, vertex_idx });
+                            // 'a' is the (next) new point between p0 and p1
+                            const Point p0p1 = p1.p - p0->p;
+                            const int64_t p0p1_size = vSize(p0p1);
+                            int64_t p0pa_dist = dist_left_over;
+                            if (p0pa_dist >= p0p1_size)
+                            {
+                                const Point p = p1.p - (p0p1 / 2);
+                                const double width = (p1.w * vSize(p1.p - p) + p0->w * vSize(p0->p - p)) / p0p1_size;
+                                result.emplace_back(p, width, p1.perimeter_index);
+                            }
+                            for (; p0pa_dist < p0p1_size; p0pa_dist += min_dist_between_points + random.next(range_random_point_dist))
+                            {
+                                const int r = random.next(fuzziness * 2) - fuzziness;
+                                const Point perp_to_p0p1 = turn90CCW(p0p1);
+                                const Point fuzz = normal(perp_to_p0p1, r);
+                                const Point pa = p0->p + normal(p0p1, p0pa_dist);
+                                const double width = (p1.w * vSize(p1.p - pa) + p0->w * vSize(p0->p - pa)) / p0p1_size;
+                                result.emplace_back(pa + fuzz, width, p1.perimeter_index);
+                            }
+                            // p0pa_dist > p0p1_size now because we broke out of the for-loop
+                            dist_left_over = p0pa_dist - p0p1_size;
+
+                            p0 = &p1;
                         }
-                        for (; p0pa_dist < p0p1_size; p0pa_dist += min_dist_between_points + rand() % range_random_point_dist)
+                        while (result.size() < 3)
                         {
-                            const int r = rand() % (fuzziness * 2) - fuzziness;
-                            const Point perp_to_p0p1 = turn90CCW(p0p1);
-                            const Point fuzz = normal(perp_to_p0p1, r);
-                            const Point pa = p0->p + normal(p0p1, p0pa_dist);
-                            const double width = (p1.w * vSize(p1.p - pa) + p0->w * vSize(p0->p - pa)) / p0p1_size;
-                            result.emplace_back(pa + fuzz, width, p1.perimeter_index);
+                            size_t point_idx = line.size() - 2;
+                            result.emplace_back(line[point_idx].p, line[point_idx].w, line[point_idx].perimeter_index);
+                            if (point_idx == 0)
+                            {
+                                break;
+                            }
+                            point_idx--;
                         }
-                        // p0pa_dist > p0p1_size now because we broke out of the for-loop
-                        dist_left_over = p0pa_dist - p0p1_size;
-
-                        p0 = &p1;
-                    }
-                    while (result.size() < 3)
-                    {
-                        size_t point_idx = line.size() - 2;
-                        result.emplace_back(line[point_idx].p, line[point_idx].w, line[point_idx].perimeter_index);
-                        if (point_idx == 0)
+                        if (result.size() < 3)
                         {
-                            break;
+                            result.clear();
+                            for (auto& p : line)
+                            {
+                                result.emplace_back(p.p, p.w, p.perimeter_index);
+                            }
                         }
-                        point_idx--;
-                    }
-                    if (result.size() < 3)
-                    {
-                        result.clear();
-                        for (auto& p : line)
+                        if (line.back().p == line.front().p) // avoid seams
                         {
-                            result.emplace_back(p.p, p.w, p.perimeter_index);
+                            result.back().p = result.front().p;
                         }
                     }
-                    if (line.back().p == line.front().p) // avoid seams
-                    {
-                        result.back().p = result.front().p;
-                    }
                 }
+                part.wall_toolpaths = std::move(result_paths);
             }
-            part.wall_toolpaths = result_paths;
-        }
-    }
+        });
 }
 
 
@@ -6,6 +6,7 @@
 #include "FffGcodeWriter.h"
 #include "LayerPlan.h"
 #include "WallToolPaths.h"
+#include "utils/PackedSparsePointGrid.h"
 
 #include <iterator>
 
@@ -198,9 +199,9 @@ bool InsetOrderOptimizer::addToLayer()
 }
 
 
-std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetOrderOptimizer::getRegionOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner)
+OrderConstraints InsetOrderOptimizer::getRegionOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner)
 {
-    std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> order_requirements;
+    OrderConstraints order_requirements(input.size());
 
     // We build a grid where we map toolpath vertex locations to toolpaths,
     // so that we can easily find which two toolpaths are next to each other,
@@ -237,6 +238,7 @@ std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetO
     {
         ExtrusionJunction j;
         const ExtrusionLine* line;
+        size_t line_idx; //!< The index of the line in the input.
     };
     struct Locator
     {
@@ -254,22 +256,23 @@ std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetO
     // However, higher values are better against the limitations of using a PointGrid rather than a LineGrid.
     constexpr float diagonal_extension = 1.9;
     const coord_t searching_radius = max_line_w * diagonal_extension;
-    using GridT = SparsePointGrid<LineLoc, Locator>;
+    using GridT = PackedSparsePointGrid<LineLoc, Locator>;
     GridT grid(searching_radius);
 
 
-    for (const ExtrusionLine* line : input)
+    for (size_t line_idx = 0; line_idx < input.size(); line_idx++)
     {
+        const ExtrusionLine* line = input[line_idx];
         for (const ExtrusionJunction& junction : *line)
         {
-            grid.insert(LineLoc{ junction, line });
+            grid.insert(LineLoc{ junction, line, line_idx });
         }
     }
-    for (const std::pair<SquareGrid::GridPoint, LineLoc>& pair : grid)
+    grid.finalize();
+    for (const LineLoc& lineloc_here : grid)
     {
-        const LineLoc& lineloc_here = pair.second;
         const ExtrusionLine* here = lineloc_here.line;
-        Point loc_here = pair.second.j.p;
+        Point loc_here = lineloc_here.j.p;
         std::vector<LineLoc> nearby_verts = grid.getNearby(loc_here, searching_radius);
         for (const LineLoc& lineloc_nearby : nearby_verts)
         {
@@ -288,43 +291,45 @@ std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetO
             {
                 if (here->is_odd && ! nearby->is_odd && nearby->inset_idx < here->inset_idx)
                 {
-                    order_requirements.emplace(std::make_pair(nearby, here));
+                    order_requirements.add(lineloc_nearby.line_idx, lineloc_here.line_idx);
                 }
                 if (nearby->is_odd && ! here->is_odd && here->inset_idx < nearby->inset_idx)
                 {
-                    order_requirements.emplace(std::make_pair(here, nearby));
+                    order_requirements.add(lineloc_here.line_idx, lineloc_nearby.line_idx);
                 }
             }
             else if ((nearby->inset_idx < here->inset_idx) == outer_to_inner)
             {
-                order_requirements.emplace(std::make_pair(nearby, here));
+                order_requirements.add(lineloc_nearby.line_idx, lineloc_here.line_idx);
             }
             else
             {
                 assert((nearby->inset_idx > here->inset_idx) == outer_to_inner);
-                order_requirements.emplace(std::make_pair(here, nearby));
+                order_requirements.add(lineloc_here.line_idx, lineloc_nearby.line_idx);
             }
         }
     }
+    order_requirements.finalize();
     return order_requirements;
 }
 
-std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetOrderOptimizer::getInsetOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner)
+OrderConstraints InsetOrderOptimizer::getInsetOrder(const std::vector<const ExtrusionLine*>& input, const bool outer_to_inner)
 {
-    std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> order;
+    OrderConstraints order(input.size());
 
-    std::vector<std::vector<const ExtrusionLine*>> walls_by_inset;
-    std::vector<std::vector<const ExtrusionLine*>> fillers_by_inset;
+    std::vector<std::vector<size_t>> walls_by_inset;
+    std::vector<std::vector<size_t>> fillers_by_inset;
 
-    for (const ExtrusionLine* line : input)
+    for (size_t line_idx = 0; line_idx < input.size(); line_idx++)
     {
+        const ExtrusionLine* line = input[line_idx];
         if (line->is_odd)
         {
             if (line->inset_idx >= fillers_by_inset.size())
             {
                 fillers_by_inset.resize(line->inset_idx + 1);
             }
-            fillers_by_inset[line->inset_idx].emplace_back(line);
+            fillers_by_inset[line->inset_idx].emplace_back(line_idx);
         }
         else
         {
@@ -332,38 +337,39 @@ std::unordered_set<std::pair<const ExtrusionLine*, const ExtrusionLine*>> InsetO
             {
                 walls_by_inset.resize(line->inset_idx + 1);
             }
-            walls_by_inset[line->inset_idx].emplace_back(line);
+            walls_by_inset[line->inset_idx].emplace_back(line_idx);
         }
     }
     for (size_t inset_idx = 0; inset_idx + 1 < walls_by_inset.size(); inset_idx++)
     {
-        for (const ExtrusionLine* line : walls_by_inset[inset_idx])
+        for (const size_t line : walls_by_inset[inset_idx])
         {
-            for (const ExtrusionLine* inner_line : walls_by_inset[inset_idx + 1])
+            for (const size_t inner_line : walls_by_inset[inset_idx + 1])
             {
-                const ExtrusionLine* before = inner_line;
-                const ExtrusionLine* after = line;
+                size_t before = inner_line;
+                size_t after = line;
                 if (outer_to_inner)
                 {
                     std::swap(before, after);
                 }
-                order.emplace(before, after);
+                order.add(before, after);
             }
         }
     }
     for (size_t inset_idx = 1; inset_idx < fillers_by_inset.size(); inset_idx++)
     {
-        for (const ExtrusionLine* line : fillers_by_inset[inset_idx])
+        for (const size_t line : fillers_by_inset[inset_idx])
         {
             if (inset_idx - 1 >= walls_by_inset.size())
                 continue;
-            for (const ExtrusionLine* enclosing_wall : walls_by_inset[inset_idx - 1])
+            for (const size_t enclosing_wall : walls_by_inset[inset_idx - 1])
             {
-                order.emplace(enclosing_wall, line);
+                order.add(enclosing_wall, line);
             }
         }
     }
 
+    order.finalize();
     return order;
 }
 
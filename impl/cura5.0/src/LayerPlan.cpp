@@ -20,6 +20,7 @@
 #include "utils/Simplify.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygonUtils.h"
+#include "utils/Slic3rGeometry.h"
 #include "Slice3rBase/ArcFitter.hpp"
 
 #include "settings/FlowTempGraph.h"
@@ -153,7 +154,7 @@ GCodePath* LayerPlan::getLatestPathWithConfig(const GCodePathConfig& config, Spa
 
 const Polygons* LayerPlan::getCombBoundaryInside() const
 {
-    return &comb_boundary_preferred;
+    return &comb_boundaries->preferred;
 }
 
 void LayerPlan::forceNewPathStart()
@@ -183,12 +184,10 @@ LayerPlan::LayerPlan(const SliceDataStorage& storage,
     , is_raft_layer(layer_nr < 0 - static_cast<LayerIndex>(Raft::getFillerLayerCount(storage.application)))
     , layer_thickness(layer_thickness)
     , has_prime_tower_planned_per_extruder(application->current_slice->scene.extruders.size(), false)
-    , current_mesh("")
+    , current_mesh(MeshIdRegistry::no_mesh)
     , last_extruder_previous_layer(start_extruder)
     , last_planned_extruder(&application->current_slice->scene.extruders[start_extruder])
     , first_travel_destination_is_inside(false) // set properly when addTravel is called for the first time (otherwise not set properly)
-    , comb_boundary_minimum(computeCombBoundary(CombBoundary::MINIMUM))
-    , comb_boundary_preferred(computeCombBoundary(CombBoundary::PREFERRED))
     , comb_move_inside_distance(comb_move_inside_distance)
     , fan_speed_layer_time_settings_per_extruder(fan_speed_layer_time_settings_per_extruder)
     , fill_lineWidth_diff(0)
@@ -196,9 +195,13 @@ LayerPlan::LayerPlan(const SliceDataStorage& storage,
     size_t current_extruder = start_extruder;
     was_inside = true; // not used, because the first travel move is bogus
     is_inside = false; // assumes the next move will not be to inside a layer part (overwritten just before going into a layer part)
+    comb_boundaries = storage.comb_boundary_cache.get(storage, layer_nr, comb_boundary_offset, [this, comb_boundary_offset]()
+        {
+            return std::make_shared<const CombBoundaries>(computeCombBoundary(CombBoundary::MINIMUM), computeCombBoundary(CombBoundary::PREFERRED), comb_boundary_offset);
+        });
     if (application->current_slice->scene.current_mesh_group->settings.get<CombingMode>("retraction_combing") != CombingMode::OFF)
     {
-        comb = new Comb(storage, layer_nr, comb_boundary_minimum, comb_boundary_preferred, comb_boundary_offset, travel_avoid_distance, comb_move_inside_distance);
+        comb = new Comb(storage, layer_nr, comb_boundaries, comb_boundary_offset, travel_avoid_distance, comb_move_inside_distance);
     }
     else
     {
@@ -220,7 +223,7 @@ LayerPlan::LayerPlan(const SliceDataStorage& storage,
     layerTemp = 0;
 	maxvolumetricspeed = 0.0;
 	pressureValue = -1;
-    tmp_mesh_name = "";
+    tmp_mesh_id = MeshIdRegistry::no_mesh;
     first_mesh_cancel = false;
     tmp_is_change_layer = 0;
     need_smart_brim = false;
@@ -247,6 +250,11 @@ LayerPlan::~LayerPlan()
         delete comb;
 }
 
+void LayerPlan::keepLayersInMemory(LayerSpillStore::Window&& window)
+{
+    layer_window = std::move(window);
+}
+
 ExtruderTrain* LayerPlan::getLastPlannedExtruderTrain()
 {
     return last_planned_extruder;
@@ -292,11 +300,11 @@ Polygons LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
                 {
                     if (combing_mode == CombingMode::ALL) // Add the increased outline offset (skin, infill and part of the inner walls)
                     {
-                        comb_boundary.add(part.outline.offset(offset));
+                        comb_boundary.add(*part.getOutlineOffset(offset, PolygonOffsetCache::Stage::COMBING, application->current_slice->offset_cache_budget));
                     }
                     else if (combing_mode == CombingMode::NO_SKIN) // Add the increased outline offset, subtract skin (infill and part of the inner walls)
                     {
-                        comb_boundary.add(part.outline.offset(offset).difference(part.inner_area.difference(part.infill_area)));
+                        comb_boundary.add(part.getOutlineOffset(offset, PolygonOffsetCache::Stage::COMBING, application->current_slice->offset_cache_budget)->difference(part.inner_area.difference(part.infill_area)));
                     }
                     else if (combing_mode == CombingMode::NO_OUTER_SURFACES)
                     {
@@ -309,7 +317,7 @@ Polygons LayerPlan::computeCombBoundary(const CombBoundary boundary_type)
                                 top_and_bottom_most_fill.add(skin_part.bottom_most_surface_fill);
                             }
                         }
-                        comb_boundary.add(part.outline.offset(offset).difference(top_and_bottom_most_fill));
+                        comb_boundary.add(part.getOutlineOffset(offset, PolygonOffsetCache::Stage::COMBING, application->current_slice->offset_cache_budget)->difference(top_and_bottom_most_fill));
                     }
                     else if (combing_mode == CombingMode::INFILL) // Add the infill (infill only)
                     {
@@ -386,19 +394,20 @@ bool LayerPlan::setExtruder(const size_t extruder_nr)
     }
     return true;
 }
-void LayerPlan::setMesh(const std::string mesh_id)
+void LayerPlan::setMesh(const MeshId mesh_id)
 {
     current_mesh = mesh_id;
 }
-void LayerPlan::setMesh2(const std::string mesh_id)
+void LayerPlan::setMesh2(const MeshId mesh_id)
 {
-    tmp_mesh_name = mesh_id;
+    tmp_mesh_id = mesh_id;
 }
 void LayerPlan::moveInsideCombBoundary(const coord_t distance, const std::optional<SliceLayerPart>& part)
 {
     constexpr coord_t max_dist2 = MM2INT(2.0) * MM2INT(2.0); // if we are further than this distance, we conclude we are not inside even though we thought we were.
     // this function is to be used to move from the boundary of a part to inside the part
     Point p = getLastPlannedPositionOrStartingPosition(); // copy, since we are going to move p
+    const Polygons& comb_boundary_preferred = comb_boundaries->preferred;
     if (PolygonUtils::moveInside(comb_boundary_preferred, p, distance, max_dist2) != NO_INDEX)
     {
         // Move inside again, so we move out of tight 90deg corners
@@ -1467,7 +1476,7 @@ void LayerPlan::addLinesByOptimizer(const Polygons& polygons,
                                     const bool reverse_print_direction)
 {
     Polygons boundary;
-    if (enable_travel_optimization && ! comb_boundary_minimum.empty())
+    if (enable_travel_optimization && ! comb_boundaries->minimum.empty())
     {
         // use the combing boundary inflated so that all infill lines are inside the boundary
         int dist = 0;
@@ -1484,7 +1493,7 @@ void LayerPlan::addLinesByOptimizer(const Polygons& polygons,
             }
             dist += 100; // ensure boundary is slightly outside all skin/infill lines
         }
-        boundary.add(comb_boundary_minimum.offset(dist));
+        boundary.add(comb_boundaries->minimum.offset(dist));
         // simplify boundary to cut down processing time
         boundary = Simplify(MM2INT(0.1), MM2INT(0.1), 0).polygon(boundary);
     }
@@ -2149,7 +2158,9 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
     const float acceleration_breaking = mesh_group_settings.get<double>("acceleration_breaking");
     const bool jerk_enabled = mesh_group_settings.get<bool>("jerk_enabled");
     const bool jerk_travel_enabled = mesh_group_settings.get<bool>("jerk_travel_enabled");
-    std::string current_mesh = "";
+    std::optional<MeshId> current_mesh = MeshIdRegistry::no_mesh; // The mesh of the last MESH comment. Empty after a NONMESH comment, which is repeated for every path outside of a mesh.
+    const std::string nonmesh_name = "NONMESH";
+    Slic3r::Points arc_fitting_points; // Reused for every arc fitted path, so that its capacity is only allocated once per layer.
 
     for (size_t extruder_plan_idx = 0; extruder_plan_idx < extruder_plans.size(); extruder_plan_idx++)
     {
@@ -2574,17 +2585,17 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
             //    tmp_mesh_name = path.mesh_id;
             //    tmp_is_change_layer = this->layer_nr;
             //}
-            if (!application->current_slice->scene.settings.get<bool>("special_object_cancel") && path.mesh_id != current_mesh)
+            if (!application->current_slice->scene.settings.get<bool>("special_object_cancel") && current_mesh != path.mesh_id)
             {
                 current_mesh = path.mesh_id;
-                if (current_mesh == "") current_mesh = "NONMESH";
+                if (path.mesh_id == MeshIdRegistry::no_mesh) current_mesh.reset();
                 std::stringstream ss;
-                ss << "MESH:" << current_mesh;
+                ss << "MESH:" << (current_mesh ? storage.mesh_ids.getName(*current_mesh) : nonmesh_name);
                 gcode.writeComment(ss.str());
             }
             if (application->current_slice->scene.settings.get<bool>("special_object_cancel") && !path.config->isTravelPath())
             {
-                tmp_mesh_name = path.mesh_id;
+                tmp_mesh_id = path.mesh_id;
             }
             if (path.config->isTravelPath())
             { // early comp for travel paths, which are handled more simply
@@ -2639,14 +2650,14 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                         && (application->current_slice->scene.settings.get<bool>("special_object_cancel")))
                     {
                         std::stringstream ss;
-                        ss << "MESH:" << current_mesh;
+                        ss << "MESH:" << (current_mesh ? storage.mesh_ids.getName(*current_mesh) : nonmesh_name);
                         gcode.writeComment(ss.str());
                         std::stringstream ss_exclude_end;
-                        ss_exclude_end << "EXCLUDE_OBJECT_END NAME=" << tmp_mesh_name;
+                        ss_exclude_end << "EXCLUDE_OBJECT_END NAME=" << storage.mesh_ids.getName(tmp_mesh_id);
                         gcode.writeComment2(ss_exclude_end.str());
 
                         std::stringstream ss_exclude_start;
-                        std::string tnam = path.mesh_id;
+                        std::string tnam = storage.mesh_ids.getName(path.mesh_id);
                         if (tnam == "") tnam = "0_1";
                         ss_exclude_start << "EXCLUDE_OBJECT_START NAME=" << tnam;
                         gcode.writeComment2(ss_exclude_start.str());
@@ -2746,7 +2757,8 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                                     tolerance *= 2.0;
 
                                 //double tolerance = 100;// 200;
-                                Slic3r::Points points;
+                                Slic3r::Points& points = arc_fitting_points;
+                                points.clear();
                                 std::vector<Slic3r::PathFittingData> fitting_result;
 
                                 if(isAvoidPoint && !path.points.empty())//ͳƱ˵ĵ G2G3ж
@@ -2756,11 +2768,7 @@ void LayerPlan::writeGCode(GCodeExport& gcode)
                                         points.emplace_back(Slic3r::Point((int64_t)gcode.getPositionXY().X, (int64_t)gcode.getPositionXY().Y));
                                     }
                                 }
-                                for (unsigned int point_idx = 0; point_idx < path.points.size(); point_idx++)
-                                {
-                                    points.emplace_back(Slic3r::Point((int64_t)path.points[point_idx].X, (int64_t)path.points[point_idx].Y));
-                                    //points.emplace_back(Slic3r::Point(path.points[point_idx].X, path.points[point_idx].Y));
-                                }
+                                Slic3rGeometry::appendPoints(path.points, 1, points);
 
                                 //Slic3r::ArcFitter::do_arc_fitting_and_simplify(points, fitting_result, tolerance);
                                 /*bool arcFittingValiable = */Slic3r::ArcFitter::do_arc_fitting(points, fitting_result, tolerance);
@@ -30,6 +30,7 @@ void LayerPlanBuffer::handle(LayerPlan& layer_plan, GCodeExport& gcode)
     if (to_be_written)
     {
         to_be_written->writeGCode(gcode);
+        gcode.emitLayerChunk(to_be_written->getLayerNr());
         delete to_be_written;
     }
 }
@@ -67,6 +68,7 @@ void LayerPlanBuffer::flush()
     while (! buffer.empty())
     {
         buffer.front()->writeGCode(gcode);
+        gcode.emitLayerChunk(buffer.front()->getLayerNr());
         delete buffer.front();
         buffer.pop_front();
     }
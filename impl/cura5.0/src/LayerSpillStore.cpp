@@ -0,0 +1,546 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::min and std::max.
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio> //For std::remove.
+#include <cstdlib> //For std::exit.
+#include <cstring> //For memcpy.
+
+#include "LayerSpillStore.h"
+#include "sliceDataStorage.h"
+
+#include "ccglobal/log.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+/*!
+ * Appends the contents of layers to a byte buffer.
+ */
+class LayerWriter
+{
+public:
+    explicit LayerWriter(std::vector<char>& buffer)
+    : buffer(buffer)
+    {
+    }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        const char* data = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), data, data + sizeof(T));
+    }
+
+    void write(const Polygons& polygons)
+    {
+        write<uint64_t>(polygons.size());
+        for (const ClipperLib::Path& path : polygons.paths)
+        {
+            write<uint64_t>(path.size());
+            const char* data = reinterpret_cast<const char*>(path.data());
+            buffer.insert(buffer.end(), data, data + path.size() * sizeof(Point));
+        }
+    }
+
+    void write(const std::vector<VariableWidthLines>& toolpaths)
+    {
+        write<uint64_t>(toolpaths.size());
+        for (const VariableWidthLines& lines : toolpaths)
+        {
+            write<uint64_t>(lines.size());
+            for (const ExtrusionLine& line : lines)
+            {
+                write<uint64_t>(line.inset_idx);
+                write<int32_t>(line.start_idx);
+                write<uint8_t>(line.is_odd);
+                write<uint8_t>(line.is_closed);
+                write<uint64_t>(line.junctions.size());
+                for (const ExtrusionJunction& junction : line.junctions)
+                {
+                    write(junction.p);
+                    write<int64_t>(junction.w);
+                    write<uint64_t>(junction.perimeter_index);
+                    write<int64_t>(junction.overhang_distance);
+                }
+            }
+        }
+    }
+
+    void write(const SliceLayer& layer)
+    {
+        write<uint64_t>(layer.parts.size());
+        for (const SliceLayerPart& part : layer.parts)
+        {
+            write(part.boundaryBox.min);
+            write(part.boundaryBox.max);
+            write(part.outline);
+            write(part.print_outline);
+            write(part.spiral_wall);
+            write(part.inner_area);
+            write<uint64_t>(part.skin_parts.size());
+            for (const SkinPart& skin_part : part.skin_parts)
+            {
+                write(skin_part.outline);
+                write(skin_part.inset_paths);
+                write(skin_part.skin_fill);
+                write(skin_part.roofing_fill);
+                write(skin_part.top_most_surface_fill);
+                write(skin_part.bottom_most_surface_fill);
+            }
+            write(part.wall_toolpaths);
+            write(part.infill_wall_toolpaths);
+            write(part.infill_area);
+            write<uint8_t>(part.infill_area_own.has_value());
+            if (part.infill_area_own)
+            {
+                write(*part.infill_area_own);
+            }
+            write<uint64_t>(part.infill_area_per_combine_per_density.size());
+            for (const std::vector<Polygons>& per_combine : part.infill_area_per_combine_per_density)
+            {
+                write<uint64_t>(per_combine.size());
+                for (const Polygons& area : per_combine)
+                {
+                    write(area);
+                }
+            }
+        }
+        write(layer.openPolyLines);
+        write(layer.top_surface.areas);
+    }
+
+private:
+    std::vector<char>& buffer;
+};
+
+/*!
+ * Reads back what \ref LayerWriter wrote.
+ */
+class LayerReader
+{
+public:
+    LayerReader(const std::vector<char>& buffer)
+    : position(buffer.data())
+    , end(buffer.data() + buffer.size())
+    {
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value;
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void read(Polygons& polygons)
+    {
+        polygons.paths.resize(read<uint64_t>());
+        for (ClipperLib::Path& path : polygons.paths)
+        {
+            path.resize(read<uint64_t>());
+            readBytes(path.data(), path.size() * sizeof(Point));
+        }
+    }
+
+    void read(std::vector<VariableWidthLines>& toolpaths)
+    {
+        toolpaths.resize(read<uint64_t>());
+        for (VariableWidthLines& lines : toolpaths)
+        {
+            lines.resize(read<uint64_t>());
+            for (ExtrusionLine& line : lines)
+            {
+                line.inset_idx = read<uint64_t>();
+                line.start_idx = read<int32_t>();
+                line.is_odd = read<uint8_t>();
+                line.is_closed = read<uint8_t>();
+                const size_t junction_count = read<uint64_t>();
+                line.junctions.reserve(junction_count);
+                for (size_t junction_idx = 0; junction_idx < junction_count; junction_idx++)
+                {
+                    const Point p = read<Point>();
+                    const coord_t w = read<int64_t>();
+                    const size_t perimeter_index = read<uint64_t>();
+                    const coord_t overhang_distance = read<int64_t>();
+                    line.junctions.emplace_back(p, w, perimeter_index, overhang_distance);
+                }
+            }
+        }
+    }
+
+    void read(SliceLayer& layer)
+    {
+        layer.parts.resize(read<uint64_t>());
+        for (SliceLayerPart& part : layer.parts)
+        {
+            part.boundaryBox.min = read<Point>();
+            part.boundaryBox.max = read<Point>();
+            read(part.outline);
+            read(part.print_outline);
+            read(part.spiral_wall);
+            read(part.inner_area);
+            part.skin_parts.resize(read<uint64_t>());
+            for (SkinPart& skin_part : part.skin_parts)
+            {
+                read(skin_part.outline);
+                read(skin_part.inset_paths);
+                read(skin_part.skin_fill);
+                read(skin_part.roofing_fill);
+                read(skin_part.top_most_surface_fill);
+                read(skin_part.bottom_most_surface_fill);
+            }
+            read(part.wall_toolpaths);
+            read(part.infill_wall_toolpaths);
+            read(part.infill_area);
+            if (read<uint8_t>())
+            {
+                part.infill_area_own.emplace();
+                read(*part.infill_area_own);
+            }
+            part.infill_area_per_combine_per_density.resize(read<uint64_t>());
+            for (std::vector<Polygons>& per_combine : part.infill_area_per_combine_per_density)
+            {
+                per_combine.resize(read<uint64_t>());
+                for (Polygons& area : per_combine)
+                {
+                    read(area);
+                }
+            }
+        }
+        read(layer.openPolyLines);
+        read(layer.top_surface.areas);
+    }
+
+private:
+    void readBytes(void* data, const size_t size)
+    {
+        if (static_cast<size_t>(end - position) < size)
+        {
+            LOGE("Spilled layer data is truncated.");
+            std::exit(1);
+        }
+        memcpy(data, position, size);
+        position += size;
+    }
+
+    const char* position;
+    const char* end;
+};
+
+size_t polygonsBytes(const Polygons& polygons)
+{
+    size_t bytes = sizeof(ClipperLib::Path) * polygons.size();
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        bytes += path.size() * sizeof(Point);
+    }
+    return bytes;
+}
+
+size_t toolpathsBytes(const std::vector<VariableWidthLines>& toolpaths)
+{
+    size_t bytes = 0;
+    for (const VariableWidthLines& lines : toolpaths)
+    {
+        bytes += sizeof(VariableWidthLines) + lines.size() * sizeof(ExtrusionLine);
+        for (const ExtrusionLine& line : lines)
+        {
+            bytes += line.junctions.size() * sizeof(ExtrusionJunction);
+        }
+    }
+    return bytes;
+}
+
+/*!
+ * Free all memory of the spilled members of a layer.
+ */
+void clearLayer(SliceLayer& layer)
+{
+    std::vector<SliceLayerPart>().swap(layer.parts);
+    layer.openPolyLines = Polygons();
+    layer.top_surface.areas = Polygons();
+}
+
+std::atomic<size_t> spill_file_count{ 0 };
+
+} // namespace
+
+LayerSpillStore::Window::Window(LayerSpillStore* store, size_t first, size_t last)
+: store(store)
+, first(first)
+, last(last)
+{
+}
+
+LayerSpillStore::Window::Window(Window&& other)
+: store(other.store)
+, first(other.first)
+, last(other.last)
+{
+    other.store = nullptr;
+}
+
+LayerSpillStore::Window& LayerSpillStore::Window::operator=(Window&& other)
+{
+    if (this != &other)
+    {
+        if (store)
+        {
+            store->release(first, last);
+        }
+        store = other.store;
+        first = other.first;
+        last = other.last;
+        other.store = nullptr;
+    }
+    return *this;
+}
+
+LayerSpillStore::Window::~Window()
+{
+    if (store)
+    {
+        store->release(first, last);
+    }
+}
+
+LayerSpillStore::LayerSpillStore(SliceDataStorage& storage, const std::string& directory, const size_t high_water_bytes)
+: storage(storage)
+, high_water_bytes(high_water_bytes)
+{
+    size_t layer_count = 0;
+    for (const SliceMeshStorage& mesh : storage.meshes)
+    {
+        layer_count = std::max(layer_count, mesh.layers.size());
+    }
+    layers.resize(layer_count);
+    for (size_t layer_nr = 0; layer_nr < layer_count; layer_nr++)
+    {
+        layers[layer_nr].bytes = residentBytes(layer_nr);
+        resident_bytes += layers[layer_nr].bytes;
+    }
+    statistics.peak_resident_bytes = resident_bytes;
+    spill_above = layer_count;
+
+    const std::string separator = (directory.empty() || directory.back() == '/' || directory.back() == '\\') ? "" : "/";
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    file_name = directory + separator + "layers-" + std::to_string(now) + "-" + std::to_string(spill_file_count++) + ".spill";
+}
+
+LayerSpillStore::~LayerSpillStore()
+{
+    if (file.is_open())
+    {
+        file.close();
+        std::remove(file_name.c_str());
+    }
+    if (statistics.spilled_layer_count > 0)
+    {
+        LOGI("Layer spilling: wrote { %zu } layers ({ %zu } bytes), dropped { %zu }, read back { %zu } layers ({ %zu } bytes), peak resident { %zu } bytes.",
+            statistics.spilled_layer_count, statistics.spilled_bytes, statistics.dropped_layer_count, statistics.faulted_layer_count, statistics.faulted_bytes, statistics.peak_resident_bytes);
+    }
+}
+
+LayerSpillStore::Window LayerSpillStore::require(const LayerIndex first, const LayerIndex last)
+{
+    const int layer_count = static_cast<int>(layers.size());
+    if (first > last || last < 0 || first >= layer_count)
+    {
+        return Window();
+    }
+    const size_t first_nr = std::max(0, static_cast<int>(first));
+    const size_t last_nr = std::min(layer_count - 1, static_cast<int>(last));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t layer_nr = first_nr; layer_nr <= last_nr; layer_nr++)
+    {
+        layers[layer_nr].pin_count++;
+        if (! layers[layer_nr].resident)
+        {
+            fault(layer_nr);
+        }
+    }
+    statistics.peak_resident_bytes = std::max(statistics.peak_resident_bytes, resident_bytes);
+    enforceHighWater();
+    return Window(this, first_nr, last_nr);
+}
+
+LayerSpillStore::Statistics LayerSpillStore::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+void LayerSpillStore::release(const size_t first, const size_t last)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t layer_nr = first; layer_nr <= last; layer_nr++)
+    {
+        assert(layers[layer_nr].pin_count > 0);
+        layers[layer_nr].pin_count--;
+    }
+    enforceHighWater();
+}
+
+void LayerSpillStore::enforceHighWater()
+{
+    if (resident_bytes <= high_water_bytes || file_failed)
+    {
+        return;
+    }
+    size_t lowest_pinned = layers.size();
+    size_t highest_pinned = 0;
+    for (size_t layer_nr = spill_below; layer_nr < spill_above; layer_nr++)
+    {
+        if (layers[layer_nr].pin_count > 0)
+        {
+            lowest_pinned = std::min(lowest_pinned, layer_nr);
+            highest_pinned = layer_nr;
+        }
+    }
+    // Layers below all windows were processed already, so they are the least likely to be needed again.
+    for (; spill_below < std::min(lowest_pinned, spill_above) && resident_bytes > high_water_bytes && ! file_failed; spill_below++)
+    {
+        if (layers[spill_below].resident)
+        {
+            spill(spill_below);
+        }
+    }
+    const size_t keep_below = (lowest_pinned == layers.size()) ? spill_below : highest_pinned + 1;
+    for (; spill_above > keep_below && resident_bytes > high_water_bytes && ! file_failed; spill_above--)
+    {
+        if (layers[spill_above - 1].resident)
+        {
+            spill(spill_above - 1);
+        }
+    }
+}
+
+void LayerSpillStore::spill(const size_t layer_nr)
+{
+    LayerState& state = layers[layer_nr];
+    assert(state.resident && state.pin_count == 0);
+    if (! state.on_disk)
+    {
+        std::vector<char> buffer;
+        LayerWriter writer(buffer);
+        for (const SliceMeshStorage& mesh : storage.meshes)
+        {
+            if (layer_nr < mesh.layers.size())
+            {
+                writer.write(mesh.layers[layer_nr]);
+            }
+        }
+
+        if (! file.is_open())
+        {
+            file.open(file_name, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        }
+        file.seekp(static_cast<std::streamoff>(file_end));
+        file.write(buffer.data(), buffer.size());
+        if (! file.good())
+        {
+            LOGE("Can't write layers to { %s }, keeping them in memory.", file_name.c_str());
+            file_failed = true;
+            return;
+        }
+        state.file_offset = file_end;
+        state.file_size = buffer.size();
+        state.on_disk = true;
+        file_end += buffer.size();
+        statistics.spilled_layer_count++;
+        statistics.spilled_bytes += buffer.size();
+    }
+    else
+    {
+        statistics.dropped_layer_count++;
+    }
+
+    for (SliceMeshStorage& mesh : storage.meshes)
+    {
+        if (layer_nr < mesh.layers.size())
+        {
+            clearLayer(mesh.layers[layer_nr]);
+        }
+    }
+    state.resident = false;
+    resident_bytes -= state.bytes;
+}
+
+void LayerSpillStore::fault(const size_t layer_nr)
+{
+    LayerState& state = layers[layer_nr];
+    assert(! state.resident && state.on_disk);
+    std::vector<char> buffer(state.file_size);
+    file.seekg(static_cast<std::streamoff>(state.file_offset));
+    file.read(buffer.data(), buffer.size());
+    if (! file.good())
+    {
+        LOGE("Can't read layers back from { %s }.", file_name.c_str());
+        std::exit(1);
+    }
+
+    LayerReader reader(buffer);
+    for (SliceMeshStorage& mesh : storage.meshes)
+    {
+        if (layer_nr < mesh.layers.size())
+        {
+            reader.read(mesh.layers[layer_nr]);
+        }
+    }
+    state.resident = true;
+    resident_bytes += state.bytes;
+    spill_below = std::min(spill_below, layer_nr);
+    spill_above = std::max(spill_above, layer_nr + 1);
+    statistics.faulted_layer_count++;
+    statistics.faulted_bytes += buffer.size();
+}
+
+size_t LayerSpillStore::residentBytes(const size_t layer_nr) const
+{
+    size_t bytes = 0;
+    for (const SliceMeshStorage& mesh : storage.meshes)
+    {
+        if (layer_nr >= mesh.layers.size())
+        {
+            continue;
+        }
+        const SliceLayer& layer = mesh.layers[layer_nr];
+        bytes += polygonsBytes(layer.openPolyLines) + polygonsBytes(layer.top_surface.areas);
+        for (const SliceLayerPart& part : layer.parts)
+        {
+            bytes += sizeof(SliceLayerPart);
+            bytes += polygonsBytes(part.outline) + polygonsBytes(part.print_outline) + polygonsBytes(part.spiral_wall) + polygonsBytes(part.inner_area) + polygonsBytes(part.infill_area);
+            if (part.infill_area_own)
+            {
+                bytes += polygonsBytes(*part.infill_area_own);
+            }
+            for (const std::vector<Polygons>& per_combine : part.infill_area_per_combine_per_density)
+            {
+                for (const Polygons& area : per_combine)
+                {
+                    bytes += polygonsBytes(area);
+                }
+            }
+            bytes += toolpathsBytes(part.wall_toolpaths) + toolpathsBytes(part.infill_wall_toolpaths);
+            for (const SkinPart& skin_part : part.skin_parts)
+            {
+                bytes += sizeof(SkinPart);
+                bytes += polygonsBytes(skin_part.outline) + polygonsBytes(skin_part.skin_fill) + polygonsBytes(skin_part.roofing_fill);
+                bytes += polygonsBytes(skin_part.top_most_surface_fill) + polygonsBytes(skin_part.bottom_most_surface_fill);
+                bytes += toolpathsBytes(skin_part.inset_paths);
+            }
+        }
+    }
+    return bytes;
+}
+
+} // namespace cura52
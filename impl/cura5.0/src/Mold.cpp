@@ -10,10 +10,27 @@
 #include "slicer.h"
 #include "settings/types/Ratio.h"
 #include "utils/IntPoint.h"
+#include "utils/ThreadPool.h"
 
 namespace cura52
 {
 
+namespace
+{
+
+/*!
+ * What the mold of a mesh needs of one layer which doesn't depend on the
+ * other layers, so that it can be computed for all layers in parallel.
+ */
+struct MoldLayer
+{
+    Polygons model_outlines; //!< The sliced polygons and open polylines: the casting cutout.
+    Polygons shell; //!< The model outlines offset by the mold width.
+    Polygons roof; //!< The sliced polygons offset by the mold width, for the roofs of the layers above.
+};
+
+} // namespace
+
 void Mold::process(Application* application, std::vector<Slicer*>& slicer_list)
 {
     Scene& scene = application->current_slice->scene;
@@ -45,78 +62,104 @@ void Mold::process(Application* application, std::vector<Slicer*>& slicer_list)
     }
 
     const coord_t layer_height = scene.current_mesh_group->settings.get<coord_t>("layer_height");
-    std::vector<Polygons> mold_outline_above_per_mesh; // the outer outlines of the layer above without the original model(s) being cut out
-    mold_outline_above_per_mesh.resize(slicer_list.size());
-    for (int layer_nr = layer_count - 1; layer_nr >= 0; layer_nr--)
-    {
-        Polygons all_original_mold_outlines; // outlines of all models for which to generate a mold (insides of all molds)
+    std::vector<std::vector<MoldLayer>> mold_layers_per_mesh(slicer_list.size()); // empty for meshes without a mold
 
-        // first generate outlines
-        for (unsigned int mesh_idx = 0; mesh_idx < slicer_list.size(); mesh_idx++)
+    // first generate outlines
+    for (unsigned int mesh_idx = 0; mesh_idx < slicer_list.size(); mesh_idx++)
+    {
+        const Mesh& mesh = scene.current_mesh_group->meshes[mesh_idx];
+        Slicer& slicer = *slicer_list[mesh_idx];
+        if (!mesh.settings.get<bool>("mold_enabled") || slicer.layers.empty())
         {
-            const Mesh& mesh = scene.current_mesh_group->meshes[mesh_idx];
-            Slicer& slicer = *slicer_list[mesh_idx];
-            if (!mesh.settings.get<bool>("mold_enabled") || layer_nr >= static_cast<int>(slicer.layers.size()))
-            {
-                continue;
-            }
-            coord_t width = mesh.settings.get<coord_t>("mold_width");
-            coord_t open_polyline_width = mesh.settings.get<coord_t>("wall_line_width_0");
-            if (layer_nr == 0)
-            {
-                const ExtruderTrain& train_wall_0 = mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr");
-                open_polyline_width *= train_wall_0.settings.get<Ratio>("initial_layer_line_width_factor");
-            }
-            const AngleDegrees angle = mesh.settings.get<AngleDegrees>("mold_angle");
-            const coord_t roof_height = mesh.settings.get<coord_t>("mold_roof_height");
-
-            const coord_t inset = tan(angle / 180 * M_PI) * layer_height;
-            const size_t roof_layer_count = roof_height / layer_height;
-
-
-            SlicerLayer& layer = slicer.layers[layer_nr];
-            Polygons model_outlines = layer.polygons.unionPolygons(layer.openPolylines.offsetPolyLine(open_polyline_width / 2));
-            layer.openPolylines.clear();
-            all_original_mold_outlines.add(model_outlines);
-
-            if (angle >= 90)
-            {
-                layer.polygons = model_outlines.offset(width, ClipperLib::jtRound);
-            }
-            else
+            continue;
+        }
+        const coord_t width = mesh.settings.get<coord_t>("mold_width");
+        const coord_t open_polyline_width = mesh.settings.get<coord_t>("wall_line_width_0");
+        const ExtruderTrain& train_wall_0 = mesh.settings.get<ExtruderTrain&>("wall_0_extruder_nr");
+        const coord_t open_polyline_width_0 = open_polyline_width * train_wall_0.settings.get<Ratio>("initial_layer_line_width_factor");
+        const AngleDegrees angle = mesh.settings.get<AngleDegrees>("mold_angle");
+        const coord_t roof_height = mesh.settings.get<coord_t>("mold_roof_height");
+
+        const coord_t inset = tan(angle / 180 * M_PI) * layer_height;
+        const size_t roof_layer_count = roof_height / layer_height;
+
+        std::vector<MoldLayer>& mold_layers = mold_layers_per_mesh[mesh_idx];
+        mold_layers.resize(slicer.layers.size());
+        cura52::parallel_for<size_t>(application, 0, slicer.layers.size(),
+            [&](size_t layer_nr)
             {
-                Polygons& mold_outline_above = mold_outline_above_per_mesh[mesh_idx]; // the outside of the mold on the layer above
-                layer.polygons = mold_outline_above.offset(-inset).unionPolygons(model_outlines.offset(width, ClipperLib::jtRound));
-            }
-
-            // add roofs
+                SlicerLayer& layer = slicer.layers[layer_nr];
+                MoldLayer& mold_layer = mold_layers[layer_nr];
+                const coord_t polyline_width = (layer_nr == 0) ? open_polyline_width_0 : open_polyline_width;
+                mold_layer.model_outlines = layer.polygons.unionPolygons(layer.openPolylines.offsetPolyLine(polyline_width / 2));
+                layer.openPolylines.clear();
+                mold_layer.shell = mold_layer.model_outlines.offset(width, ClipperLib::jtRound);
+                if (roof_layer_count > 0 && (layer_nr == 0 || layer_nr + roof_layer_count < slicer.layers.size()))
+                {
+                    // The roof is the layer as it was sliced, without the open polylines.
+                    mold_layer.roof = layer.polygons.offset(width, ClipperLib::jtRound);
+                }
+            });
+
+        const auto add_roofs = [&](const size_t layer_nr)
+        {
             if (roof_layer_count > 0 && layer_nr > 0)
             {
-                unsigned int layer_nr_below = std::max(0, static_cast<int>(layer_nr - roof_layer_count));
-                Polygons roofs = slicer.layers[layer_nr_below].polygons.offset(width, ClipperLib::jtRound); // TODO: don't compute offset twice!
-                layer.polygons = layer.polygons.unionPolygons(roofs);
+                const size_t layer_nr_below = std::max(0, static_cast<int>(layer_nr - roof_layer_count));
+                SlicerLayer& layer = slicer.layers[layer_nr];
+                layer.polygons = layer.polygons.unionPolygons(mold_layers[layer_nr_below].roof);
             }
+        };
 
-            mold_outline_above_per_mesh[mesh_idx] = layer.polygons;
+        if (angle >= 90)
+        {
+            cura52::parallel_for<size_t>(application, 0, slicer.layers.size(),
+                [&](size_t layer_nr)
+                {
+                    slicer.layers[layer_nr].polygons = std::move(mold_layers[layer_nr].shell);
+                    add_roofs(layer_nr);
+                });
         }
-        all_original_mold_outlines = all_original_mold_outlines.unionPolygons();
-
-        // cut out molds from all objects after generating mold outlines for all objects so that molds won't overlap into the casting cutout of another mold
-
-        // carve molds out of all other models
-        for (unsigned int mesh_idx = 0; mesh_idx < slicer_list.size(); mesh_idx++)
+        else
         {
-            const Mesh& mesh = scene.current_mesh_group->meshes[mesh_idx];
-            if (!mesh.settings.get<bool>("mold_enabled"))
+            // Each layer of the mold is the layer above it, inset by the mold angle, so only this part goes from the top down.
+            Polygons mold_outline_above; // the outside of the mold on the layer above
+            for (int layer_nr = slicer.layers.size() - 1; layer_nr >= 0; layer_nr--)
             {
-                continue; // only cut original models out of all molds
+                SlicerLayer& layer = slicer.layers[layer_nr];
+                layer.polygons = mold_outline_above.offset(-inset).unionPolygons(mold_layers[layer_nr].shell);
+                mold_layers[layer_nr].shell.clear();
+                add_roofs(layer_nr);
+                mold_outline_above = layer.polygons;
             }
-            Slicer& slicer = *slicer_list[mesh_idx];
-            SlicerLayer& layer = slicer.layers[layer_nr];
-            layer.polygons = layer.polygons.difference(all_original_mold_outlines);
         }
     }
 
+    // cut out molds from all objects after generating mold outlines for all objects so that molds won't overlap into the casting cutout of another mold
+    cura52::parallel_for<size_t>(application, 0, layer_count,
+        [&](size_t layer_nr)
+        {
+            Polygons all_original_mold_outlines; // outlines of all models for which to generate a mold (insides of all molds)
+            for (const std::vector<MoldLayer>& mold_layers : mold_layers_per_mesh)
+            {
+                if (layer_nr < mold_layers.size())
+                {
+                    all_original_mold_outlines.add(mold_layers[layer_nr].model_outlines);
+                }
+            }
+            all_original_mold_outlines = all_original_mold_outlines.unionPolygons();
+
+            // carve molds out of all other models
+            for (unsigned int mesh_idx = 0; mesh_idx < slicer_list.size(); mesh_idx++)
+            {
+                if (layer_nr >= mold_layers_per_mesh[mesh_idx].size())
+                {
+                    continue; // only cut original models out of all molds
+                }
+                SlicerLayer& layer = slicer_list[mesh_idx]->layers[layer_nr];
+                layer.polygons = layer.polygons.difference(all_original_mold_outlines);
+            }
+        });
 }
 
 
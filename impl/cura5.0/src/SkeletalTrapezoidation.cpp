@@ -29,30 +29,30 @@ namespace cura52
 
 SkeletalTrapezoidation::node_t& SkeletalTrapezoidation::makeNode(vd_t::vertex_type& vd_node, Point p)
 {
-    auto he_node_it = vd_node_to_he_node.find(&vd_node);
-    if (he_node_it == vd_node_to_he_node.end())
+    node_t*& he_node = heNodeOf(&vd_node);
+    if (! he_node)
     {
         graph.nodes.emplace_front(SkeletalTrapezoidationJoint(), p);
-        node_t& node = graph.nodes.front();
-        vd_node_to_he_node.emplace(&vd_node, &node);
-        return node;
-    }
-    else
-    {
-        return *he_node_it->second;
+        he_node = &graph.nodes.front();
     }
+    return *he_node;
+}
+
+void SkeletalTrapezoidation::resetVoronoiMapping(const vd_t& vd)
+{
+    vd_edges_begin = vd.edges().data();
+    vd_vertices_begin = vd.vertices().data();
+    vd_edge_to_he_edge.assign(vd.edges().size(), nullptr);
+    vd_node_to_he_node.assign(vd.vertices().size(), nullptr);
 }
 
 void SkeletalTrapezoidation::transferEdge(Point from, Point to, vd_t::edge_type& vd_edge, edge_t*& prev_edge, Point& start_source_point, Point& end_source_point, const std::vector<Point>& points, const std::vector<Segment>& segments)
 {
-    auto he_edge_it = vd_edge_to_he_edge.find(vd_edge.twin());
-    if (he_edge_it != vd_edge_to_he_edge.end())
+    edge_t* source_twin = heEdgeOf(vd_edge.twin());
+    if (source_twin)
     { // Twin segment(s) have already been made
-        edge_t* source_twin = he_edge_it->second;
-        assert(source_twin);
-        auto end_node_it = vd_node_to_he_node.find(vd_edge.vertex1());
-        assert(end_node_it != vd_node_to_he_node.end());
-        node_t* end_node = end_node_it->second;
+        node_t* end_node = heNodeOf(vd_edge.vertex1());
+        assert(end_node);
         for (edge_t* twin = source_twin;; twin = twin->prev->twin->prev)
         {
             if (! twin)
@@ -150,7 +150,11 @@ void SkeletalTrapezoidation::transferEdge(Point from, Point to, vd_t::edge_type&
             }
         }
         assert(prev_edge);
-        vd_edge_to_he_edge.emplace(&vd_edge, prev_edge);
+        edge_t*& mapped_edge = heEdgeOf(&vd_edge);
+        if (! mapped_edge)
+        {
+            mapped_edge = prev_edge;
+        }
     }
 }
 
@@ -513,9 +517,6 @@ inline static void rotate_back_skeletal_trapezoidation_graph_after_fix(SkeletalT
 
 void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
 {
-    vd_edge_to_he_edge.clear();
-    vd_node_to_he_node.clear();
-
     std::vector<Point> points; // Remains empty
 
     std::vector<Segment> segments;
@@ -550,7 +551,8 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
     bool degenerated_voronoi_diagram = has_missing_voronoi_vertex || !is_voronoi_diagram_planar;
 
 process_voronoi_diagram:
-    assert(this->graph.edges.empty() && this->graph.nodes.empty() && this->vd_edge_to_he_edge.empty() && this->vd_node_to_he_node.empty());
+    assert(this->graph.edges.empty() && this->graph.nodes.empty());
+    resetVoronoiMapping(vonoroi_diagram);
     for (vd_t::cell_type cell : vonoroi_diagram.cells())
     {
         if (!cell.incident_edge())
@@ -585,7 +587,7 @@ process_voronoi_diagram:
         // Copy start to end edge to graph
         edge_t* prev_edge = nullptr;
         transferEdge(start_source_point, VoronoiUtils::p(starting_vonoroi_edge->vertex1()), *starting_vonoroi_edge, prev_edge, start_source_point, end_source_point, points, segments);
-        node_t* starting_node = vd_node_to_he_node[starting_vonoroi_edge->vertex0()];
+        node_t* starting_node = heNodeOf(starting_vonoroi_edge->vertex0());
         starting_node->data.distance_to_boundary = 0;
 
         constexpr bool is_next_to_start_or_end = true;
@@ -619,8 +621,6 @@ process_voronoi_diagram:
 
         this->graph.edges.clear();
         this->graph.nodes.clear();
-        this->vd_edge_to_he_edge.clear();
-        this->vd_node_to_he_node.clear();
 
         goto process_voronoi_diagram;
     }
@@ -197,20 +197,7 @@ bool STHalfEdgeNode::isLocalMaximum(bool strict) const
 
 void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
 {
-    std::unordered_map<edge_t*, std::list<edge_t>::iterator> edge_locator;
-    std::unordered_map<node_t*, std::list<node_t>::iterator> node_locator;
-
-    for (auto edge_it = edges.begin(); edge_it != edges.end(); ++edge_it)
-    {
-        edge_locator.emplace(&*edge_it, edge_it);
-    }
-
-    for (auto node_it = nodes.begin(); node_it != nodes.end(); ++node_it)
-    {
-        node_locator.emplace(&*node_it, node_it);
-    }
-
-    auto safelyRemoveEdge = [this, &edge_locator](edge_t* to_be_removed, std::list<edge_t>::iterator& current_edge_it, bool& edge_it_is_updated)
+    auto safelyRemoveEdge = [this](edge_t* to_be_removed, PooledList<edge_t>::iterator& current_edge_it, bool& edge_it_is_updated)
     {
         if (current_edge_it != edges.end() && to_be_removed == &*current_edge_it)
         {
@@ -219,7 +206,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
         }
         else
         {
-            edges.erase(edge_locator[to_be_removed]);
+            edges.erase(edges.iteratorTo(to_be_removed));
         }
     };
 
@@ -280,7 +267,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
                 }
             }
 
-            nodes.erase(node_locator[quad_mid->to]);
+            nodes.erase(nodes.iteratorTo(quad_mid->to));
 
             quad_mid->prev->next = quad_mid->next;
             quad_mid->next->prev = quad_mid->prev;
@@ -310,7 +297,7 @@ void SkeletalTrapezoidationGraph::collapseSmallEdges(coord_t snap_dist)
                     quad_end->from->incident_edge = quad_end->prev->twin;
                 }
             }
-            nodes.erase(node_locator[quad_start->from]);
+            nodes.erase(nodes.iteratorTo(quad_start->from));
 
             quad_start->twin->twin = quad_end->twin;
             quad_end->twin->twin = quad_start->twin;
@@ -7,7 +7,9 @@
 #include "Slice.h"
 #include "Application.h"
 
+#include <cstring> // memcpy
 #include <fstream>      // std::ofstream
+#include <vector>
 
 namespace cura52
 {
@@ -46,6 +48,110 @@ namespace cura52
         scene.extruders.clear();
         scene.mesh_groups.clear();
         scene.settings = Settings();
+
+        std::lock_guard<std::mutex> lock(split_polygons_mutex);
+        split_lines_loaded = false;
+        split_lines.clear();
+        split_polygons.clear();
+    }
+
+    /*!
+     * Read the lines of a polygon file as written by crslice::CrScene::savePloygons:
+     * the number of lines, then for each line the number of points and the x and y
+     * of every point in mm, as int and float in native byte order.
+     */
+    static Polygons readSplitLines(const std::string& file_name)
+    {
+        Polygons lines;
+        std::ifstream in(file_name, std::ios::binary | std::ios::ate);
+        if (! in.is_open())
+        {
+            return lines;
+        }
+        const std::streamoff file_size = in.tellg();
+        if (file_size <= 0)
+        {
+            return lines;
+        }
+        std::vector<char> data(static_cast<size_t>(file_size));
+        in.seekg(0);
+        in.read(data.data(), file_size);
+        if (in.gcount() != file_size)
+        {
+            LOGW("Can't read the split polygon file { %s }.", file_name.c_str());
+            return lines;
+        }
+
+        size_t position = 0;
+        auto read = [&data, &position](void* value, const size_t size)
+        {
+            if (position + size > data.size())
+            {
+                return false;
+            }
+            memcpy(value, data.data() + position, size);
+            position += size;
+            return true;
+        };
+
+        int line_count = 0;
+        read(&line_count, sizeof(int));
+        for (int line_idx = 0; line_idx < line_count; line_idx++)
+        {
+            int point_count = 0;
+            if (! read(&point_count, sizeof(int)) || point_count < 0 || position + size_t(point_count) * 2 * sizeof(float) > data.size())
+            {
+                LOGW("The split polygon file { %s } is truncated.", file_name.c_str());
+                break;
+            }
+            ClipperLib::Path path;
+            path.reserve(point_count);
+            for (int point_idx = 0; point_idx < point_count; point_idx++)
+            {
+                float xy[2];
+                read(xy, sizeof(xy));
+                path.push_back(ClipperLib::IntPoint(MM2INT(xy[0]), MM2INT(xy[1])));
+            }
+            if (! path.empty())
+            {
+                lines.add(path);
+            }
+        }
+        return lines;
+    }
+
+    const SplitPolygons& Slice::getSplitPolygons(const Settings& mesh_settings)
+    {
+        static const SplitPolygons no_split_polygons;
+
+        std::lock_guard<std::mutex> lock(split_polygons_mutex);
+        if (! split_lines_loaded)
+        {
+            split_lines = readSplitLines(ploygonFile);
+            split_lines_loaded = true;
+        }
+        if (split_lines.empty())
+        {
+            return no_split_polygons;
+        }
+
+        const coord_t gap = mesh_settings.get<coord_t>("mesh_split_gap");
+        auto found = split_polygons.find(gap);
+        if (found != split_polygons.end())
+        {
+            return found->second;
+        }
+
+        SplitPolygons& result = split_polygons[gap];
+        ClipperLib::ClipperOffset clipper;
+        clipper.AddPaths(split_lines.paths, ClipperLib::JoinType::jtSquare, ClipperLib::etOpenSquare);
+        clipper.Execute(result.polygons.paths, gap);
+        result.path_boxes.reserve(result.polygons.size());
+        for (ConstPolygonRef path : result.polygons)
+        {
+            result.path_boxes.emplace_back(path);
+        }
+        return result;
     }
 
     void Slice::finalize()
@@ -1302,7 +1302,7 @@ void ThomasTreeSupport::mergeInfluenceAreas(std::unordered_map<TreeSupportElemen
 
 
     const size_t input_size = influence_areas.size();
-    size_t num_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency())); // For some reason hardware concurrency can return 0;
+    size_t num_threads = application->thread_pool->thread_count() + 1; // The workers plus the main thread, as many as the resource limits allow.
 
     if (input_size == 0)
     {
@@ -0,0 +1,482 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::sort.
+#include <atomic>
+#include <cstring> //For memcpy and memcmp.
+#include <filesystem>
+
+#include "TreeModelVolumesDiskCache.h"
+
+#include "ccglobal/log.h"
+
+namespace cura54
+{
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+constexpr char magic[4] = { 'C', 'R', 'T', 'V' };
+constexpr uint32_t format_version = 1;
+constexpr size_t header_bytes = sizeof(magic) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr size_t index_entry_bytes = sizeof(uint8_t) + 2 * sizeof(int64_t) + 2 * sizeof(uint64_t);
+
+const std::string file_prefix = "tree-volumes-";
+const std::string file_extension = ".cache";
+
+std::atomic<size_t> temp_file_count{ 0 };
+
+uint64_t rotl(const uint64_t x, const int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t fmix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/*!
+ * Appends values to a byte buffer, which is written to the file one area at a
+ * time. Coordinates go as zigzag varints of their
+ * difference with the previous point, which are mostly one or two bytes.
+ */
+class AreaWriter
+{
+public:
+    explicit AreaWriter(std::vector<char>& buffer)
+    : buffer(buffer)
+    {
+    }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        const char* data = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), data, data + sizeof(T));
+    }
+
+    void writeVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void writeDelta(const int64_t delta)
+    {
+        writeVarint((static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+    }
+
+    void write(const cura52::Polygons& polygons)
+    {
+        writeVarint(polygons.size());
+        cura52::Point previous(0, 0);
+        for (const ClipperLib::Path& path : polygons.paths)
+        {
+            writeVarint(path.size());
+            for (const cura52::Point& point : path)
+            {
+                writeDelta(point.X - previous.X);
+                writeDelta(point.Y - previous.Y);
+                previous = point;
+            }
+        }
+    }
+
+private:
+    std::vector<char>& buffer;
+};
+
+/*!
+ * Reads back what \ref AreaWriter wrote. Stops at the end of the buffer
+ * instead of reading past it, so that a damaged file is only a miss.
+ */
+class AreaReader
+{
+public:
+    explicit AreaReader(const std::vector<char>& buffer)
+    : position(buffer.data())
+    , end(buffer.data() + buffer.size())
+    {
+    }
+
+    bool readVarint(uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < end; shift += 7)
+        {
+            const uint8_t byte = static_cast<uint8_t>(*position++);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readDelta(int64_t& delta)
+    {
+        uint64_t value;
+        if (! readVarint(value))
+        {
+            return false;
+        }
+        delta = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        return true;
+    }
+
+    bool read(cura52::Polygons& polygons)
+    {
+        uint64_t path_count;
+        if (! readVarint(path_count) || path_count > static_cast<uint64_t>(end - position))
+        {
+            return false;
+        }
+        polygons.paths.resize(path_count);
+        cura52::Point previous(0, 0);
+        for (ClipperLib::Path& path : polygons.paths)
+        {
+            uint64_t point_count;
+            if (! readVarint(point_count) || point_count > static_cast<uint64_t>(end - position) / 2)
+            {
+                return false;
+            }
+            path.resize(point_count);
+            for (cura52::Point& point : path)
+            {
+                int64_t dx;
+                int64_t dy;
+                if (! readDelta(dx) || ! readDelta(dy))
+                {
+                    return false;
+                }
+                point = cura52::Point(previous.X + dx, previous.Y + dy);
+                previous = point;
+            }
+        }
+        return position == end;
+    }
+
+private:
+    const char* position;
+    const char* end;
+};
+
+template<typename T>
+T readValue(const char*& position)
+{
+    T value;
+    memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+TreeModelVolumesDiskCache::KeyBuilder::KeyBuilder()
+: lane_a(0x9e3779b97f4a7c15ull)
+, lane_b(0xc2b2ae3d27d4eb4full)
+{
+}
+
+void TreeModelVolumesDiskCache::KeyBuilder::word(const uint64_t value)
+{
+    lane_a = rotl((lane_a ^ value) * 0x87c37b91114253d5ull, 31);
+    lane_b = rotl((lane_b ^ rotl(value, 17)) * 0x4cf5ad432745937full, 29) + lane_a;
+}
+
+void TreeModelVolumesDiskCache::KeyBuilder::polygons(const cura52::Polygons& polygons)
+{
+    word(polygons.size());
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        word(path.size());
+        for (const cura52::Point& point : path)
+        {
+            word(static_cast<uint64_t>(point.X));
+            word(static_cast<uint64_t>(point.Y));
+        }
+    }
+}
+
+std::string TreeModelVolumesDiskCache::KeyBuilder::hex() const
+{
+    static const char digits[] = "0123456789abcdef";
+    const uint64_t lanes[2] = { fmix(lane_a + lane_b), fmix(lane_b ^ rotl(lane_a, 23)) };
+    std::string result;
+    for (const uint64_t lane : lanes)
+    {
+        for (int shift = 60; shift >= 0; shift -= 4)
+        {
+            result.push_back(digits[(lane >> shift) & 0xf]);
+        }
+    }
+    return result;
+}
+
+size_t TreeModelVolumesDiskCache::EntryKeyHash::operator()(const EntryKey& key) const
+{
+    return static_cast<size_t>(fmix(static_cast<uint64_t>(key.radius) * 0x9e3779b97f4a7c15ull ^ static_cast<uint64_t>(key.layer_idx) << 8 ^ key.area));
+}
+
+TreeModelVolumesDiskCache::TreeModelVolumesDiskCache(const std::string& directory, const std::string& key, const size_t max_bytes)
+: directory(directory)
+, max_bytes(max_bytes)
+{
+    const std::string separator = (directory.empty() || directory.back() == '/' || directory.back() == '\\') ? "" : "/";
+    file_name = directory + separator + file_prefix + key + file_extension;
+    open();
+}
+
+TreeModelVolumesDiskCache::~TreeModelVolumesDiskCache()
+{
+    if (! index.empty())
+    {
+        LOGI("Tree support volumes read from disk: { %zu } of { %zu } areas, { %zu } bytes.", loaded_count, index.size(), loaded_bytes);
+    }
+}
+
+void TreeModelVolumesDiskCache::open()
+{
+    file.open(file_name, std::ios::binary);
+    if (! file.is_open())
+    {
+        return;
+    }
+
+    char header[header_bytes];
+    if (! file.read(header, header_bytes) || memcmp(header, magic, sizeof(magic)) != 0)
+    {
+        file.close();
+        return;
+    }
+    const char* position = header + sizeof(magic);
+    const uint32_t version = readValue<uint32_t>(position);
+    const uint64_t entry_count = readValue<uint64_t>(position);
+    const uint64_t index_offset = readValue<uint64_t>(position);
+    file.seekg(0, std::ios::end);
+    const uint64_t file_bytes = static_cast<uint64_t>(file.tellg());
+    if (version != format_version || index_offset > file_bytes || (file_bytes - index_offset) / index_entry_bytes != entry_count)
+    {
+        file.close();
+        return;
+    }
+
+    std::vector<char> index_data(entry_count * index_entry_bytes);
+    if (! file.seekg(index_offset) || ! file.read(index_data.data(), index_data.size()))
+    {
+        file.close();
+        return;
+    }
+    index.reserve(entry_count);
+    position = index_data.data();
+    for (uint64_t entry_idx = 0; entry_idx < entry_count; entry_idx++)
+    {
+        EntryKey entry_key;
+        entry_key.area = readValue<uint8_t>(position);
+        entry_key.radius = readValue<int64_t>(position);
+        entry_key.layer_idx = readValue<int64_t>(position);
+        Location location;
+        location.offset = readValue<uint64_t>(position);
+        location.size = readValue<uint64_t>(position);
+        if (location.offset < header_bytes || location.offset + location.size > index_offset)
+        {
+            index.clear();
+            file.close();
+            return;
+        }
+        index.emplace(entry_key, location);
+    }
+
+    // The modification time is the last use, for evicting.
+    std::error_code error;
+    fs::last_write_time(fs::u8path(file_name), fs::file_time_type::clock::now(), error);
+}
+
+bool TreeModelVolumesDiskCache::isComplete() const
+{
+    return file.is_open();
+}
+
+bool TreeModelVolumesDiskCache::load(const Area area, const cura52::coord_t radius, const cura52::LayerIndex layer_idx, cura52::Polygons& result)
+{
+    std::vector<char> data;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (! file.is_open())
+        {
+            return false;
+        }
+        const auto found = index.find(EntryKey{ static_cast<uint8_t>(area), radius, layer_idx });
+        if (found == index.end())
+        {
+            return false;
+        }
+        data.resize(found->second.size);
+        file.clear();
+        if (! file.seekg(found->second.offset) || ! file.read(data.data(), data.size()))
+        {
+            LOGW("Tree support volumes cache { %s } could not be read.", file_name.c_str());
+            return false;
+        }
+        loaded_count++;
+        loaded_bytes += data.size();
+    }
+
+    cura52::Polygons polygons;
+    AreaReader reader(data);
+    if (! reader.read(polygons))
+    {
+        LOGW("Tree support volumes cache { %s } is damaged.", file_name.c_str());
+        return false;
+    }
+    result = std::move(polygons);
+    return true;
+}
+
+void TreeModelVolumesDiskCache::store(const std::vector<Entry>& entries)
+{
+    if (directory.empty())
+    {
+        return;
+    }
+
+    // Written under another name first, so that an interrupted write never leaves a file which seems complete.
+    // The areas are written one at a time as they are encoded; only the index is kept until the end.
+    const std::string temp_name = file_name + ".tmp-" + std::to_string(temp_file_count++);
+    uint64_t file_bytes = 0;
+    {
+        std::ofstream out(temp_name, std::ios::binary | std::ios::trunc);
+        std::vector<char> area_data;
+        std::vector<char> index_data;
+        AreaWriter area_writer(area_data);
+        AreaWriter index_writer(index_data);
+        index_data.reserve(entries.size() * index_entry_bytes);
+
+        const std::vector<char> placeholder(header_bytes, 0); // Filled in once the index offset is known.
+        out.write(placeholder.data(), placeholder.size());
+        uint64_t offset = header_bytes;
+        for (const Entry& entry : entries)
+        {
+            if (! out)
+            {
+                break;
+            }
+            area_data.clear();
+            area_writer.write(*entry.polygons);
+            out.write(area_data.data(), area_data.size());
+            index_writer.write<uint8_t>(static_cast<uint8_t>(entry.area));
+            index_writer.write<int64_t>(entry.radius);
+            index_writer.write<int64_t>(entry.layer_idx);
+            index_writer.write<uint64_t>(offset);
+            index_writer.write<uint64_t>(area_data.size());
+            offset += area_data.size();
+        }
+        const uint64_t index_offset = offset;
+        out.write(index_data.data(), index_data.size());
+        file_bytes = index_offset + index_data.size();
+
+        std::vector<char> header;
+        AreaWriter header_writer(header);
+        header.insert(header.end(), magic, magic + sizeof(magic));
+        header_writer.write<uint32_t>(format_version);
+        header_writer.write<uint64_t>(entries.size());
+        header_writer.write<uint64_t>(index_offset);
+        out.seekp(0);
+        if (! out.write(header.data(), header.size()) || ! out.flush())
+        {
+            LOGW("Tree support volumes cache { %s } could not be written.", temp_name.c_str());
+            out.close();
+            std::error_code error;
+            fs::remove(fs::u8path(temp_name), error);
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        file.close();
+        index.clear();
+    }
+    std::error_code error;
+    fs::rename(fs::u8path(temp_name), fs::u8path(file_name), error);
+    if (error)
+    {
+        LOGW("Tree support volumes cache { %s } could not be written.", file_name.c_str());
+        fs::remove(fs::u8path(temp_name), error);
+        return;
+    }
+    LOGI("Tree support volumes written to disk: { %zu } areas, { %zu } bytes.", entries.size(), static_cast<size_t>(file_bytes));
+    evict();
+}
+
+void TreeModelVolumesDiskCache::evict() const
+{
+    if (max_bytes == 0)
+    {
+        return;
+    }
+
+    struct CacheFile
+    {
+        fs::path path;
+        fs::file_time_type used;
+        uintmax_t bytes;
+    };
+    std::vector<CacheFile> cache_files;
+    uintmax_t total = 0;
+
+    std::error_code error;
+    for (fs::directory_iterator it(fs::u8path(directory), error), end; ! error && it != end; it.increment(error))
+    {
+        const fs::path& path = it->path();
+        const std::string name = path.filename().u8string();
+        if (name.compare(0, file_prefix.size(), file_prefix) != 0 || path.extension() != file_extension)
+        {
+            continue;
+        }
+        std::error_code file_error;
+        CacheFile cache_file{ path, fs::last_write_time(path, file_error), fs::file_size(path, file_error) };
+        if (file_error)
+        {
+            continue;
+        }
+        total += cache_file.bytes;
+        cache_files.push_back(cache_file);
+    }
+    if (total <= max_bytes)
+    {
+        return;
+    }
+
+    std::sort(cache_files.begin(), cache_files.end(), [](const CacheFile& a, const CacheFile& b) { return a.used < b.used; });
+    size_t removed = 0;
+    for (const CacheFile& cache_file : cache_files)
+    {
+        if (total <= max_bytes)
+        {
+            break;
+        }
+        std::error_code remove_error;
+        if (fs::remove(cache_file.path, remove_error))
+        {
+            total -= cache_file.bytes;
+            removed++;
+        }
+    }
+    LOGI("Tree support volumes cache evicted { %zu } files, { %zu } bytes left.", removed, static_cast<size_t>(total));
+}
+
+} // namespace cura54
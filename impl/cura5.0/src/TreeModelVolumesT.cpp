@@ -7,6 +7,10 @@
 #include "utils/ThreadPool.h"
 #include "TreeSupportT.h"
 
+#include "ccglobal/log.h"
+
+#include <cstring> //For memcpy.
+
 
 
 
@@ -14,6 +18,18 @@
 namespace cura54
 {
     typedef cura52::LayerIndex LayerIndex;
+
+    namespace
+    {
+        uint64_t doubleBits(double value)
+        {
+            value += 0.0; // -0 and +0 give the same areas.
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    }
+
     TreeModelVolumesT::TreeModelVolumesT
     (
         const cura52::SliceDataStorage& storage,
@@ -175,6 +191,10 @@ namespace cura54
         radius_0 = config.getRadius(0);
         support_rest_preference = config.support_rest_preference;
         simplifier = cura52::Simplify(min_maximum_resolution, min_maximum_deviation, min_maximum_area_deviation);
+
+        const cura52::Settings& group_settings = layer_outlines_[current_outline_idx].first;
+        disk_cache_enabled_ = ! application->tempDirectory.empty() && group_settings.has("support_tree_cache_volumes") && group_settings.get<bool>("support_tree_cache_volumes");
+        disk_cache_max_bytes_ = (group_settings.has("support_tree_cache_size") ? group_settings.get<size_t>("support_tree_cache_size") : 1024) * 1024 * 1024;
     }
 
     void TreeModelVolumesT::precalculate(cura52::coord_t max_layer)
@@ -252,6 +272,18 @@ namespace cura54
         std::deque<RadiusLayerPair> relevant_collision_radiis;
         relevant_collision_radiis.insert(relevant_collision_radiis.end(), radius_until_layer.begin(), radius_until_layer.end()); // Now that required_avoidance_limit contains the maximum of old and regular required radius just copy.
 
+        // Slicing the same outlines with the same distances again gives the same areas, which were kept on disk the last time.
+        // They are read only when asked for, so this is as lazy as not precalculating, but without calculating.
+        if (disk_cache_enabled_)
+        {
+            disk_cache_ = std::make_unique<TreeModelVolumesDiskCache>(application->tempDirectory, getDiskCacheKey(max_layer), disk_cache_max_bytes_);
+            if (disk_cache_->isComplete())
+            {
+                precalculationFinished = true;
+                return;
+            }
+        }
+
         // ### Calculate the relevant collisions
         calculateCollision(relevant_collision_radiis);
 
@@ -320,6 +352,10 @@ namespace cura54
         }
 
         precalculationFinished = true;
+        if (disk_cache_)
+        {
+            storeToDiskCache();
+        }
         const auto dur_col = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_coll - t_start).count();
         const auto dur_acc = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_acc - t_coll).count();
         const auto dur_avo = 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(t_avo - t_acc).count();
@@ -331,6 +367,116 @@ namespace cura54
 
     }
 
+    std::string TreeModelVolumesT::getDiskCacheKey(cura52::coord_t max_layer) const
+    {
+        const TreeSupportSettingsT config(layer_outlines_[current_outline_idx].first);
+        TreeModelVolumesDiskCache::KeyBuilder key;
+        key.word(max_layer);
+        key.word(max_move_);
+        key.word(max_move_slow_);
+        key.word(min_offset_per_step_);
+        key.word(current_outline_idx);
+        key.word(current_min_xy_dist);
+        key.word(current_min_xy_dist_delta);
+        key.word(max_layer_idx_without_blocker);
+        key.word(support_rests_on_model);
+        key.word(increase_until_radius);
+        key.word(radius_0);
+        key.word(static_cast<uint64_t>(support_rest_preference));
+        key.word(TreeSupportSettingsT::has_to_rely_on_min_xy_dist_only);
+
+        // The settings of the current group which the radii and distances are derived from.
+        key.word(config.maximum_move_distance);
+        key.word(config.maximum_move_distance_slow);
+        key.word(config.layer_height);
+        key.word(config.branch_radius);
+        key.word(config.min_radius);
+        key.word(config.max_radius);
+        key.word(config.tip_layers);
+        key.word(doubleBits(config.diameter_angle_scale_factor));
+        key.word(config.increase_radius_until_radius);
+        key.word(config.increase_radius_until_dtt);
+        key.word(config.xy_distance);
+        key.word(config.xy_min_distance);
+        key.word(static_cast<uint64_t>(config.support_overrides));
+        key.word(config.bp_radius);
+        key.word(config.layer_start_bp_radius);
+        key.word(doubleBits(config.diameter_scale_bp_radius));
+        key.word(config.z_distance_top_layers);
+        key.word(config.z_distance_bottom_layers);
+
+        // The outlines of all groups, with the settings collisions are calculated with.
+        key.word(layer_outlines_.size());
+        for (const auto& layer_outline : layer_outlines_)
+        {
+            const cura52::Settings& settings = layer_outline.first;
+            key.word(settings.get<cura52::coord_t>("layer_height"));
+            key.word(static_cast<uint64_t>(settings.get<cura52::ESupportType>("support_type")));
+            key.word(settings.get<cura52::coord_t>("support_bottom_distance"));
+            key.word(settings.get<cura52::coord_t>("support_top_distance"));
+            key.word(settings.get<cura52::coord_t>("support_xy_distance"));
+            key.word(settings.get<cura52::coord_t>("meshfix_maximum_resolution"));
+            key.word(settings.get<cura52::coord_t>("meshfix_maximum_deviation"));
+            key.word(settings.get<cura52::coord_t>("meshfix_maximum_extrusion_area_deviation"));
+            key.word(layer_outline.second.size());
+            for (const cura52::Polygons& outline : layer_outline.second)
+            {
+                key.polygons(outline);
+            }
+        }
+
+        key.word(anti_overhang_.size());
+        for (const cura52::Polygons& anti_overhang : anti_overhang_)
+        {
+            key.polygons(anti_overhang);
+        }
+        key.polygons(machine_border_);
+        return key.hex();
+    }
+
+    template <typename KEY>
+    bool TreeModelVolumesT::loadFromDiskCache(TreeModelVolumesDiskCache::Area area, cura52::coord_t radius, LayerIndex layer_idx, std::unordered_map<KEY, cura52::Polygons>& cache, const KEY key, std::mutex& mutex)
+    {
+        cura52::Polygons polygons;
+        if (! disk_cache_ || ! disk_cache_->load(area, radius, layer_idx, polygons))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> critical_section(mutex);
+        cache.emplace(key, std::move(polygons)); // Another thread may have read or calculated it meanwhile; it is the same area.
+        return true;
+    }
+
+    void TreeModelVolumesT::storeToDiskCache()
+    {
+        using Area = TreeModelVolumesDiskCache::Area;
+        std::vector<TreeModelVolumesDiskCache::Entry> entries;
+        const auto add = [&entries](const Area area, const std::unordered_map<RadiusLayerPair, cura52::Polygons>& cache)
+        {
+            for (const auto& [key, polygons] : cache)
+            {
+                entries.push_back(TreeModelVolumesDiskCache::Entry{ area, key.first, key.second, &polygons });
+            }
+        };
+        add(Area::COLLISION, collision_cache_);
+        add(Area::COLLISION_HOLEFREE, collision_cache_holefree_);
+        add(Area::AVOIDANCE_COLLISION, avoidance_cache_collision_);
+        add(Area::AVOIDANCE, avoidance_cache_);
+        add(Area::AVOIDANCE_SLOW, avoidance_cache_slow_);
+        add(Area::AVOIDANCE_TO_MODEL, avoidance_cache_to_model_);
+        add(Area::AVOIDANCE_TO_MODEL_SLOW, avoidance_cache_to_model_slow_);
+        add(Area::PLACEABLE, placeable_areas_cache_);
+        add(Area::AVOIDANCE_HOLE, avoidance_cache_hole_);
+        add(Area::AVOIDANCE_HOLE_TO_MODEL, avoidance_cache_hole_to_model_);
+        add(Area::WALL_RESTRICTION, wall_restrictions_cache_);
+        add(Area::WALL_RESTRICTION_MIN, wall_restrictions_cache_min_);
+        for (const auto& [layer_idx, polygons] : accumulated_placeables_cache_radius_0_)
+        {
+            entries.push_back(TreeModelVolumesDiskCache::Entry{ Area::ACCUMULATED_PLACEABLE_0, 0, layer_idx, &polygons });
+        }
+        disk_cache_->store(entries);
+    }
+
     const cura52::Polygons& TreeModelVolumesT::getCollision(cura52::coord_t radius, LayerIndex layer_idx, bool min_xy_dist)
     {
         const cura52::coord_t orig_radius = radius;
@@ -348,13 +494,17 @@ namespace cura54
         RadiusLayerPair key{ radius, layer_idx };
 
         {
-            std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_avoidance_cache_);
+            std::lock_guard<std::mutex> critical_section_support_max_layer_nr(*critical_collision_cache_);
             result = getArea(collision_cache_, key);
         }
         if (result)
         {
             return (*result).get();
         }
+        if (loadFromDiskCache(TreeModelVolumesDiskCache::Area::COLLISION, radius, layer_idx, collision_cache_, key, *critical_collision_cache_))
+        {
+            return getCollision(orig_radius, layer_idx, min_xy_dist);
+        }
         if (precalculated)
         {
             //spdlog::warn("Had to calculate collision at radius {} and layer {}, but precalculate was called. Performance may suffer!", key.first, key.second);
@@ -385,6 +535,10 @@ namespace cura54
         {
             return (*result).get();
         }
+        if (loadFromDiskCache(TreeModelVolumesDiskCache::Area::COLLISION_HOLEFREE, radius, layer_idx, collision_cache_holefree_, key, *critical_collision_cache_holefree_))
+        {
+            return getCollisionHolefree(orig_radius, layer_idx, min_xy_dist);
+        }
         if (precalculated)
         {
             // spdlog::warn("Had to calculate collision holefree at radius {} and layer {}, but precalculate was called. Performance may suffer!", key.first, key.second);
@@ -402,6 +556,10 @@ namespace cura54
                 return accumulated_placeables_cache_radius_0_[layer_idx];
             }
         }
+        if (loadFromDiskCache(TreeModelVolumesDiskCache::Area::ACCUMULATED_PLACEABLE_0, 0, layer_idx, accumulated_placeables_cache_radius_0_, layer_idx, *critical_accumulated_placeables_cache_radius_0_))
+        {
+            return getAccumulatedPlaceable0(layer_idx);
+        }
         calculateAccumulatedPlaceable0(layer_idx);
         return getAccumulatedPlaceable0(layer_idx);
     }
@@ -429,19 +587,23 @@ namespace cura54
 
         std::unordered_map<RadiusLayerPair, cura52::Polygons>* cache_ptr = nullptr;
         std::mutex* mutex_ptr = nullptr;
+        TreeModelVolumesDiskCache::Area disk_area = TreeModelVolumesDiskCache::Area::AVOIDANCE;
         switch (type)
         {
         case AvoidanceType::FAST:
             cache_ptr = to_model ? &avoidance_cache_to_model_ : &avoidance_cache_;
             mutex_ptr = to_model ? critical_avoidance_cache_to_model_.get() : critical_avoidance_cache_.get();
+            disk_area = to_model ? TreeModelVolumesDiskCache::Area::AVOIDANCE_TO_MODEL : TreeModelVolumesDiskCache::Area::AVOIDANCE;
             break;
         case AvoidanceType::SLOW:
             cache_ptr = to_model ? &avoidance_cache_to_model_slow_ : &avoidance_cache_slow_;
             mutex_ptr = to_model ? critical_avoidance_cache_to_model_slow_.get() : critical_avoidance_cache_slow_.get();
+            disk_area = to_model ? TreeModelVolumesDiskCache::Area::AVOIDANCE_TO_MODEL_SLOW : TreeModelVolumesDiskCache::Area::AVOIDANCE_SLOW;
             break;
         case AvoidanceType::FAST_SAFE:
             cache_ptr = to_model ? &avoidance_cache_hole_to_model_ : &avoidance_cache_hole_;
             mutex_ptr = to_model ? critical_avoidance_cache_holefree_to_model_.get() : critical_avoidance_cache_holefree_.get();
+            disk_area = to_model ? TreeModelVolumesDiskCache::Area::AVOIDANCE_HOLE_TO_MODEL : TreeModelVolumesDiskCache::Area::AVOIDANCE_HOLE;
             break;
         case AvoidanceType::COLLISION:
             if (layer_idx <= max_layer_idx_without_blocker)
@@ -452,6 +614,7 @@ namespace cura54
             {
                 cache_ptr = &avoidance_cache_collision_;
                 mutex_ptr = critical_avoidance_cache_collision_.get();
+                disk_area = TreeModelVolumesDiskCache::Area::AVOIDANCE_COLLISION;
             }
             break;
         default:
@@ -467,6 +630,10 @@ namespace cura54
         {
             return (*result).get();
         }
+        if (loadFromDiskCache(disk_area, radius, layer_idx, *cache_ptr, key, *mutex_ptr))
+        {
+            return getAvoidance(orig_radius, layer_idx, type, to_model, min_xy_dist);
+        }
         if (precalculated)
         {
             // spdlog::warn("Had to calculate Avoidance (to model-bool: {}) at radius {} and layer {} and type {}, but precalculate was called. Performance may suffer!", to_model, key.first, key.second, cura52::coord_t(type));
@@ -501,6 +668,10 @@ namespace cura54
         {
             return (*result).get();
         }
+        if (loadFromDiskCache(TreeModelVolumesDiskCache::Area::PLACEABLE, radius, layer_idx, placeable_areas_cache_, key, *critical_placeable_areas_cache_))
+        {
+            return getPlaceableAreas(orig_radius, layer_idx);
+        }
         if (precalculated)
         {
             //spdlog::warn("Had to calculate Placeable Areas at radius {} and layer {}, but precalculate was called. Performance may suffer!", radius, layer_idx);
@@ -541,6 +712,11 @@ namespace cura54
         {
             return (*result).get();
         }
+        const TreeModelVolumesDiskCache::Area disk_area = min_xy_dist ? TreeModelVolumesDiskCache::Area::WALL_RESTRICTION_MIN : TreeModelVolumesDiskCache::Area::WALL_RESTRICTION;
+        if (loadFromDiskCache(disk_area, radius, layer_idx, *cache_ptr, key, min_xy_dist ? *critical_wall_restrictions_cache_min_ : *critical_wall_restrictions_cache_))
+        {
+            return getWallRestriction(orig_radius, layer_idx, min_xy_dist);
+        }
         if (precalculated)
         {
             // spdlog::warn("Had to calculate Wall restrictions at radius {} and layer {}, but precalculate was called. Performance may suffer!", key.first, key.second);
@@ -10,8 +10,10 @@
 #include "progress/Progress.h"
 #include "settings/EnumSettings.h"
 #include "support.h" //For precomputeCrossInfillTree
+#include "utils/AABBGrid.h"
 #include "utils/Simplify.h"
 #include "utils/ThreadPool.h"
+#include "utils/UnionFind.h"
 #include "utils/algorithm.h"
 #include "utils/math.h" //For round_up_divide and PI.
 #include "utils/polygonUtils.h" //For moveInside.
@@ -20,6 +22,7 @@
 #include "TreeSupportUtils.h"
 
 #include <chrono>
+#include <deque>
 #include <fstream>
 #include <optional>
 
@@ -304,251 +307,268 @@ void TreeSupportT::generateInitialAreas(const cura52::SliceMeshStorage& mesh, st
 
 void TreeSupportT::mergeHelper
 (
-    std::map<TreeSupportElementT, cura52::AABB>& reduced_aabb,
-    std::map<TreeSupportElementT, cura52::AABB>& input_aabb,
+    const std::vector<const TreeSupportElementT*>& cluster,
+    const std::vector<cura52::AABB>& cluster_aabb,
+    const std::vector<bool>& cluster_unchanged,
     const PropertyAreasUnordered& to_bp_areas,
     const PropertyAreas& to_model_areas,
     const PropertyAreas& influence_areas,
     PropertyAreasUnordered& insert_bp_areas,
     PropertyAreasUnordered& insert_model_areas,
     PropertyAreasUnordered& insert_influence,
+    std::unordered_map<TreeSupportElementT, cura52::AABB>& insert_aabb,
     std::vector<TreeSupportElementT>& erase, const LayerIndex layer_idx
 )
 {
-    const bool first_merge_iteration = reduced_aabb.empty(); // If this is the first iteration, all elements in input have to be merged with each other
     const std::function<coord_t(size_t, double)> getRadiusFunction =
         [&](const size_t distance_to_top, const double buildplate_radius_increases) { return config.getRadius(distance_to_top, buildplate_radius_increases); };
-    for (auto& influence : input_aabb)
+
+    // The elements which are processed already, by their index in the grid. Elements created by a merge are kept in merged_elements.
+    std::vector<const TreeSupportElementT*> reduced;
+    std::vector<bool> reduced_unchanged;
+    std::deque<TreeSupportElementT> merged_elements;
+    cura52::AABBGrid reduced_grid(cura52::AABBGrid::getCellSize(cluster_aabb));
+    reduced.reserve(cluster.size());
+    reduced_unchanged.reserve(cluster.size());
+
+    for (size_t cluster_idx = 0; cluster_idx < cluster.size(); cluster_idx++)
     {
+        const TreeSupportElementT& influence = *cluster[cluster_idx];
+        const cura52::AABB& influence_aabb = cluster_aabb[cluster_idx];
         bool merged = false;
-        cura52::AABB influence_aabb = influence.second;
-        for (const auto& reduced_check : reduced_aabb)
+        // As every area has to be checked for overlaps with other areas, some fast heuristic is needed to abort early if clearly possible.
+        // The grid only gives the processed elements whose AABB hits this one.
+        for (const size_t reduced_idx : reduced_grid.getHits(influence_aabb))
         {
-            // As every area has to be checked for overlaps with other areas, some fast heuristic is needed to abort early if clearly possible
-            // This is so performance critical that using a map lookup instead of the direct access of the cached AABBs can have a surprisingly large performance impact
-            cura52::AABB aabb = reduced_check.second;
-            if (aabb.hit(influence_aabb))
-            {
-                if (!first_merge_iteration && input_aabb.count(reduced_check.first))
+            if (cluster_unchanged[cluster_idx] && reduced_unchanged[reduced_idx])
+            {
+                continue; // Both were tried in an earlier round, and not merged then.
+            }
+            const TreeSupportElementT& reduced_elem = *reduced[reduced_idx];
+            const bool merging_gracious_and_non_gracious = reduced_elem.to_model_gracious != influence.to_model_gracious;
+            // ^^^ We do not want to merge a gracious with a non gracious area as bad placement could negatively impact the dependability of the whole subtree.
+            const bool merging_to_bp = reduced_elem.to_buildplate && influence.to_buildplate;
+            const bool merging_min_and_regular_xy = reduced_elem.use_min_xy_dist != influence.use_min_xy_dist;
+            // ^^^ Could cause some issues with the increase of one area, as it is assumed that if the smaller is increased by the delta to the larger it is engulfed by it already.
+            //     But because a different collision may be removed from the in drawArea generated circles, this assumption could be wrong.
+            const bool merging_different_range_limits =
+                reduced_elem.influence_area_limit_active && influence.influence_area_limit_active && influence.influence_area_limit_range != reduced_elem.influence_area_limit_range;
+            coord_t increased_to_model_radius = 0;
+            size_t larger_to_model_dtt = 0;
+
+            if (!merging_to_bp)
+            {
+                const coord_t infl_radius = config.getRadius(influence); // Get the real radius increase as the user does not care for the collision model.
+                const coord_t redu_radius = config.getRadius(reduced_elem);
+                if (reduced_elem.to_buildplate != influence.to_buildplate)
                 {
-                    break; // Do not try to merge elements that already should have been merged. Done for potential performance improvement.
-                }
-
-                const bool merging_gracious_and_non_gracious = reduced_check.first.to_model_gracious != influence.first.to_model_gracious;
-                // ^^^ We do not want to merge a gracious with a non gracious area as bad placement could negatively impact the dependability of the whole subtree.
-                const bool merging_to_bp = reduced_check.first.to_buildplate && influence.first.to_buildplate;
-                const bool merging_min_and_regular_xy = reduced_check.first.use_min_xy_dist != influence.first.use_min_xy_dist;
-                // ^^^ Could cause some issues with the increase of one area, as it is assumed that if the smaller is increased by the delta to the larger it is engulfed by it already.
-                //     But because a different collision may be removed from the in drawArea generated circles, this assumption could be wrong.
-                const bool merging_different_range_limits =
-                    reduced_check.first.influence_area_limit_active && influence.first.influence_area_limit_active && influence.first.influence_area_limit_range != reduced_check.first.influence_area_limit_range;
-                coord_t increased_to_model_radius = 0;
-                size_t larger_to_model_dtt = 0;
-
-                if (!merging_to_bp)
-                {
-                    const coord_t infl_radius = config.getRadius(influence.first); // Get the real radius increase as the user does not care for the collision model.
-                    const coord_t redu_radius = config.getRadius(reduced_check.first);
-                    if (reduced_check.first.to_buildplate != influence.first.to_buildplate)
+                    if (reduced_elem.to_buildplate)
                     {
-                        if (reduced_check.first.to_buildplate)
+                        if (infl_radius < redu_radius)
                         {
-                            if (infl_radius < redu_radius)
-                            {
-                                increased_to_model_radius = influence.first.increased_to_model_radius + redu_radius - infl_radius;
-                            }
+                            increased_to_model_radius = influence.increased_to_model_radius + redu_radius - infl_radius;
                         }
-                        else
+                    }
+                    else
+                    {
+                        if (infl_radius > redu_radius)
                         {
-                            if (infl_radius > redu_radius)
-                            {
-                                increased_to_model_radius = reduced_check.first.increased_to_model_radius + infl_radius - redu_radius;
-                            }
+                            increased_to_model_radius = reduced_elem.increased_to_model_radius + infl_radius - redu_radius;
                         }
                     }
-                    larger_to_model_dtt = std::max(influence.first.distance_to_top, reduced_check.first.distance_to_top);
-                }
-
-                // If a merge could place a stable branch on unstable ground, would be increasing the radius further than allowed to when merging to model and to_bp trees or
-                //   would merge to model before it is known they will even been drawn the merge is skipped
-                if
-                (
-                    merging_min_and_regular_xy ||
-                    merging_gracious_and_non_gracious ||
-                    increased_to_model_radius > config.max_to_model_radius_increase ||
-                    (!merging_to_bp && larger_to_model_dtt < config.min_dtt_to_model && !reduced_check.first.supports_roof && !influence.first.supports_roof) ||
-                    merging_different_range_limits
-                )
-                {
-                    continue;
-                }
-
-                cura52::Polygons relevant_infl;
-                cura52::Polygons relevant_redu;
-                if (merging_to_bp)
-                {
-                    relevant_infl = to_bp_areas.count(influence.first) ? to_bp_areas.at(influence.first) : cura52::Polygons(); // influence.first is a new element => not required to check if it was changed
-                    relevant_redu =
-                        insert_bp_areas.count
-                        (
-                            reduced_check.first) ?
-                            insert_bp_areas[reduced_check.first] :
-                            (to_bp_areas.count(reduced_check.first) ? to_bp_areas.at(reduced_check.first) : Polygons()
-                        );
-                }
-                else
-                {
-                    relevant_infl = to_model_areas.count(influence.first) ? to_model_areas.at(influence.first) : cura52::Polygons();
-                    relevant_redu =
-                        insert_model_areas.count
-                        (
-                            reduced_check.first) ?
-                            insert_model_areas[reduced_check.first] :
-                            (to_model_areas.count(reduced_check.first) ? to_model_areas.at(reduced_check.first) : Polygons()
-                        );
                 }
+                larger_to_model_dtt = std::max(influence.distance_to_top, reduced_elem.distance_to_top);
+            }
 
-                const bool red_bigger = config.getCollisionRadius(reduced_check.first) > config.getCollisionRadius(influence.first);
-                std::pair<TreeSupportElementT, cura52::Polygons> smaller_rad =
-                    red_bigger ?
-                    std::pair<TreeSupportElementT, cura52::Polygons>(influence.first, relevant_infl) :
-                    std::pair<TreeSupportElementT, cura52::Polygons>(reduced_check.first, relevant_redu);
-                std::pair<TreeSupportElementT, Polygons> bigger_rad =
-                    red_bigger ?
-                    std::pair<TreeSupportElementT, cura52::Polygons>(reduced_check.first, relevant_redu) :
-                    std::pair<TreeSupportElementT, cura52::Polygons>(influence.first, relevant_infl);
-                const coord_t real_radius_delta = std::abs(config.getRadius(bigger_rad.first) - config.getRadius(smaller_rad.first));
-                const coord_t smaller_collision_radius = config.getCollisionRadius(smaller_rad.first);
-
-                // the area of the bigger radius is used to ensure correct placement regarding the relevant avoidance, so if that would change an invalid area may be created
-                if (!bigger_rad.first.can_use_safe_radius && smaller_rad.first.can_use_safe_radius)
-                {
-                    continue;
-                }
+            // If a merge could place a stable branch on unstable ground, would be increasing the radius further than allowed to when merging to model and to_bp trees or
+            //   would merge to model before it is known they will even been drawn the merge is skipped
+            if
+            (
+                merging_min_and_regular_xy ||
+                merging_gracious_and_non_gracious ||
+                increased_to_model_radius > config.max_to_model_radius_increase ||
+                (!merging_to_bp && larger_to_model_dtt < config.min_dtt_to_model && !reduced_elem.supports_roof && !influence.supports_roof) ||
+                merging_different_range_limits
+            )
+            {
+                continue;
+            }
 
-                // The bigger radius is used to verify that the area is still valid after the increase with the delta.
-                // If there were a point where the big influence area could be valid with can_use_safe_radius the element would already be can_use_safe_radius.
-                // The smaller radius, which gets increased by delta may reach into the area where use_min_xy_dist is no longer required.
-                bool use_min_radius = bigger_rad.first.use_min_xy_dist && smaller_rad.first.use_min_xy_dist;
-
-                // The idea is that the influence area with the smaller collision radius is increased by the radius difference.
-                // If this area has any intersections with the influence area of the larger collision radius,
-                //   a branch (of the larger collision radius) placed in this intersection, has already engulfed the branch of the smaller collision radius.
-                // Because of this a merge may happen even if the influence areas (that represent possible center points of branches) do not intersect yet.
-                // Remember that collision radius <= real radius as otherwise this assumption would be false.
-                const cura52::Polygons small_rad_increased_by_big_minus_small =
-                    TreeSupportUtils::safeOffsetInc
+            cura52::Polygons relevant_infl;
+            cura52::Polygons relevant_redu;
+            if (merging_to_bp)
+            {
+                relevant_infl = to_bp_areas.count(influence) ? to_bp_areas.at(influence) : cura52::Polygons(); // influence is a new element => not required to check if it was changed
+                relevant_redu =
+                    insert_bp_areas.count
                     (
-                        smaller_rad.second,
-                        real_radius_delta, volumes_.getCollision(smaller_collision_radius, layer_idx - 1, use_min_radius),
-                        2 * (config.xy_distance + smaller_collision_radius - EPSILON), // Epsilon avoids possible rounding errors
-                        0,
-                        0,
-                        config.support_line_distance / 2,
-                        &config.simplifier
+                        reduced_elem) ?
+                        insert_bp_areas[reduced_elem] :
+                        (to_bp_areas.count(reduced_elem) ? to_bp_areas.at(reduced_elem) : Polygons()
                     );
-                cura52::Polygons intersect = small_rad_increased_by_big_minus_small.intersection(bigger_rad.second);
+            }
+            else
+            {
+                relevant_infl = to_model_areas.count(influence) ? to_model_areas.at(influence) : cura52::Polygons();
+                relevant_redu =
+                    insert_model_areas.count
+                    (
+                        reduced_elem) ?
+                        insert_model_areas[reduced_elem] :
+                        (to_model_areas.count(reduced_elem) ? to_model_areas.at(reduced_elem) : Polygons()
+                    );
+            }
 
-                if (intersect.area() > 1) // dont use empty as a line is not empty, but for this use-case it very well may be (and would be one layer down as union does not keep lines)
-                {
-                    // Check if the overlap is large enough (Small ares tend to attract rounding errors in clipper). While 25 was guessed as enough, i did not have reason to change it.
-                    if (intersect.offset(-FUDGE_LENGTH/2).area() <= 1)
-                    {
-                        continue;
-                    }
+            const bool red_bigger = config.getCollisionRadius(reduced_elem) > config.getCollisionRadius(influence);
+            std::pair<TreeSupportElementT, cura52::Polygons> smaller_rad =
+                red_bigger ?
+                std::pair<TreeSupportElementT, cura52::Polygons>(influence, relevant_infl) :
+                std::pair<TreeSupportElementT, cura52::Polygons>(reduced_elem, relevant_redu);
+            std::pair<TreeSupportElementT, Polygons> bigger_rad =
+                red_bigger ?
+                std::pair<TreeSupportElementT, cura52::Polygons>(reduced_elem, relevant_redu) :
+                std::pair<TreeSupportElementT, cura52::Polygons>(influence, relevant_infl);
+            const coord_t real_radius_delta = std::abs(config.getRadius(bigger_rad.first) - config.getRadius(smaller_rad.first));
+            const coord_t smaller_collision_radius = config.getCollisionRadius(smaller_rad.first);
 
-                    // Do the actual merge now that the branches are confirmed to be able to intersect.
+            // the area of the bigger radius is used to ensure correct placement regarding the relevant avoidance, so if that would change an invalid area may be created
+            if (!bigger_rad.first.can_use_safe_radius && smaller_rad.first.can_use_safe_radius)
+            {
+                continue;
+            }
 
-                    // Calculate which point is closest to the point of the last merge (or tip center if no merge above it has happened)
-                    // Used at the end to estimate where to best place the branch on the bottom most layer
-                    // Could be replaced with a random point inside the new area
-                    cura52::Point new_pos = reduced_check.first.next_position;
-                    if (! intersect.inside(new_pos, true))
-                    {
-                       cura52:: PolygonUtils::moveInside(intersect, new_pos);
-                    }
+            // The bigger radius is used to verify that the area is still valid after the increase with the delta.
+            // If there were a point where the big influence area could be valid with can_use_safe_radius the element would already be can_use_safe_radius.
+            // The smaller radius, which gets increased by delta may reach into the area where use_min_xy_dist is no longer required.
+            bool use_min_radius = bigger_rad.first.use_min_xy_dist && smaller_rad.first.use_min_xy_dist;
 
-                    if (increased_to_model_radius == 0)
-                    {
-                        increased_to_model_radius = std::max(reduced_check.first.increased_to_model_radius, influence.first.increased_to_model_radius);
-                    }
+            // The idea is that the influence area with the smaller collision radius is increased by the radius difference.
+            // If this area has any intersections with the influence area of the larger collision radius,
+            //   a branch (of the larger collision radius) placed in this intersection, has already engulfed the branch of the smaller collision radius.
+            // Because of this a merge may happen even if the influence areas (that represent possible center points of branches) do not intersect yet.
+            // Remember that collision radius <= real radius as otherwise this assumption would be false.
+            const cura52::Polygons small_rad_increased_by_big_minus_small =
+                TreeSupportUtils::safeOffsetInc
+                (
+                    smaller_rad.second,
+                    real_radius_delta, volumes_.getCollision(smaller_collision_radius, layer_idx - 1, use_min_radius),
+                    2 * (config.xy_distance + smaller_collision_radius - EPSILON), // Epsilon avoids possible rounding errors
+                    0,
+                    0,
+                    config.support_line_distance / 2,
+                    &config.simplifier
+                );
+            cura52::Polygons intersect = small_rad_increased_by_big_minus_small.intersection(bigger_rad.second);
 
-                    const TreeSupportElementT key
-                    (
-                        reduced_check.first,
-                        influence.first,
-                        layer_idx - 1,
-                        new_pos,
-                        increased_to_model_radius,
-                        getRadiusFunction,
-                        config.diameter_scale_bp_radius,
-                        config.branch_radius,
-                        config.diameter_angle_scale_factor
-                    );
+            if (intersect.area() > 1) // dont use empty as a line is not empty, but for this use-case it very well may be (and would be one layer down as union does not keep lines)
+            {
+                // Check if the overlap is large enough (Small ares tend to attract rounding errors in clipper). While 25 was guessed as enough, i did not have reason to change it.
+                if (intersect.offset(-FUDGE_LENGTH/2).area() <= 1)
+                {
+                    continue;
+                }
 
-                    const auto getIntersectInfluence =
-                        [&] (const PropertyAreasUnordered& insert_infl, const PropertyAreas& infl_areas)
-                        {
-                            const cura52::Polygons infl_small = insert_infl.count(smaller_rad.first) ? insert_infl.at(smaller_rad.first) : (infl_areas.count(smaller_rad.first) ? infl_areas.at(smaller_rad.first) : Polygons());
-                            const cura52::Polygons infl_big = insert_infl.count(bigger_rad.first) ? insert_infl.at(bigger_rad.first) : (infl_areas.count(bigger_rad.first) ? infl_areas.at(bigger_rad.first) : Polygons());
-                            const cura52::Polygons small_rad_increased_by_big_minus_small_infl =
-                                cura54::TreeSupportUtils::safeOffsetInc
-                                (
-                                    infl_small,
-                                    real_radius_delta,
-                                    volumes_.getCollision(smaller_collision_radius, layer_idx - 1, use_min_radius),
-                                    2 * (config.xy_distance + smaller_collision_radius - EPSILON),
-                                    0,
-                                    0,
-                                    config.support_line_distance / 2,
-                                    &config.simplifier
-                                );
-                            return small_rad_increased_by_big_minus_small_infl.intersection(infl_big); // If the one with the bigger radius with the lower radius removed overlaps we can merge.
-                        };
+                // Do the actual merge now that the branches are confirmed to be able to intersect.
 
-                    cura52::Polygons intersect_influence;
-                    intersect_influence = TreeSupportUtils::safeUnion(intersect, getIntersectInfluence(insert_influence, influence_areas)); // Rounding errors again. Do not ask me where or why.
+                // Calculate which point is closest to the point of the last merge (or tip center if no merge above it has happened)
+                // Used at the end to estimate where to best place the branch on the bottom most layer
+                // Could be replaced with a random point inside the new area
+                cura52::Point new_pos = reduced_elem.next_position;
+                if (! intersect.inside(new_pos, true))
+                {
+                   cura52:: PolygonUtils::moveInside(intersect, new_pos);
+                }
 
-                    cura52::Polygons intersect_to_model;
-                    if (merging_to_bp && config.support_rests_on_model)
-                    {
-                        intersect_to_model = getIntersectInfluence(insert_model_areas, to_model_areas);
-                        intersect_influence = TreeSupportUtils::safeUnion(intersect_influence, intersect_to_model); // Still rounding errors.
-                    }
+                if (increased_to_model_radius == 0)
+                {
+                    increased_to_model_radius = std::max(reduced_elem.increased_to_model_radius, influence.increased_to_model_radius);
+                }
 
-                    // Remove the now merged elements from all buckets, as they do not exist anymore in their old form.
-                    insert_bp_areas.erase(reduced_check.first);
-                    insert_bp_areas.erase(influence.first);
-                    insert_model_areas.erase(reduced_check.first);
-                    insert_model_areas.erase(influence.first);
-                    insert_influence.erase(reduced_check.first);
-                    insert_influence.erase(influence.first);
+                const TreeSupportElementT key
+                (
+                    reduced_elem,
+                    influence,
+                    layer_idx - 1,
+                    new_pos,
+                    increased_to_model_radius,
+                    getRadiusFunction,
+                    config.diameter_scale_bp_radius,
+                    config.branch_radius,
+                    config.diameter_angle_scale_factor
+                );
 
-                    (merging_to_bp ? insert_bp_areas : insert_model_areas).emplace(key, intersect);
-                    if (merging_to_bp && config.support_rests_on_model)
+                const auto getIntersectInfluence =
+                    [&] (const PropertyAreasUnordered& insert_infl, const PropertyAreas& infl_areas)
                     {
-                        insert_model_areas.emplace(key, intersect_to_model);
-                    }
-                    insert_influence.emplace(key, intersect_influence);
+                        const cura52::Polygons infl_small = insert_infl.count(smaller_rad.first) ? insert_infl.at(smaller_rad.first) : (infl_areas.count(smaller_rad.first) ? infl_areas.at(smaller_rad.first) : Polygons());
+                        const cura52::Polygons infl_big = insert_infl.count(bigger_rad.first) ? insert_infl.at(bigger_rad.first) : (infl_areas.count(bigger_rad.first) ? infl_areas.at(bigger_rad.first) : Polygons());
+                        const cura52::Polygons small_rad_increased_by_big_minus_small_infl =
+                            cura54::TreeSupportUtils::safeOffsetInc
+                            (
+                                infl_small,
+                                real_radius_delta,
+                                volumes_.getCollision(smaller_collision_radius, layer_idx - 1, use_min_radius),
+                                2 * (config.xy_distance + smaller_collision_radius - EPSILON),
+                                0,
+                                0,
+                                config.support_line_distance / 2,
+                                &config.simplifier
+                            );
+                        return small_rad_increased_by_big_minus_small_infl.intersection(infl_big); // If the one with the bigger radius with the lower radius removed overlaps we can merge.
+                    };
 
-                    erase.emplace_back(reduced_check.first);
-                    erase.emplace_back(influence.first);
-                    const cura52::Polygons merge = intersect.unionPolygons(intersect_to_model).offset(config.getRadius(key), ClipperLib::jtRound).difference(volumes_.getCollision(0, layer_idx - 1));
-                    // ^^^ Regular union should be preferable here as Polygons tend to only become smaller through rounding errors (smaller!=has smaller area as holes have a negative area.).
-                    //     And if this area disappears because of rounding errors, the only downside is that it can not merge again on this layer.
+                cura52::Polygons intersect_influence;
+                intersect_influence = TreeSupportUtils::safeUnion(intersect, getIntersectInfluence(insert_influence, influence_areas)); // Rounding errors again. Do not ask me where or why.
 
-                    reduced_aabb.erase(reduced_check.first); // This invalidates reduced_check.
-                    reduced_aabb.emplace(key, cura52::AABB(merge));
+                cura52::Polygons intersect_to_model;
+                if (merging_to_bp && config.support_rests_on_model)
+                {
+                    intersect_to_model = getIntersectInfluence(insert_model_areas, to_model_areas);
+                    intersect_influence = TreeSupportUtils::safeUnion(intersect_influence, intersect_to_model); // Still rounding errors.
+                }
 
-                    merged = true;
-                    break;
+                // Remove the now merged elements from all buckets, as they do not exist anymore in their old form.
+                insert_bp_areas.erase(reduced_elem);
+                insert_bp_areas.erase(influence);
+                insert_model_areas.erase(reduced_elem);
+                insert_model_areas.erase(influence);
+                insert_influence.erase(reduced_elem);
+                insert_influence.erase(influence);
+
+                (merging_to_bp ? insert_bp_areas : insert_model_areas).emplace(key, intersect);
+                if (merging_to_bp && config.support_rests_on_model)
+                {
+                    insert_model_areas.emplace(key, intersect_to_model);
                 }
+                insert_influence.emplace(key, intersect_influence);
+
+                erase.emplace_back(reduced_elem);
+                erase.emplace_back(influence);
+                const cura52::Polygons merge = intersect.unionPolygons(intersect_to_model).offset(config.getRadius(key), ClipperLib::jtRound).difference(volumes_.getCollision(0, layer_idx - 1));
+                // ^^^ Regular union should be preferable here as Polygons tend to only become smaller through rounding errors (smaller!=has smaller area as holes have a negative area.).
+                //     And if this area disappears because of rounding errors, the only downside is that it can not merge again on this layer.
+
+                const cura52::AABB merge_aabb(merge);
+                insert_aabb.erase(reduced_elem);
+                insert_aabb.erase(influence);
+                insert_aabb.emplace(key, merge_aabb);
+
+                reduced_grid.remove(reduced_idx);
+                merged_elements.push_back(key);
+                reduced.push_back(&merged_elements.back());
+                reduced_unchanged.push_back(false);
+                reduced_grid.insert(reduced.size() - 1, merge_aabb);
+
+                merged = true;
+                break;
             }
         }
 
         if (! merged)
         {
-            reduced_aabb[influence.first] = influence_aabb;
+            reduced.push_back(&influence);
+            reduced_unchanged.push_back(cluster_unchanged[cluster_idx]);
+            reduced_grid.insert(reduced.size() - 1, influence_aabb);
         }
     }
 }
@@ -562,108 +582,154 @@ void TreeSupportT::mergeInfluenceAreas
 )
 {
     /*
-     * Idea behind this is that the calculation of merges can be accelerated a bit using divide and conquer:
-     * If two groups of areas are already merged, only all elements in group 2 have to be merged into group one.
-     * This can only accelerate by factor 2 (as half the work is merging the last two groups).
-     * The actual merge logic is found in mergeHelper. This function only manages parallelization of different mergeHelper calls.
+     * Two areas can only be merged if their AABBs hit. The AABBs are put on a grid to find the pairs which hit, and the areas are grouped into
+     * clusters of areas which hit each other, directly or through other areas of the cluster. Clusters can't merge with each other, so they are
+     * merged in parallel. The actual merge logic is found in mergeHelper.
+     * A merged area can hit an area of another cluster, so this is repeated with the merged areas until nothing merges anymore. Areas which were
+     * not merged have been tried against each other already, so only pairs with a merged area are tried again.
      */
-
-    const size_t input_size = influence_areas.size();
-    size_t num_threads = std::max(size_t(1), size_t(std::thread::hardware_concurrency())); // For some reason hardware concurrency can return 0;
-
-    if (input_size == 0)
+    if (influence_areas.empty())
     {
         return;
     }
-    constexpr int min_elements_per_bucket = 2;
-
-    // max_bucket_count is input_size/min_elements_per_bucket round down to the next 2^n.
-    // The rounding to 2^n is to ensure improved performance, as every iteration two buckets will be merged, halving the amount of buckets.
-    // If halving would cause an uneven count, e.g. 3 Then bucket 0 and 1 would have to be merged, and in the next iteration the last remaining buckets. This is assumed to not be optimal performance-wise.
-    const size_t max_bucket_count = std::pow(2, std::floor(std::log(cura52::round_up_divide(input_size, min_elements_per_bucket))));
-    int bucket_count = std::min(max_bucket_count, num_threads); // do not use more buckets than available threads.
 
-    // To achieve that every element in a bucket is already correctly merged with other elements in this bucket
-    // an extra empty bucket is created for each bucket, and the elements are merged into the empty one.
-    // Each thread will then process two buckets by merging all elements in the second bucket into the first one as mergeHelper will disable not trying to merge elements from the same bucket in this case.
-    std::vector<PropertyAreas> buckets_area(2 * bucket_count);
-    std::vector<std::map<TreeSupportElementT, cura52::AABB>> buckets_aabb(2 * bucket_count);
-
-
-    size_t position = 0, counter = 0;
-    const size_t over_elements = input_size % bucket_count;
-    const size_t elements_per_step = input_size / bucket_count;
-
-    // Dplit the data in x parts to be able to divide and conquer.
-    // The first "over_elements" of buckets gets elements_per_step+1 elements
-    for (const auto& influence_area : influence_areas)
+    // The elements are referred to by their index in these. They point to the keys of influence_areas, which stay valid until the end of a round.
+    std::vector<const TreeSupportElementT*> elements;
+    std::vector<cura52::AABB> elements_aabb;
+    std::vector<bool> elements_unchanged; // Whether the element was tried against all other unchanged elements already.
+    elements.reserve(influence_areas.size());
+    for (const std::pair<const TreeSupportElementT, cura52::Polygons>& influence_area : influence_areas)
     {
-        buckets_area[position * 2 + 1].emplace(influence_area.first, influence_area.second);
-        // ^^^ Only use every second bucket beginning with 1 as this makes the parallel call later easier as we assume everything in a bucket i%2==0 is already processed.
-        counter++;
-        if ((counter == elements_per_step && position >= over_elements) || counter > elements_per_step)
-        {
-            position++;
-            counter = 0;
-        }
+        elements.push_back(&influence_area.first);
     }
+    elements_aabb.resize(elements.size());
+    elements_unchanged.resize(elements.size(), false);
+
     // Precalculate the AABBs from the influence areas.
     cura52::parallel_for<size_t>
     (   application,
         0,
-        buckets_area.size() / 2,
-        [&](size_t idx) // +=2 as in the beginning only uneven buckets will be filled
+        elements.size(),
+        [&](size_t idx)
         {
-            idx = idx * 2 + 1; // this is eqivalent to a parallel for(size_t idx=1;idx<buckets_area.size(),idx+=2)
-            for (const std::pair<TreeSupportElementT, Polygons>& input_pair : buckets_area[idx])
-            {
-                cura52::AABB outer_support_wall_aabb = cura52::AABB(input_pair.second);
-                outer_support_wall_aabb.expand(config.getRadius(input_pair.first));
-                buckets_aabb[idx].emplace(input_pair.first, outer_support_wall_aabb);
-            }
+            cura52::AABB outer_support_wall_aabb = cura52::AABB(influence_areas.at(*elements[idx]));
+            outer_support_wall_aabb.expand(config.getRadius(*elements[idx]));
+            elements_aabb[idx] = outer_support_wall_aabb;
         }
     );
 
-    while (buckets_area.size() > 1)
+    while (true)
     {
-        // Some temporary storage, of elements that have to be inserted or removed from the background storage. Only one per two buckets required
-        std::vector<PropertyAreasUnordered> insert_main(buckets_area.size() / 2);
-        std::vector<PropertyAreasUnordered> insert_secondary(buckets_area.size() / 2);
-        std::vector<PropertyAreasUnordered> insert_influence(buckets_area.size() / 2);
-        std::vector<std::vector<TreeSupportElementT>> erase(buckets_area.size() / 2);
+        cura52::AABBGrid grid(cura52::AABBGrid::getCellSize(elements_aabb));
+        cura52::UnionFind<size_t> clustering;
+        for (size_t idx = 0; idx < elements.size(); idx++)
+        {
+            grid.insert(idx, elements_aabb[idx]);
+            clustering.add(idx);
+        }
+        for (const std::pair<size_t, size_t>& hit : grid.getHittingPairs())
+        {
+            if (elements_unchanged[hit.first] && elements_unchanged[hit.second])
+            {
+                continue;
+            }
+            const size_t first_root = clustering.findByHandle(hit.first);
+            const size_t second_root = clustering.findByHandle(hit.second);
+            if (first_root != second_root)
+            {
+                clustering.unite(first_root, second_root);
+            }
+        }
 
-        cura52::parallel_for<size_t>
-        ( application,
-            0,
-            (coord_t)buckets_area.size() / 2,
-            [&](size_t bucket_pair_idx)
+        // The clusters in which something can merge, each in the order of the elements.
+        std::vector<std::vector<size_t>> clusters;
+        {
+            std::vector<std::vector<size_t>> clusters_by_root(elements.size());
+            for (size_t idx = 0; idx < elements.size(); idx++)
             {
-                bucket_pair_idx *= 2; // this is eqivalent to a parallel for(size_t idx=0;idx<buckets_area.size()-1,idx+=2)
-                // Merge bucket_count adjacent to each other, merging uneven bucket numbers into even buckets
+                clusters_by_root[clustering.findByHandle(idx)].push_back(idx);
+            }
+            for (std::vector<size_t>& cluster : clusters_by_root)
+            {
+                if (cluster.size() > 1)
+                {
+                    clusters.push_back(std::move(cluster));
+                }
+            }
+        }
+        if (clusters.empty())
+        {
+            break;
+        }
+
+        // Some temporary storage, of elements that have to be inserted or removed from the background storage. One per cluster.
+        std::vector<PropertyAreasUnordered> insert_main(clusters.size());
+        std::vector<PropertyAreasUnordered> insert_secondary(clusters.size());
+        std::vector<PropertyAreasUnordered> insert_influence(clusters.size());
+        std::vector<std::unordered_map<TreeSupportElementT, cura52::AABB>> insert_aabb(clusters.size());
+        std::vector<std::vector<TreeSupportElementT>> erase(clusters.size());
+
+        // Every element of a cluster is checked against the ones before it, so a cluster costs about its size squared.
+        std::vector<double> cluster_costs;
+        cluster_costs.reserve(clusters.size());
+        for (const std::vector<size_t>& cluster : clusters)
+        {
+            cluster_costs.push_back(static_cast<double>(cluster.size()) * cluster.size());
+        }
+
+        cura52::parallel_for_weighted<size_t>
+        (   application,
+            0,
+            clusters.size(),
+            cluster_costs,
+            [&](size_t cluster_idx)
+            {
+                const std::vector<size_t>& cluster = clusters[cluster_idx];
+                std::vector<const TreeSupportElementT*> cluster_elements;
+                std::vector<cura52::AABB> cluster_aabb;
+                std::vector<bool> cluster_unchanged;
+                for (const size_t idx : cluster)
+                {
+                    cluster_elements.push_back(elements[idx]);
+                    cluster_aabb.push_back(elements_aabb[idx]);
+                    cluster_unchanged.push_back(elements_unchanged[idx]);
+                }
                 mergeHelper
                 (
-                    buckets_aabb[bucket_pair_idx],
-                    buckets_aabb[bucket_pair_idx + 1],
+                    cluster_elements,
+                    cluster_aabb,
+                    cluster_unchanged,
                     to_bp_areas,
                     to_model_areas,
                     influence_areas,
-                    insert_main[bucket_pair_idx / 2],
-                    insert_secondary[bucket_pair_idx / 2],
-                    insert_influence[bucket_pair_idx / 2],
-                    erase[bucket_pair_idx / 2],
+                    insert_main[cluster_idx],
+                    insert_secondary[cluster_idx],
+                    insert_influence[cluster_idx],
+                    insert_aabb[cluster_idx],
+                    erase[cluster_idx],
                     layer_idx
                 );
-                buckets_area[bucket_pair_idx + 1].clear(); // clear now irrelevant max_bucket_count, and delete them later
-                buckets_aabb[bucket_pair_idx + 1].clear();
             }
         );
 
-        // Note the division in the limit of the loop!
-        //for (const coord_t i : ranges::views::iota(0UL, buckets_area.size() / 2))
-        for ( coord_t i  = 0; i<buckets_area.size() / 2; i++)
+        // Remember the AABBs of the elements which stay, by the key they have in influence_areas, before any key is erased.
+        std::unordered_map<const TreeSupportElementT*, cura52::AABB> unchanged_aabb;
+        for (size_t idx = 0; idx < elements.size(); idx++)
         {
+            unchanged_aabb.emplace(elements[idx], elements_aabb[idx]);
+        }
+
+        bool any_merged = false;
+        for (size_t i = 0; i < clusters.size(); i++)
+        {
+            any_merged |= ! erase[i].empty();
             for (TreeSupportElementT& del : erase[i])
             {
+                const auto influence_area = influence_areas.find(del);
+                if (influence_area != influence_areas.end())
+                {
+                    unchanged_aabb.erase(&influence_area->first);
+                }
                 to_bp_areas.erase(del);
                 to_model_areas.erase(del);
                 influence_areas.erase(del);
@@ -683,12 +749,37 @@ void TreeSupportT::mergeInfluenceAreas
                 influence_areas.emplace(tup);
             }
         }
+        if (! any_merged)
+        {
+            break;
+        }
 
-        const auto position_rem = std::remove_if(buckets_area.begin(), buckets_area.end(), [&](const PropertyAreas x) mutable { return x.empty(); });
-        buckets_area.erase(position_rem, buckets_area.end());
-
-        const auto position_aabb = std::remove_if(buckets_aabb.begin(), buckets_aabb.end(), [&](const std::map<TreeSupportElementT, cura52::AABB> x) mutable { return x.empty(); });
-        buckets_aabb.erase(position_aabb, buckets_aabb.end());
+        // The next round: the elements which weren't merged keep their AABB, the merged ones get the AABB of their merged area.
+        elements.clear();
+        elements_aabb.clear();
+        elements_unchanged.clear();
+        for (const std::pair<const TreeSupportElementT, cura52::Polygons>& influence_area : influence_areas)
+        {
+            const auto unchanged = unchanged_aabb.find(&influence_area.first);
+            if (unchanged != unchanged_aabb.end())
+            {
+                elements.push_back(&influence_area.first);
+                elements_aabb.push_back(unchanged->second);
+                elements_unchanged.push_back(true);
+                continue;
+            }
+            for (const std::unordered_map<TreeSupportElementT, cura52::AABB>& cluster_aabb : insert_aabb)
+            {
+                const auto merged = cluster_aabb.find(influence_area.first);
+                if (merged != cluster_aabb.end())
+                {
+                    elements.push_back(&influence_area.first);
+                    elements_aabb.push_back(merged->second);
+                    elements_unchanged.push_back(false);
+                    break;
+                }
+            }
+        }
     }
 }
 
@@ -2,11 +2,14 @@
 // CuraEngine is released under the terms of the AGPLv3 or higher.
 
 #include <algorithm> //For std::partition_copy and std::min_element.
+#include <cmath> //For std::sin.
 #include <unordered_set>
 
 #include "WallToolPaths.h"
 
+#include "Application.h"
 #include "SkeletalTrapezoidation.h"
+#include "Slice.h"
 #include "utils/SparsePointGrid.h" //To stitch the inner contour.
 #include "utils/polygonUtils.h"
 #include "ExtruderTrain.h"
@@ -14,6 +17,7 @@
 #include "utils/Simplify.h"
 #include "utils/inputserial.h"
 #include "settings/EnumSettings.h"
+#include "sliceDataStorage.h"
 
 namespace cura52
 {                              
@@ -100,6 +104,19 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
         scaled_spacing_wall_X = getScaledSpacing(bead_width_x);        
     }
 
+    // Parts which are thick enough everywhere get the same walls from plain offsets, which is much cheaper than the skeletal trapezoidation.
+    const bool offset_walls_enabled = ! settings.has("wall_offset_fast_path") || settings.get<bool>("wall_offset_fast_path");
+    if (offset_walls_enabled && inset_count > 0)
+    {
+        const coord_t spacing_0 = scaled_spacing_wall_0;
+        const coord_t spacing_x = scaled_spacing_wall_X;
+        if (isUniformWidthOutline(spacing_0 + (inset_count - 1) * spacing_x, transitioning_angle))
+        {
+            generateOffsetWalls(spacing_0, spacing_x);
+            return toolpaths;
+        }
+    }
+
     auto scale = [&](Polygons& polys)
     {
         for (int i = 0; i < polys.size(); i++)
@@ -116,7 +133,7 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
 
     // Simplify outline for boost::voronoi consumption. Absolutely no self intersections or near-self intersections allowed:
     // TODO: Open question: Does this indeed fix all (or all-but-one-in-a-million) cases for manifold but otherwise possibly complex polygons?
-    Polygons prepared_outline = outline.offset(-epsilon_offset).offset(epsilon_offset * 2).offset(-epsilon_offset);    
+    Polygons prepared_outline = offsetOutline(-epsilon_offset)->offset(epsilon_offset * 2).offset(-epsilon_offset);    
     prepared_outline = Simplify(settings).polygon(prepared_outline);
     PolygonUtils::fixSelfIntersections(epsilon_offset, prepared_outline);
     prepared_outline.removeDegenerateVerts();
@@ -290,6 +307,76 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
     return toolpaths;
 }
 
+bool WallToolPaths::isUniformWidthOutline(const coord_t wall_thickness, const AngleRadians transitioning_angle) const
+{
+    // Up to about one more line width, the beading strategy would still widen the walls to fill the part.
+    const coord_t radius = wall_thickness + bead_width_x / 2;
+    const std::shared_ptr<const Polygons> eroded = offsetOutline(-radius, ClipperLib::jtRound);
+    if (eroded->size() != outline.size())
+    {
+        return false; // Something vanished or was split in two.
+    }
+    // Growing back with mitered corners restores all corners exactly, except those sharper than the transitioning angle.
+    const double miter_limit = 1.0 / std::sin(static_cast<double>(transitioning_angle) / 2);
+    const Polygons restored = eroded->offset(radius, ClipperLib::jtMiter, miter_limit);
+    const double max_lost_area = static_cast<double>(bead_width_x) * bead_width_x / 4;
+    return outline.difference(restored).area() <= max_lost_area;
+}
+
+void WallToolPaths::generateOffsetWalls(const coord_t spacing_0, const coord_t spacing_x)
+{
+    toolpaths.resize(inset_count);
+    for (size_t inset_idx = 0; inset_idx < inset_count; inset_idx++)
+    {
+        // Same locations as the beading strategy gives the beads: only the outer wall is moved inwards by wall_0_inset.
+        const coord_t width = (inset_idx == 0) ? spacing_0 : spacing_x;
+        const coord_t distance = (inset_idx == 0) ? wall_0_inset + spacing_0 / 2 : spacing_0 + (2 * inset_idx - 1) * spacing_x / 2;
+        const std::shared_ptr<const Polygons> inset = offsetOutline(-distance, ClipperLib::jtRound);
+        for (ConstPolygonRef polygon : *inset)
+        {
+            if (polygon.size() < 3)
+            {
+                continue;
+            }
+            constexpr bool is_odd = false;
+            ExtrusionLine line(inset_idx, is_odd);
+            line.start_idx = -1;
+            line.is_closed = true;
+            line.junctions.reserve(polygon.size() + 1);
+            for (const Point& point : polygon)
+            {
+                line.junctions.emplace_back(point, width, inset_idx);
+            }
+            line.junctions.emplace_back(line.junctions.front()); // Closed the same way as stitched polygons.
+            toolpaths[inset_idx].emplace_back(std::move(line));
+        }
+    }
+    inner_contour = *offsetOutline(-(spacing_0 + (inset_count - 1) * spacing_x), ClipperLib::jtRound);
+
+    simplifyToolPaths(toolpaths, settings);
+    removeEmptyToolPaths(toolpaths);
+    offset_walls = true;
+    toolpaths_generated = true;
+}
+
+bool WallToolPaths::usedOffsetWalls() const
+{
+    return offset_walls;
+}
+
+void WallToolPaths::setOutlinePart(const SliceLayerPart* part)
+{
+    outline_part = (part && static_cast<const Polygons*>(&part->outline) == &outline) ? part : nullptr;
+}
+
+std::shared_ptr<const Polygons> WallToolPaths::offsetOutline(const coord_t distance, const ClipperLib::JoinType join_type, const double miter_limit) const
+{
+    if (outline_part)
+    {
+        return outline_part->getOutlineOffset(distance, PolygonOffsetCache::Stage::WALLS, settings.application->current_slice->offset_cache_budget, join_type, miter_limit);
+    }
+    return std::make_shared<const Polygons>(outline.offset(distance, join_type, miter_limit));
+}
 
 void WallToolPaths::stitchToolPaths(std::vector<VariableWidthLines>& toolpaths, const Settings& settings)
 {
@@ -132,14 +132,14 @@ void WallsComputation::split_top_surfaces(Slic3r::ExPolygons& orig_polygons, Sli
     //}
 }
 
-void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upper, SliceLayer* layer_lower)
+bool WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upper, SliceLayer* layer_lower)
 {
     size_t wall_count = settings.get<size_t>("wall_line_count");
     if (wall_count == 0) // Early out if no walls are to be generated
     {
         part->print_outline = part->outline;
         part->inner_area = part->outline;
-        return;
+        return false;
     }
 
     const bool spiralize = settings.get<bool>("magic_spiralize");
@@ -161,6 +161,8 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upp
     const Ratio line_width_x_factor = first_layer ? settings.get<ExtruderTrain&>("wall_x_extruder_nr").settings.get<Ratio>("initial_layer_line_width_factor") : 1.0_r;
     const coord_t line_width_x = settings.get<coord_t>("wall_line_width_x") * line_width_x_factor;
 
+    bool offset_walls = false;
+
     // When spiralizing, generate the spiral insets using simple offsets instead of generating toolpaths
     if (spiralize)
     {
@@ -171,8 +173,10 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upp
         if (layer_nr <= static_cast<LayerIndex>(settings.get<size_t>("bottom_layers")))
         {
             WallToolPaths wall_tool_paths(part->outline, line_width_0, line_width_x, wall_count, wall_0_inset, settings);
+            wall_tool_paths.setOutlinePart(part);
             part->wall_toolpaths = wall_tool_paths.getToolPaths();
             part->inner_area = wall_tool_paths.getInnerContour();
+            offset_walls = wall_tool_paths.usedOffsetWalls();
         }
     }
     else
@@ -205,7 +209,9 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upp
         if (wall_count > 1 && roofing_only_one_wall && !first_layer && layer_different_area.area() > line_width_0 * line_width_0)
         {
             WallToolPaths OuterWall_tool_paths(part->outline, line_width_0, line_width_x, 1, wall_0_inset, settings);
+            OuterWall_tool_paths.setOutlinePart(part);
             part->wall_toolpaths = OuterWall_tool_paths.getToolPaths();
+            offset_walls = OuterWall_tool_paths.usedOffsetWalls();
             Polygons non_OuterWall_area = OuterWall_tool_paths.getInnerContour();
             Polygons roof_area = non_OuterWall_area.difference(upLayerPart);
 
@@ -247,17 +253,21 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upp
                 }
                 part->wall_toolpaths.insert(part->wall_toolpaths.end(), innerWall_toolpaths.begin(), innerWall_toolpaths.end());
                 part->inner_area = innerWall_tool_paths.getInnerContour();
+                offset_walls = offset_walls && innerWall_tool_paths.usedOffsetWalls();
             }
             part->inner_area.add(roof_area);  //top suface inner wall
         }
         else
         {
             WallToolPaths wall_tool_paths(part->outline, line_width_0, line_width_x, wall_count, wall_0_inset, settings);
+            wall_tool_paths.setOutlinePart(part);
             part->wall_toolpaths = wall_tool_paths.getToolPaths();
             part->inner_area = wall_tool_paths.getInnerContour();
+            offset_walls = wall_tool_paths.usedOffsetWalls();
         }
     }
     part->print_outline = part->outline;
+    return offset_walls;
 }
 
 /*
@@ -268,10 +278,14 @@ void WallsComputation::generateWalls(SliceLayerPart* part, SliceLayer* layer_upp
  */
 void WallsComputation::generateWalls(SliceLayer* layer, SliceLayer* layer_upper, SliceLayer* layer_lower)
 {
+    layer->offset_wall_part_count = 0;
     for(SliceLayerPart& part : layer->parts)
     {
         INTERRUPT_BREAK("WallsComputation::generateWalls. ");
-        generateWalls(&part, layer_upper,  layer_lower);
+        if (generateWalls(&part, layer_upper,  layer_lower))
+        {
+            layer->offset_wall_part_count++;
+        }
     }
 
     //Remove the parts which did not generate a wall. As these parts are too small to print,
@@ -295,7 +309,7 @@ void WallsComputation::generateWalls(SliceLayer* layer, SliceLayer* layer_upper,
 
 void WallsComputation::generateSpiralInsets(SliceLayerPart *part, coord_t line_width_0, coord_t wall_0_inset, bool recompute_outline_based_on_outer_wall)
 {
-    part->spiral_wall = part->outline.offset(-line_width_0 / 2 - wall_0_inset);
+    part->spiral_wall = *part->getOutlineOffset(-line_width_0 / 2 - wall_0_inset, PolygonOffsetCache::Stage::WALLS, application->current_slice->offset_cache_budget);
 
     //Optimize the wall. This prevents buffer underruns in the printer firmware, and reduces processing time in CuraEngine.
     const ExtruderTrain& train_wall = settings.get<ExtruderTrain&>("wall_0_extruder_nr");
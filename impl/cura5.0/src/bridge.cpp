@@ -10,19 +10,11 @@
 namespace cura52
 {
 
-int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const SliceDataStorage& storage, const unsigned layer_nr, const unsigned bridge_layer, const SupportLayer* support_layer, Polygons& supported_regions)
+BridgeSolidBelow::BridgeSolidBelow(const SliceDataStorage& storage, const unsigned below_layer_nr, const bool subtract_sparse_infill, const Ratio sparse_infill_max_density)
+: below_layer_nr(below_layer_nr)
+, subtract_sparse_infill(subtract_sparse_infill)
+, sparse_infill_max_density(sparse_infill_max_density)
 {
-    assert(! skin_outline.empty());
-    AABB boundary_box(skin_outline);
-
-    //To detect if we have a bridge, first calculate the intersection of the current layer with the previous layer.
-    // This gives us the islands that the layer rests on.
-    Polygons islands;
-
-    Polygons prev_layer_outline; // we also want the complete outline of the previous layer
-
-    const Ratio sparse_infill_max_density = settings.get<Ratio>("bridge_sparse_infill_max_density");
-
     // include parts from all meshes
     for (const SliceMeshStorage& mesh : storage.meshes)
     {
@@ -32,21 +24,63 @@ int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const Sl
             const coord_t infill_line_width = mesh.settings.get<coord_t>("infill_line_width");
             const bool part_has_sparse_infill = (infill_line_distance == 0) || ((float)infill_line_width / infill_line_distance) <= sparse_infill_max_density;
 
-            for (const SliceLayerPart& prev_layer_part : mesh.layers[layer_nr - bridge_layer].parts)
+            for (const SliceLayerPart& prev_layer_part : mesh.layers[below_layer_nr].parts)
             {
                 Polygons solid_below(prev_layer_part.outline);
-                if (bridge_layer == 1 && part_has_sparse_infill)
+                if (subtract_sparse_infill && part_has_sparse_infill)
                 {
                     solid_below = solid_below.difference(prev_layer_part.getOwnInfillArea());
                 }
-                prev_layer_outline.add(solid_below); // not intersected with skin
+                outline.add(solid_below);
+                part_solid_below.emplace_back(std::move(solid_below));
+                part_boxes.emplace_back(prev_layer_part.boundaryBox);
+            }
+        }
+    }
+}
+
+const BridgeSolidBelow& BridgeSolidBelowCache::get(const SliceDataStorage& storage, const unsigned below_layer_nr, const bool subtract_sparse_infill, const Ratio sparse_infill_max_density)
+{
+    for (const std::unique_ptr<BridgeSolidBelow>& entry : entries)
+    {
+        if (entry->below_layer_nr == below_layer_nr && entry->subtract_sparse_infill == subtract_sparse_infill && entry->sparse_infill_max_density == sparse_infill_max_density)
+        {
+            return *entry;
+        }
+    }
+    entries.emplace_back(std::make_unique<BridgeSolidBelow>(storage, below_layer_nr, subtract_sparse_infill, sparse_infill_max_density));
+    return *entries.back();
+}
 
-                if (!boundary_box.hit(prev_layer_part.boundaryBox))
-                    continue;
+int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const BridgeSolidBelow& solid_below, const SupportLayer* support_layer, Polygons& supported_regions)
+{
+    assert(! skin_outline.empty());
+    AABB boundary_box(skin_outline);
 
-                islands.add(skin_outline.intersection(solid_below));
-            }
+    //To detect if we have a bridge, first calculate the intersection of the current layer with the previous layer.
+    // This gives us the islands that the layer rests on.
+    Polygons islands;
+
+    // we also want the complete outline of the previous layer, copied only if support is added to it
+    const Polygons* prev_layer_outline = &solid_below.outline;
+    Polygons prev_layer_outline_with_support;
+    auto addToPrevLayerOutline = [&](const Polygons& support)
+    {
+        if (prev_layer_outline != &prev_layer_outline_with_support)
+        {
+            prev_layer_outline_with_support = solid_below.outline;
+            prev_layer_outline = &prev_layer_outline_with_support;
         }
+        prev_layer_outline_with_support.add(support);
+    };
+
+    // A layer has few parts, so checking the box of each before intersecting is enough.
+    for (size_t part_idx = 0; part_idx < solid_below.part_boxes.size(); part_idx++)
+    {
+        if (!boundary_box.hit(solid_below.part_boxes[part_idx]))
+            continue;
+
+        islands.add(skin_outline.intersection(solid_below.part_solid_below[part_idx]));
     }
     supported_regions = islands;
 
@@ -63,7 +97,7 @@ int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const Sl
             AABB support_roof_bb(support_layer->support_roof);
             if (boundary_box.hit(support_roof_bb))
             {
-                prev_layer_outline.add(support_layer->support_roof); // not intersected with skin
+                addToPrevLayerOutline(support_layer->support_roof); // not intersected with skin
 
                 Polygons supported_skin(skin_outline.intersection(support_layer->support_roof));
                 if (!supported_skin.empty())
@@ -79,7 +113,7 @@ int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const Sl
                 AABB support_part_bb(support_part.getInfillArea());
                 if (boundary_box.hit(support_part_bb))
                 {
-                    prev_layer_outline.add(support_part.getInfillArea()); // not intersected with skin
+                    addToPrevLayerOutline(support_part.getInfillArea()); // not intersected with skin
 
                     Polygons supported_skin(skin_outline.intersection(support_part.getInfillArea()));
                     if (!supported_skin.empty())
@@ -109,7 +143,7 @@ int bridgeAngle(const Settings& settings, const Polygons& skin_outline, const Sl
         // the air boundary do appear to be supported
 
         const int bb_max_dim = std::max(boundary_box.max.X - boundary_box.min.X, boundary_box.max.Y - boundary_box.min.Y);
-        const Polygons air_below(bb_poly.offset(bb_max_dim).difference(prev_layer_outline).offset(MM2INT(-0.1)));
+        const Polygons air_below(bb_poly.offset(bb_max_dim).difference(*prev_layer_outline).offset(MM2INT(-0.1)));
 
         Polygons skin_perimeter_lines;
         for (ConstPolygonRef poly : skin_outline)
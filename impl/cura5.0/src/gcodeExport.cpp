@@ -13,6 +13,7 @@
 #include "PrintFeature.h"
 #include "RetractionConfig.h"
 #include "Slice.h"
+#include "SliceListener.h"
 #include "WipeScriptConfig.h"
 #include "gcodeExport.h"
 #include "settings/types/LayerIndex.h"
@@ -93,6 +94,7 @@ GCodeExport::GCodeExport()
     build_volume_temperature = 0;
     machine_heated_build_volume = false;
     m_preFixLen = 0;
+    emitted_bytes = 0;
 
     fan_number = 0;
     use_extruder_offset_to_offset_coords = false;
@@ -709,6 +711,88 @@ void GCodeExport::setOutputStream(std::ostream* stream)
     *output_stream << std::fixed;
 }
 
+/*!
+ * Read part of the g-code file back. The reader stays open between chunks, so
+ * its state has to be reset after it ran into the end of the file.
+ */
+static bool readBack(std::ifstream& reader, const size_t offset, const size_t size, std::string& data)
+{
+    reader.clear();
+    reader.seekg(static_cast<std::streamoff>(offset));
+    data.resize(size);
+    reader.read(&data[0], static_cast<std::streamsize>(size));
+    return static_cast<size_t>(reader.gcount()) == size;
+}
+
+void GCodeExport::setChunkSource(const std::string& file_name)
+{
+    chunk_source.clear();
+    emitted_bytes = 0;
+    if (chunk_reader.is_open())
+    {
+        chunk_reader.close();
+    }
+    if (! application || ! application->listener || ! application->listener->wantsGCodeChunks())
+    {
+        return;
+    }
+    chunk_reader.open(file_name, std::ios::binary);
+    if (! chunk_reader.is_open())
+    {
+        LOGW("Can't read back { %s }, the g-code won't be handed out in chunks.", file_name.c_str());
+        return;
+    }
+    chunk_source = file_name;
+}
+
+void GCodeExport::emitLayerChunk(const LayerIndex layer_nr)
+{
+    if (chunk_source.empty())
+    {
+        return;
+    }
+    output_stream->flush();
+    const std::streamoff end = output_stream->tellp();
+    if (end < 0 || static_cast<size_t>(end) <= emitted_bytes)
+    {
+        return;
+    }
+    GCodeChunk chunk;
+    chunk.type = GCodeChunk::Type::LAYER;
+    chunk.layer_nr = layer_nr;
+    chunk.offset = emitted_bytes;
+    if (! readBack(chunk_reader, emitted_bytes, static_cast<size_t>(end) - emitted_bytes, chunk.data))
+    {
+        LOGW("Reading back g-code for layer { %d } failed.", static_cast<int>(layer_nr));
+        return; // Try again with the next layer.
+    }
+    emitted_bytes = static_cast<size_t>(end);
+    application->notifyGCodeChunk(chunk);
+}
+
+void GCodeExport::emitEndChunk()
+{
+    if (chunk_source.empty())
+    {
+        return;
+    }
+    output_stream->flush();
+    output_stream->seekp(0, std::ios::end);
+    const std::streamoff end = output_stream->tellp();
+    GCodeChunk chunk;
+    chunk.type = GCodeChunk::Type::END;
+    chunk.layer_nr = layer_nr;
+    chunk.offset = emitted_bytes;
+    if (end > 0 && static_cast<size_t>(end) > emitted_bytes)
+    {
+        readBack(chunk_reader, emitted_bytes, static_cast<size_t>(end) - emitted_bytes, chunk.data);
+    }
+    emitted_bytes += chunk.data.size();
+    application->notifyGCodeChunk(chunk);
+    chunk_source.clear();
+    chunk_reader.close();
+}
+
 bool GCodeExport::getExtruderIsUsed(const int extruder_nr) const
 {
     assert(extruder_nr >= 0);
@@ -993,6 +1077,16 @@ void GCodeExport::reWritePreFixStr(std::string preFix)
         len++;
     }
     output_stream->seekp(0, std::ios::end);
+
+    if (! chunk_source.empty())
+    {
+        GCodeChunk chunk;
+        chunk.type = GCodeChunk::Type::HEADER;
+        chunk.offset = 0;
+        output_stream->flush();
+        readBack(chunk_reader, 0, std::max(preFix.length(), m_preFixLen), chunk.data);
+        application->notifyGCodeChunk(chunk);
+    }
 }
 
 void GCodeExport::writeComment(const std::string& unsanitized_comment)
@@ -5,7 +5,9 @@
 #include "infill/LightningLayer.h"
 #include "infill/LightningTreeNode.h"
 
+#include "Application.h"
 #include "ExtruderTrain.h"
+#include "Slice.h"
 #include "sliceDataStorage.h"
 #include "utils/linearAlg2D.h"
 #include "utils/SparsePointGridInclusive.h"
@@ -55,7 +57,7 @@ void LightningGenerator::generateInitialInternalOverhangs(const SliceMeshStorage
         Polygons infill_area_here;
         for (auto& part : current_layer.parts)
         {
-            infill_area_here.add(part.getOwnInfillArea().offset(infill_wall_offset));
+            infill_area_here.add(*part.getOwnInfillAreaOffset(infill_wall_offset, PolygonOffsetCache::Stage::INFILL, mesh.settings.application->current_slice->offset_cache_budget));
         }
 
         //Remove the part of the infill area that is already supported by the walls.
@@ -87,7 +89,7 @@ void LightningGenerator::generateTrees(const SliceMeshStorage& mesh)
     {
         for (const auto& part : mesh.layers[layer_id].parts)
         {
-            infill_outlines[layer_id].add(part.getOwnInfillArea().offset(infill_wall_offset));
+            infill_outlines[layer_id].add(*part.getOwnInfillAreaOffset(infill_wall_offset, PolygonOffsetCache::Stage::INFILL, mesh.settings.application->current_slice->offset_cache_budget));
         }
     }
 
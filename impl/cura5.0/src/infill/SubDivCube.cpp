@@ -7,8 +7,11 @@
 
 #include "sliceDataStorage.h"
 #include "settings/types/Angle.h" //For the infill angle.
+#include "settings/types/Ratio.h"
+#include "utils/linearAlg2D.h"
 #include "utils/math.h"
 #include "utils/polygonUtils.h"
+#include "utils/ThreadPool.h"
 
 #define ONE_OVER_SQRT_2 0.7071067811865475244008443621048490392848359376884740 //1 / sqrt(2)
 #define ONE_OVER_SQRT_3 0.577350269189625764509148780501957455647601751270126876018 //1 / sqrt(3)
@@ -18,10 +21,100 @@
 namespace cura52
 {
 
-std::vector<SubDivCube::CubeProperties> SubDivCube::cube_properties_per_recursion_step;
-coord_t SubDivCube::radius_addition = 0;
-Point3Matrix SubDivCube::rotation_matrix;
-PointMatrix SubDivCube::infill_rotation_matrix;
+struct SubDivCube::LayerInfillOutline
+{
+    Polygons infill_area; //!< The infill areas of all parts of the layer. Parts never overlap, so this is their union.
+    AABB aabb; //!< The bounding box of \ref infill_area
+    std::unique_ptr<LocToLineGrid> loc_to_line; //!< Grid of the line segments of \ref infill_area
+    size_t segment_count = 0; //!< The number of line segments in \ref infill_area
+
+    /*!
+     * Gather the infill areas of a layer and index their line segments.
+     * \param layer the layer to gather the infill areas of
+     * \param cell_size the cell size of the grid
+     */
+    void build(const SliceLayer& layer, const coord_t cell_size)
+    {
+        for (const SliceLayerPart& part : layer.parts)
+        {
+            infill_area.add(part.infill_area);
+        }
+        segment_count = infill_area.pointCount();
+        if (segment_count == 0)
+        {
+            return;
+        }
+        aabb.calculate(infill_area);
+        loc_to_line = PolygonUtils::createLocToLineGrid(infill_area, cell_size);
+    }
+
+    /*!
+     * Whether a point lies inside the infill areas of this layer.
+     */
+    bool inside(const Point& location) const
+    {
+        if (segment_count == 0 || ! aabb.contains(location))
+        {
+            return false;
+        }
+        return infill_area.inside(location);
+    }
+
+    /*!
+     * Whether the border of the infill areas comes closer to \p location than sqrt(\p max_dist2).
+     */
+    bool isBorderWithin(const Point& location, const coord_t max_dist2) const
+    {
+        if (segment_count == 0 || max_dist2 <= 0)
+        {
+            return false;
+        }
+        if (aabb.distanceSquared(location) >= max_dist2)
+        { // The whole layer is further away than the query distance.
+            return false;
+        }
+        const auto is_close = [&location, max_dist2](const Point& a, const Point& b)
+        {
+            return LinearAlg2D::getDist2FromLineSegment(a, location, b) < max_dist2;
+        };
+
+        const coord_t radius = std::sqrt(max_dist2) + 1;
+        const coord_t cells_across = 2 * radius / loc_to_line->getCellSize() + 1;
+        if (cells_across * cells_across > static_cast<coord_t>(segment_count))
+        { // Visiting the cells would be more work than checking every segment.
+            for (ConstPolygonRef poly : infill_area)
+            {
+                if (poly.empty())
+                {
+                    continue;
+                }
+                Point prev = poly.back();
+                for (const Point& here : poly)
+                {
+                    if (is_close(prev, here))
+                    {
+                        return true;
+                    }
+                    prev = here;
+                }
+            }
+            return false;
+        }
+
+        bool found = false;
+        loc_to_line->processNearby(location, radius,
+                                   [&found, &is_close](const PolygonsPointIndex& segment_start)
+                                   {
+                                       if (is_close(segment_start.p(), segment_start.next().p()))
+                                       {
+                                           found = true;
+                                           return false; // Stop searching.
+                                       }
+                                       return true;
+                                   });
+        return found;
+    }
+};
 
 SubDivCube::~SubDivCube()
 {
@@ -36,7 +129,8 @@ SubDivCube::~SubDivCube()
 
 void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point& infill_origin)
 {
-    radius_addition = mesh.settings.get<coord_t>("sub_div_rad_add");
+    std::unique_ptr<OctreeProperties> octree_properties = std::make_unique<OctreeProperties>();
+    octree_properties->radius_addition = mesh.settings.get<coord_t>("sub_div_rad_add");
 
     // if infill_angles is not empty use the first value, otherwise use 0
     const std::vector<AngleDegrees> infill_angles = mesh.settings.get<std::vector<AngleDegrees>>("infill_angles");
@@ -45,6 +139,7 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point& infill_or
     const coord_t furthest_dist_from_origin = std::sqrt(square(mesh.settings.get<coord_t>("machine_height")) + square(mesh.settings.get<coord_t>("machine_depth") / 2) + square(mesh.settings.get<coord_t>("machine_width") / 2));
     const coord_t max_side_length = furthest_dist_from_origin * 2;
 
+    std::vector<CubeProperties>& cube_properties_per_recursion_step = octree_properties->cube_properties_per_recursion_step;
     size_t curr_recursion_depth = 0;
     const coord_t infill_line_distance = mesh.settings.get<coord_t>("infill_line_distance");
     if (infill_line_distance > 0)
@@ -79,17 +174,59 @@ void SubDivCube::precomputeOctree(SliceMeshStorage& mesh, const Point& infill_or
     tilt.matrix[3] = -ONE_OVER_SQRT_6; tilt.matrix[4] = -ONE_OVER_SQRT_6; tilt.matrix[5] = SQRT_TWO_THIRD ;
     tilt.matrix[6] = ONE_OVER_SQRT_3;  tilt.matrix[7] = ONE_OVER_SQRT_3;  tilt.matrix[8] = ONE_OVER_SQRT_3;
 
-    infill_rotation_matrix = PointMatrix(infill_angle);
-    Point3Matrix infill_angle_mat(infill_rotation_matrix);
+    octree_properties->infill_rotation_matrix = PointMatrix(infill_angle);
+    Point3Matrix infill_angle_mat(octree_properties->infill_rotation_matrix);
 
-    rotation_matrix = infill_angle_mat.compose(tilt);
+    octree_properties->rotation_matrix = infill_angle_mat.compose(tilt);
 
-    mesh.base_subdiv_cube = new SubDivCube(mesh, center, curr_recursion_depth - 1);
+    SubDivCube* root = new SubDivCube(octree_properties.get(), center, curr_recursion_depth - 1);
+    root->owned_properties = std::move(octree_properties);
+    mesh.base_subdiv_cube = root;
+
+    if (cube_properties_per_recursion_step.empty())
+    {
+        return;
+    }
+
+    // Gather the infill areas of each layer once, rather than once for every cube that is tested against it.
+    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height");
+    const coord_t cell_size = cube_properties_per_recursion_step[0].side_length;
+    std::vector<LayerInfillOutline> layer_outlines(mesh.layers.size());
+    cura52::parallel_for<size_t>(mesh.appliction, 0, mesh.layers.size(),
+                               [&](size_t layer_nr)
+                               {
+                                   layer_outlines[layer_nr].build(mesh.layers[layer_nr], cell_size);
+                               });
+
+    // Grow the octree one level at a time. The cubes of a level are subdivided independently of each other.
+    std::vector<SubDivCube*> current_level{ root };
+    std::vector<SubDivCube*> next_level;
+    while (! current_level.empty())
+    {
+        cura52::parallel_for<size_t>(mesh.appliction, 0, current_level.size(),
+                                   [&](size_t cube_idx)
+                                   {
+                                       current_level[cube_idx]->subdivide(layer_outlines, layer_height);
+                                   });
+
+        next_level.clear();
+        for (SubDivCube* cube : current_level)
+        {
+            for (SubDivCube* child : cube->children)
+            {
+                if (child)
+                {
+                    next_level.push_back(child);
+                }
+            }
+        }
+        current_level.swap(next_level);
+    }
 }
 
 void SubDivCube::generateSubdivisionLines(const coord_t z, Polygons& result)
 {
-    if (cube_properties_per_recursion_step.empty()) //Infill is set to 0%.
+    if (properties->cube_properties_per_recursion_step.empty()) //Infill is set to 0%.
     {
         return;
     }
@@ -109,7 +246,7 @@ void SubDivCube::generateSubdivisionLines(const coord_t z, Polygons& result)
 
 void SubDivCube::generateSubdivisionLines(const coord_t z, Polygons (&directional_line_groups)[3])
 {
-    CubeProperties cube_properties = cube_properties_per_recursion_step[depth];
+    const CubeProperties& cube_properties = properties->cube_properties_per_recursion_step[depth];
 
     const coord_t z_diff = std::abs(z - center.z); //!< the difference between the cube center and the target layer.
     if (z_diff > cube_properties.height / 2) //!< this cube does not touch the target layer. Early exit.
@@ -149,64 +286,73 @@ void SubDivCube::generateSubdivisionLines(const coord_t z, Polygons (&directiona
     }
 }
 
-SubDivCube::SubDivCube(SliceMeshStorage& mesh, Point3& center, size_t depth)
+SubDivCube::SubDivCube(const OctreeProperties* properties, const Point3& center, size_t depth)
+    : properties(properties)
+    , depth(depth)
+    , center(center)
 {
-    this->depth = depth;
-    this->center = center;
+}
 
+void SubDivCube::subdivide(const std::vector<LayerInfillOutline>& layer_outlines, const coord_t layer_height)
+{
     if (depth == 0) // lowest layer, no need for subdivision, exit.
     {
         return;
     }
-    if (depth >= cube_properties_per_recursion_step.size()) //Depth is out of bounds of what we pre-computed.
+    if (depth >= properties->cube_properties_per_recursion_step.size()) //Depth is out of bounds of what we pre-computed.
     {
         return;
     }
 
-    CubeProperties cube_properties = cube_properties_per_recursion_step[depth];
+    const CubeProperties& cube_properties = properties->cube_properties_per_recursion_step[depth];
     Point3 child_center;
-    coord_t radius = double(cube_properties.height) / 4.0 + radius_addition;
+    coord_t radius = double(cube_properties.height) / 4.0 + properties->radius_addition;
 
     int child_nr = 0;
-    std::vector<Point3> rel_child_centers;
-    rel_child_centers.emplace_back(1, 1, 1); // top
-    rel_child_centers.emplace_back(-1, 1, 1); // top three
-    rel_child_centers.emplace_back(1, -1, 1);
-    rel_child_centers.emplace_back(1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, -1); // bottom
-    rel_child_centers.emplace_back(1, -1, -1); // bottom three
-    rel_child_centers.emplace_back(-1, 1, -1);
-    rel_child_centers.emplace_back(-1, -1, 1);
-    for (Point3 rel_child_center : rel_child_centers)
+    static const Point3 rel_child_centers[8] = {
+        Point3(1, 1, 1), // top
+        Point3(-1, 1, 1), // top three
+        Point3(1, -1, 1),
+        Point3(1, 1, -1),
+        Point3(-1, -1, -1), // bottom
+        Point3(1, -1, -1), // bottom three
+        Point3(-1, 1, -1),
+        Point3(-1, -1, 1)
+    };
+    for (const Point3& rel_child_center : rel_child_centers)
     {
-        child_center = center + rotation_matrix.apply(rel_child_center * int32_t(cube_properties.side_length / 4));
-        if (isValidSubdivision(mesh, child_center, radius))
+        child_center = center + properties->rotation_matrix.apply(rel_child_center * int32_t(cube_properties.side_length / 4));
+        if (isValidSubdivision(layer_outlines, layer_height, child_center, radius))
         {
-            children[child_nr] = new SubDivCube(mesh, child_center, depth - 1);
+            children[child_nr] = new SubDivCube(properties, child_center, depth - 1);
             child_nr++;
         }
     }
 }
 
-bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3& center, coord_t radius)
+bool SubDivCube::isValidSubdivision(const std::vector<LayerInfillOutline>& layer_outlines, const coord_t layer_height, const Point3& center, coord_t radius)
 {
-    coord_t distance2 = 0;
     coord_t sphere_slice_radius2;//!< squared radius of bounding sphere slice on target layer
     bool inside_somewhere = false;
     bool outside_somewhere = false;
-    int inside;
     Ratio part_dist;//what percentage of the radius the target layer is away from the center along the z axis. 0 - 1
-    const coord_t layer_height = mesh.settings.get<coord_t>("layer_height");
     int bottom_layer = (center.z - radius) / layer_height;
     int top_layer = (center.z + radius) / layer_height;
+    const Point loc(center.x, center.y);
     for (int test_layer = bottom_layer; test_layer <= top_layer; test_layer += 3) // steps of three. Low-hanging speed gain.
     {
-        part_dist = static_cast<Ratio>(test_layer * layer_height - center.z) / radius;
-        sphere_slice_radius2 = radius * radius * (1.0 - (part_dist * part_dist));
-        Point loc(center.x, center.y);
+        if (test_layer < 0 || static_cast<size_t>(test_layer) >= layer_outlines.size()) //!< this layer is outside of valid range
+        {
+            outside_somewhere = true;
+            if (inside_somewhere)
+            {
+                return true;
+            }
+            continue;
+        }
+        const LayerInfillOutline& layer_outline = layer_outlines[test_layer];
 
-        inside = distanceFromPointToMesh(mesh, test_layer, loc, &distance2);
-        if (inside == 1)
+        if (layer_outline.inside(loc))
         {
             inside_somewhere = true;
         }
@@ -218,7 +364,9 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3& center, coor
         {
             return true;
         }
-        if ((inside != 2) && distance2 < sphere_slice_radius2)
+        part_dist = static_cast<Ratio>(test_layer * layer_height - center.z) / radius;
+        sphere_slice_radius2 = radius * radius * (1.0 - (part_dist * part_dist));
+        if (layer_outline.isBorderWithin(loc, sphere_slice_radius2))
         {
             return true;
         }
@@ -226,35 +374,9 @@ bool SubDivCube::isValidSubdivision(SliceMeshStorage& mesh, Point3& center, coor
     return false;
 }
 
-coord_t SubDivCube::distanceFromPointToMesh(SliceMeshStorage& mesh, const LayerIndex layer_nr, Point& location, coord_t* distance2)
-{
-    if (layer_nr < 0 || (unsigned int)layer_nr >= mesh.layers.size()) //!< this layer is outside of valid range
-    {
-        return 2;
-        *distance2 = 0;
-    }
-    Polygons collide;
-    for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
-    {
-        collide.add(part.infill_area);
-    }
-
-    Point centerpoint = location;
-    bool inside = collide.inside(centerpoint);
-    ClosestPolygonPoint border_point = PolygonUtils::moveInside2(collide, centerpoint);
-    Point diff = border_point.location - location;
-    *distance2 = vSize2(diff);
-    if (inside)
-    {
-        return 1;
-    }
-    return 0;
-}
-
-
-void SubDivCube::rotatePointInitial(Point& target)
+void SubDivCube::rotatePointInitial(Point& target) const
 {
-    target = infill_rotation_matrix.apply(target);
+    target = properties->infill_rotation_matrix.apply(target);
 }
 
 void SubDivCube::rotatePoint120(Point& target)
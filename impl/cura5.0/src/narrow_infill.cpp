@@ -1,6 +1,7 @@
 
 
 #include "narrow_infill.h"
+#include "utils/Slic3rGeometry.h"
 
 
 
@@ -8,55 +9,19 @@
 
 Slic3r::ExPolygon convert(const cura52::Polygons& polygons)
 {
-    Slic3r::Polygons Sli3crpolygons;
-    Slic3r::Points points_in;
-    Slic3r::Point point_in;
-    for (int i = 0; i < polygons.size(); i++)
-    {
-        ClipperLib::Path path = *(polygons.begin() + i);
-        for (ClipperLib::IntPoint p : path)
-        {
-            point_in.x() = p.X * 1000;
-            point_in.y() = p.Y * 1000;
-            points_in.emplace_back(point_in);
-        }
-    }
-
     Slic3r::ExPolygon expolygon;
-    expolygon.contour.append(points_in);
+    expolygon.contour.points = cura52::Slic3rGeometry::toPoints(polygons, 1000);
     return expolygon;
 }
 
-Slic3r::Clipper3r::Paths  Polygons2clipperpaths(Slic3r::Polygons& out)
-{
-    Slic3r::Clipper3r::Path out2path;
-    Slic3r::Clipper3r::Paths out2paths;
-    for (int i = 0; i < out.size(); i++)
-    {
-        Slic3r::Polygon path = out.at(i);
-        Slic3r::Clipper3r::IntPoint pointcli;
-
-        for (int j = 0; j < path.size(); j++)
-        {
-            pointcli.x() = path[j].x();
-            pointcli.y() = path[j].y();
-            out2path.emplace_back(pointcli);
-        }
-        out2paths.emplace_back(out2path);
-        out2path.clear();
-    }
-    return out2paths;
-}
 bool result_is_top_area(const cura52::Polygons& area,  cura52::Polygons& polygons)
 {
     return  is_top_area(area, polygons);
 }
 static bool is_top_area(const cura52::Polygons& area, const cura52::Polygons& polygons)
 {
-    Slic3r::ExPolygon expolygon;
-    expolygon = convert(polygons);
-    Slic3r::ExPolygon areaex;
-    areaex = convert(area);
+    const Slic3r::ExPolygon expolygon = convert(polygons);
+    const Slic3r::ExPolygon areaex = convert(area);
     Slic3r::ExPolygons result =  Slic3r::diff_ex(areaex, expolygon, Slic3r::ApplySafetyOffset::Yes);
     if (result.empty())
         return false;
@@ -72,8 +37,7 @@ bool result_is_narrow_infill_area(const cura52::Polygons& polygons)
 static bool is_narrow_infill_area(const cura52::Polygons& polygons)
 {
 
-    Slic3r::ExPolygon expolygon;
-    expolygon = convert(polygons);
+    const Slic3r::ExPolygon expolygon = convert(polygons);
 
     const float delta = -3000000.0;
     double miterLimit = 3.000;
@@ -84,8 +48,7 @@ static bool is_narrow_infill_area(const cura52::Polygons& polygons)
 
     bool fillType = false;
     
-    Slic3r::Clipper3r::Paths out2paths;
-    out2paths = Polygons2clipperpaths(out);
+    const Slic3r::Clipper3r::Paths out2paths = cura52::Slic3rGeometry::toClipperPaths(out);
 
     Slic3r::ExPolygons result;
     result =  Slic3r::ClipperPaths_to_Slic3rExPolygons(out2paths, fillType );
@@ -61,19 +61,20 @@ LocToLineGrid& Comb::getModelBoundaryLocToLine(const ExtruderTrain& train)
     return *model_boundary_loc_to_line[train.extruder_nr];
 }
 
-Comb::Comb(const SliceDataStorage& storage, const LayerIndex layer_nr, const Polygons& comb_boundary_inside_minimum, const Polygons& comb_boundary_inside_optimal, coord_t comb_boundary_offset, coord_t travel_avoid_distance, coord_t move_inside_distance)
+Comb::Comb(const SliceDataStorage& storage, const LayerIndex layer_nr, std::shared_ptr<const CombBoundaries> boundaries, coord_t comb_boundary_offset, coord_t travel_avoid_distance, coord_t move_inside_distance)
 : storage(storage)
 , layer_nr(layer_nr)
 , offset_from_outlines(comb_boundary_offset) // between second wall and infill / other walls
 , max_moveInside_distance2(offset_from_outlines * offset_from_outlines)
 , offset_from_inside_to_outside(offset_from_outlines + travel_avoid_distance)
 , max_crossing_dist2(offset_from_inside_to_outside * offset_from_inside_to_outside * 2) // so max_crossing_dist = offset_from_inside_to_outside * sqrt(2) =approx 1.5 to allow for slightly diagonal crossings and slightly inaccurate crossing computation
-, boundary_inside_minimum( comb_boundary_inside_minimum ) // copy the boundary, because the partsView_inside will reorder the polygons
-, boundary_inside_optimal( comb_boundary_inside_optimal ) // copy the boundary, because the partsView_inside will reorder the polygons
-, partsView_inside_minimum( boundary_inside_minimum.splitIntoPartsView() ) // WARNING !! changes the order of boundary_inside !!
-, partsView_inside_optimal( boundary_inside_optimal.splitIntoPartsView() ) // WARNING !! changes the order of boundary_inside !!
-, inside_loc_to_line_minimum(PolygonUtils::createLocToLineGrid(boundary_inside_minimum, comb_boundary_offset))
-, inside_loc_to_line_optimal(PolygonUtils::createLocToLineGrid(boundary_inside_optimal, comb_boundary_offset))
+, boundaries(std::move(boundaries))
+, boundary_inside_minimum(this->boundaries->inside_minimum)
+, boundary_inside_optimal(this->boundaries->inside_optimal)
+, partsView_inside_minimum(this->boundaries->partsView_inside_minimum)
+, partsView_inside_optimal(this->boundaries->partsView_inside_optimal)
+, inside_loc_to_line_minimum(this->boundaries->inside_loc_to_line_minimum.get())
+, inside_loc_to_line_optimal(this->boundaries->inside_loc_to_line_optimal.get())
 , move_inside_distance(move_inside_distance)
 , travel_avoid_distance(travel_avoid_distance)
 {
@@ -89,10 +90,10 @@ bool Comb::calc(const ExtruderTrain& train, Point start_point, Point end_point,
     const Point travel_end_point_before_combing = end_point;
     //Move start and end point inside the optimal comb boundary
     unsigned int start_inside_poly = NO_INDEX;
-    const bool start_inside = moveInside(boundary_inside_optimal, _start_inside, inside_loc_to_line_optimal.get(), start_point, start_inside_poly);
+    const bool start_inside = moveInside(boundary_inside_optimal, _start_inside, inside_loc_to_line_optimal, start_point, start_inside_poly);
 
     unsigned int end_inside_poly = NO_INDEX;
-    const bool end_inside = moveInside(boundary_inside_optimal, _end_inside, inside_loc_to_line_optimal.get(), end_point, end_inside_poly);
+    const bool end_inside = moveInside(boundary_inside_optimal, _end_inside, inside_loc_to_line_optimal, end_point, end_inside_poly);
 
     unsigned int start_part_boundary_poly_idx = NO_INDEX; // Added initial value to stop MSVC throwing an exception in debug mode
     unsigned int end_part_boundary_poly_idx = NO_INDEX;
@@ -118,10 +119,10 @@ bool Comb::calc(const ExtruderTrain& train, Point start_point, Point end_point,
 
     // Move start and end point inside the minimum comb boundary
     unsigned int start_inside_poly_min = NO_INDEX;
-    const bool start_inside_min = moveInside(boundary_inside_minimum, _start_inside, inside_loc_to_line_minimum.get(), start_point, start_inside_poly_min);
+    const bool start_inside_min = moveInside(boundary_inside_minimum, _start_inside, inside_loc_to_line_minimum, start_point, start_inside_poly_min);
 
     unsigned int end_inside_poly_min = NO_INDEX;
-    const bool end_inside_min = moveInside(boundary_inside_minimum, _end_inside, inside_loc_to_line_minimum.get(), end_point, end_inside_poly_min);
+    const bool end_inside_min = moveInside(boundary_inside_minimum, _end_inside, inside_loc_to_line_minimum, end_point, end_inside_poly_min);
 
     unsigned int start_part_boundary_poly_idx_min= NO_INDEX;
     unsigned int end_part_boundary_poly_idx_min= NO_INDEX;
@@ -299,7 +300,7 @@ bool Comb::calc(const ExtruderTrain& train, Point start_point, Point end_point,
 }
 
 // Try to move comb_path_input points inside by the amount of `move_inside_distance` and see if the points are still in boundary_inside_optimal, add result in comb_path_output
-void Comb::moveCombPathInside(Polygons& boundary_inside, Polygons& boundary_inside_optimal, CombPath& comb_path_input, CombPath& comb_path_output)
+void Comb::moveCombPathInside(const Polygons& boundary_inside, const Polygons& boundary_inside_optimal, CombPath& comb_path_input, CombPath& comb_path_output)
 {
     const coord_t dist = move_inside_distance;
     const coord_t dist2 = dist * dist;
@@ -343,7 +344,7 @@ Comb::Crossing::Crossing(const Point& dest_point, const bool dest_is_inside, con
     }
 }
 
-bool Comb::moveInside(Polygons& boundary_inside, bool is_inside, LocToLineGrid* inside_loc_to_line, Point& dest_point, unsigned int& inside_poly)
+bool Comb::moveInside(const Polygons& boundary_inside, bool is_inside, const LocToLineGrid* inside_loc_to_line, Point& dest_point, unsigned int& inside_poly)
 {
     if (is_inside)
     {
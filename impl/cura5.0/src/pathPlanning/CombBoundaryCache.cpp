@@ -0,0 +1,225 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "pathPlanning/CombBoundaryCache.h"
+
+#include <algorithm> // max
+
+#include <boost/container_hash/hash.hpp>
+
+#include "Application.h"
+#include "Slice.h"
+#include "sliceDataStorage.h"
+#include "settings/EnumSettings.h"
+
+namespace cura52
+{
+
+CombBoundaries::CombBoundaries(Polygons&& minimum, Polygons&& preferred, const coord_t comb_boundary_offset)
+: minimum(std::move(minimum))
+, preferred(std::move(preferred))
+, inside_minimum(this->minimum) // copy the boundary, because the partsView_inside will reorder the polygons
+, inside_optimal(this->preferred) // copy the boundary, because the partsView_inside will reorder the polygons
+, partsView_inside_minimum(inside_minimum.splitIntoPartsView()) // WARNING !! changes the order of inside_minimum !!
+, partsView_inside_optimal(inside_optimal.splitIntoPartsView()) // WARNING !! changes the order of inside_optimal !!
+, inside_loc_to_line_minimum(PolygonUtils::createLocToLineGrid(inside_minimum, comb_boundary_offset))
+, inside_loc_to_line_optimal(PolygonUtils::createLocToLineGrid(inside_optimal, comb_boundary_offset))
+{
+}
+
+std::shared_ptr<const CombBoundaries> CombBoundaryCache::get(const SliceDataStorage& storage, const LayerIndex layer_nr, const coord_t comb_boundary_offset, const ComputeFunction& compute)
+{
+    std::vector<const Polygons*> inputs;
+    collectInputs(storage, layer_nr, inputs);
+    const bool is_raft = layer_nr < 0;
+    const size_t hash = hashInputs(inputs, is_raft, comb_boundary_offset);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const CombBoundaries> shared = find(is_raft, comb_boundary_offset, hash, inputs);
+        if (shared)
+        {
+            return shared;
+        }
+    }
+
+    std::shared_ptr<const CombBoundaries> computed = compute();
+    OwnedInputs owned_inputs = copyInputs(inputs);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another layer with the same outlines may have finished computing its boundaries in the meantime.
+    std::shared_ptr<const CombBoundaries> shared = find(is_raft, comb_boundary_offset, hash, inputs);
+    if (shared)
+    {
+        return shared;
+    }
+    if (entries.size() >= next_cleanup_size)
+    {
+        removeExpired();
+        next_cleanup_size = std::max(size_t(64), entries.size() * 2);
+    }
+    entries.emplace(hash, Entry{ is_raft, comb_boundary_offset, std::move(owned_inputs), computed });
+    return computed;
+}
+
+std::shared_ptr<const CombBoundaries> CombBoundaryCache::find(const bool is_raft, const coord_t comb_boundary_offset, const size_t hash, const std::vector<const Polygons*>& inputs)
+{
+    const auto range = entries.equal_range(hash);
+    for (auto it = range.first; it != range.second;)
+    {
+        std::shared_ptr<const CombBoundaries> boundaries = it->second.boundaries.lock();
+        if (! boundaries)
+        {
+            it = entries.erase(it);
+            continue;
+        }
+        const Entry& entry = it->second;
+        if (entry.comb_boundary_offset == comb_boundary_offset && entry.is_raft == is_raft && haveSameInputs(inputs, entry.inputs))
+        {
+            return boundaries;
+        }
+        ++it;
+    }
+    return nullptr;
+}
+
+void CombBoundaryCache::removeExpired()
+{
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.boundaries.expired())
+        {
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void CombBoundaryCache::collectInputs(const SliceDataStorage& storage, const LayerIndex layer_nr, std::vector<const Polygons*>& inputs)
+{
+    // Mirrors the polygons read by LayerPlan::computeCombBoundary.
+    const CombingMode mesh_combing_mode = storage.application->current_slice->scene.current_mesh_group->settings.get<CombingMode>("retraction_combing");
+    if (mesh_combing_mode == CombingMode::OFF || (layer_nr < 0 && mesh_combing_mode == CombingMode::NO_SKIN))
+    {
+        return;
+    }
+    if (layer_nr < 0)
+    {
+        inputs.push_back(&storage.raftOutline);
+        return;
+    }
+    for (const SliceMeshStorage& mesh : storage.meshes)
+    {
+        if (mesh.settings.get<bool>("infill_mesh") && mesh.settings.get<bool>("anti_overhang_mesh"))
+        {
+            continue;
+        }
+        const SliceLayer& layer = mesh.layers[static_cast<size_t>(layer_nr)];
+        const CombingMode combing_mode = mesh.settings.get<CombingMode>("retraction_combing");
+        for (const SliceLayerPart& part : layer.parts)
+        {
+            switch (combing_mode)
+            {
+            case CombingMode::ALL:
+            case CombingMode::NO_OUTER_SURFACES:
+                inputs.push_back(&part.outline);
+                break;
+            case CombingMode::NO_SKIN:
+                inputs.push_back(&part.outline);
+                inputs.push_back(&part.inner_area);
+                inputs.push_back(&part.infill_area);
+                break;
+            case CombingMode::INFILL:
+                inputs.push_back(&part.infill_area);
+                break;
+            default:
+                break;
+            }
+        }
+        if (combing_mode == CombingMode::NO_OUTER_SURFACES)
+        {
+            for (const SliceLayerPart& part : layer.parts)
+            {
+                for (const SkinPart& skin_part : part.skin_parts)
+                {
+                    inputs.push_back(&skin_part.top_most_surface_fill);
+                    inputs.push_back(&skin_part.bottom_most_surface_fill);
+                }
+            }
+        }
+        inputs.push_back(nullptr);
+    }
+}
+
+size_t CombBoundaryCache::hashInputs(const std::vector<const Polygons*>& inputs, const bool is_raft, const coord_t comb_boundary_offset)
+{
+    size_t hash = 0;
+    boost::hash_combine(hash, is_raft);
+    boost::hash_combine(hash, comb_boundary_offset);
+    for (const Polygons* polygons : inputs)
+    {
+        if (! polygons)
+        {
+            boost::hash_combine(hash, size_t(-1));
+            continue;
+        }
+        boost::hash_combine(hash, polygons->size());
+        for (ConstPolygonRef poly : *polygons)
+        {
+            boost::hash_combine(hash, poly.size());
+            for (const Point& p : poly)
+            {
+                boost::hash_combine(hash, p.X);
+                boost::hash_combine(hash, p.Y);
+            }
+        }
+    }
+    return hash;
+}
+
+CombBoundaryCache::OwnedInputs CombBoundaryCache::copyInputs(const std::vector<const Polygons*>& inputs)
+{
+    OwnedInputs owned;
+    owned.reserve(inputs.size());
+    for (const Polygons* polygons : inputs)
+    {
+        if (polygons)
+        {
+            owned.emplace_back(*polygons);
+        }
+        else
+        {
+            owned.emplace_back(std::nullopt);
+        }
+    }
+    return owned;
+}
+
+bool CombBoundaryCache::haveSameInputs(const std::vector<const Polygons*>& inputs, const OwnedInputs& owned)
+{
+    if (inputs.size() != owned.size())
+    {
+        return false;
+    }
+    for (size_t input_idx = 0; input_idx < inputs.size(); input_idx++)
+    {
+        if (inputs[input_idx] == nullptr || ! owned[input_idx])
+        {
+            if ((inputs[input_idx] == nullptr) != ! owned[input_idx])
+            {
+                return false;
+            }
+            continue;
+        }
+        if (inputs[input_idx]->paths != owned[input_idx]->paths)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace cura52
@@ -63,8 +63,10 @@ void Progress::init()
 
 void Progress::messageProgress(Progress::Stage stage, int progress_in_stage, int progress_in_stage_max)
 {
-    float percentage = calcOverallProgress(stage, float(progress_in_stage) / float(progress_in_stage_max));
+    const float stage_progress = float(progress_in_stage) / float(progress_in_stage_max);
+    float percentage = calcOverallProgress(stage, stage_progress);
     application->sendProgress(percentage);
+    application->notifyProgress(stage, stage_progress, percentage);
 
     // logProgress(names[(int)stage].c_str(), progress_in_stage, progress_in_stage_max, percentage); FIXME: use different sink
 }
@@ -86,6 +88,7 @@ void Progress::messageProgressStage(Progress::Stage stage)
     {
         LOGI("Starting { %s }...", names[(int)stage].c_str());
     }
+    application->notifyProgress(stage, 0.0f, calcOverallProgress(stage, 0.0f));
 }
 
 }// namespace cura52
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "settings/EnumSettingsT.h"
 #include "settings/FlowTempGraph.h"
 #include "settings/Settings.h"
+#include "settings/SharedSettings.h"
 #include "settings/types/Angle.h"
 #include "settings/types/Duration.h" //For duration and time settings.
 #include "settings/types/LayerIndex.h" //For layer index settings.
@@ -47,34 +48,62 @@ void Settings::add(const std::string& key, const std::string value)
     }
 }
 
-template<>
-std::string Settings::get<std::string>(const std::string& key) const
+const std::string& Settings::lookup(const std::string& key, const double** number, const bool limit) const
 {
     // If this settings base has a setting value for it, look that up.
-    if (settings.find(key) != settings.end())
+    const auto own = settings.find(key);
+    if (own != settings.end())
     {
-        return settings.at(key);
+        if (number)
+        {
+            *number = nullptr;
+        }
+        return own->second;
+    }
+    if (shared)
+    {
+        const SharedSettings::Value* value = shared->find(key);
+        if (value)
+        {
+            if (number)
+            {
+                *number = &value->number;
+            }
+            return value->serialised;
+        }
     }
 
-    const std::unordered_map<std::string, ExtruderTrain*>& limit_to_extruder = application->current_slice->scene.limit_to_extruder;
-    if (limit_to_extruder.find(key) != limit_to_extruder.end())
+    if (limit)
     {
-        return limit_to_extruder.at(key)->settings.getWithoutLimiting(key);
+        const std::unordered_map<std::string, ExtruderTrain*>& limit_to_extruder = application->current_slice->scene.limit_to_extruder;
+        const auto extruder = limit_to_extruder.find(key);
+        if (extruder != limit_to_extruder.end())
+        {
+            return extruder->second->settings.lookup(key, number, false);
+        }
     }
 
     if (parent)
     {
-        return parent->get<std::string>(key);
+        return parent->lookup(key, number, true);
     }
 
     LOGE("Trying to retrieve setting with no value given: %s", key.c_str());
     std::exit(2);
 }
 
+template<>
+std::string Settings::get<std::string>(const std::string& key) const
+{
+    return lookup(key, nullptr, true);
+}
+
 template<>
 double Settings::get<double>(const std::string& key) const
 {
-    return atof(get<std::string>(key).c_str());
+    const double* number;
+    const std::string& value = lookup(key, &number, true);
+    return number ? *number : atof(value.c_str()); // Shared values were read as a number once, when they were added.
 }
 
 template<>
@@ -870,6 +899,19 @@ const std::string Settings::getAllSettingsString() const
         snprintf(buffer, 4096, " -s %s=\"%s\"", pair.first.c_str(), Escaped{ pair.second.c_str() }.str);
         sstream << buffer;
     }
+    if (shared)
+    {
+        for (const auto& pair : shared->getValues())
+        {
+            if (settings.find(pair.first) != settings.end())
+            {
+                continue; // Overridden.
+            }
+            char buffer[4096];
+            snprintf(buffer, 4096, " -s %s=\"%s\"", pair.first.c_str(), Escaped{ pair.second.serialised.c_str() }.str);
+            sstream << buffer;
+        }
+    }
     return sstream.str();
 }
 
@@ -877,6 +919,8 @@ bool Settings::has(const std::string& key) const
 {
     if (settings.find(key) != settings.end())
         return true;
+    if (shared && shared->find(key))
+        return true;
 
     if (parent)
         return parent->has(key);
@@ -888,21 +932,14 @@ void Settings::setParent(Settings* new_parent)
     parent = new_parent;
 }
 
+void Settings::setShared(std::shared_ptr<const SharedSettings> new_shared)
+{
+    shared = std::move(new_shared);
+}
+
 std::string Settings::getWithoutLimiting(const std::string& key) const
 {
-    if (settings.find(key) != settings.end())
-    {
-        return settings.at(key);
-    }
-    else if (parent)
-    {
-        return parent->get<std::string>(key);
-    }
-    else
-    {
-        LOGE("Trying to retrieve setting with no value given: {}", key.c_str());
-        std::exit(2);
-    }
+    return lookup(key, nullptr, false);
 }
 
 } // namespace cura52
@@ -0,0 +1,27 @@
+// Copyright (c) 2022 Ultimaker B.V.
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <cstdlib> // atof
+
+#include "settings/SharedSettings.h"
+
+namespace cura52
+{
+
+void SharedSettings::add(const std::string& key, const std::string& value)
+{
+    values[key] = Value{ value, atof(value.c_str()) };
+}
+
+const SharedSettings::Value* SharedSettings::find(const std::string& key) const
+{
+    const auto value = values.find(key);
+    return value != values.end() ? &value->second : nullptr;
+}
+
+const std::unordered_map<std::string, SharedSettings::Value>& SharedSettings::getValues() const
+{
+    return values;
+}
+
+} // namespace cura52
@@ -49,6 +49,16 @@ const Polygons& SliceLayerPart::getOwnInfillArea() const
     }
 }
 
+std::shared_ptr<const Polygons> SliceLayerPart::getOutlineOffset(const coord_t distance, const PolygonOffsetCache::Stage stage, PolygonOffsetCache::Budget& budget, const ClipperLib::JoinType join_type, const double miter_limit) const
+{
+    return outline_offsets.offset(outline, distance, join_type, miter_limit, stage, budget);
+}
+
+std::shared_ptr<const Polygons> SliceLayerPart::getOwnInfillAreaOffset(const coord_t distance, const PolygonOffsetCache::Stage stage, PolygonOffsetCache::Budget& budget, const ClipperLib::JoinType join_type, const double miter_limit) const
+{
+    return infill_area_offsets.offset(getOwnInfillArea(), distance, join_type, miter_limit, stage, budget);
+}
+
 bool SliceLayerPart::hasWallAtInsetIndex(size_t inset_idx) const
 {
     for (const VariableWidthLines& lines : wall_toolpaths)
@@ -260,6 +270,58 @@ Point SliceMeshStorage::getZSeamHint() const
     return pos;
 }
 
+double SliceMeshStorage::getLayerCost(const LayerIndex layer_nr) const
+{
+    if (layer_nr < 0 || layer_nr >= static_cast<LayerIndex>(layers.size()))
+    {
+        return 0;
+    }
+    size_t vertex_count = 0;
+    for (const SliceLayerPart& part : layers[layer_nr].parts)
+    {
+        vertex_count += part.outline.pointCount();
+    }
+    return static_cast<double>(vertex_count);
+}
+
+std::vector<double> SliceMeshStorage::getLayerCosts() const
+{
+    std::vector<double> costs(layers.size());
+    for (size_t layer_nr = 0; layer_nr < layers.size(); layer_nr++)
+    {
+        costs[layer_nr] = 1 + getLayerCost(layer_nr);
+    }
+    return costs;
+}
+
+std::vector<double> SliceDataStorage::getLayerCosts(const LayerIndex first, const LayerIndex last) const
+{
+    std::vector<double> costs;
+    for (LayerIndex layer_nr = first; layer_nr < last; layer_nr++)
+    {
+        double cost = 1;
+        if (layer_nr < 0)
+        {
+            cost += raftOutline.pointCount();
+        }
+        for (const SliceMeshStorage& mesh : meshes)
+        {
+            cost += mesh.getLayerCost(layer_nr);
+        }
+        if (layer_nr >= 0 && layer_nr < static_cast<LayerIndex>(support.supportLayers.size()))
+        {
+            const SupportLayer& support_layer = support.supportLayers[layer_nr];
+            for (const SupportInfillPart& part : support_layer.support_infill_parts)
+            {
+                cost += part.outline.pointCount();
+            }
+            cost += support_layer.support_roof.pointCount() + support_layer.support_bottom.pointCount();
+        }
+        costs.push_back(cost);
+    }
+    return costs;
+}
+
 std::vector<RetractionConfig> SliceDataStorage::initializeRetractionConfigs()
 {
     std::vector<RetractionConfig> ret;
@@ -16,7 +16,6 @@
 #include "utils/SparsePointGridInclusive.h"
 #include "utils/ThreadPool.h"
 #include "utils/gettime.h"
-#include "trimesh2/Vec.h"
 
 
 
@@ -38,6 +37,7 @@ void SlicerLayer::makeBasicPolygonLoops(Polygons& open_polylines)
     }
     // Clear the segmentList to save memory, it is no longer needed after this point.
     segments.clear();
+    std::vector<int>().swap(next_segment_candidates);
 }
 
 void SlicerLayer::makeBasicPolygonLoop(Polygons& open_polylines, const size_t start_segment_idx)
@@ -61,28 +61,21 @@ void SlicerLayer::makeBasicPolygonLoop(Polygons& open_polylines, const size_t st
     open_polylines.add(poly);
 }
 
-int SlicerLayer::tryFaceNextSegmentIdx(const SlicerSegment& segment, const int face_idx, const size_t start_segment_idx) const
+int SlicerLayer::tryNextSegmentIdx(const SlicerSegment& segment, const int candidate_segment_idx, const size_t start_segment_idx) const
 {
-    decltype(face_idx_to_segment_idx.begin()) it;
-    auto it_end = face_idx_to_segment_idx.end();
-    it = face_idx_to_segment_idx.find(face_idx);
-    if (it != it_end)
+    Point p1 = segments[candidate_segment_idx].start;
+    Point diff = segment.end - p1;
+    if (shorterThen(diff, largest_neglected_gap_first_phase))
     {
-        const int segment_idx = (*it).second;
-        Point p1 = segments[segment_idx].start;
-        Point diff = segment.end - p1;
-        if (shorterThen(diff, largest_neglected_gap_first_phase))
+        if (candidate_segment_idx == static_cast<int>(start_segment_idx))
         {
-            if (segment_idx == static_cast<int>(start_segment_idx))
-            {
-                return start_segment_idx;
-            }
-            if (segments[segment_idx].addedToPolygon)
-            {
-                return -1;
-            }
-            return segment_idx;
+            return start_segment_idx;
+        }
+        if (segments[candidate_segment_idx].addedToPolygon)
+        {
+            return -1;
         }
+        return candidate_segment_idx;
     }
 
     return -1;
@@ -92,33 +85,18 @@ int SlicerLayer::getNextSegmentIdx(const SlicerSegment& segment, const size_t st
 {
     int next_segment_idx = -1;
 
-    const bool segment_ended_at_edge = segment.endVertex == nullptr;
-    if (segment_ended_at_edge)
+    // One candidate if the segment ended at an edge, those of all faces around the vertex if it ended at a vertex.
+    for (uint32_t candidate_idx = segment.nextCandidatesBegin; candidate_idx < segment.nextCandidatesEnd; candidate_idx++)
     {
-        const int face_to_try = segment.endOtherFaceIdx;
-        if (face_to_try == -1)
+        const int result_segment_idx = tryNextSegmentIdx(segment, next_segment_candidates[candidate_idx], start_segment_idx);
+        if (result_segment_idx == static_cast<int>(start_segment_idx))
         {
-            return -1;
+            return start_segment_idx;
         }
-        return tryFaceNextSegmentIdx(segment, face_to_try, start_segment_idx);
-    }
-    else
-    {
-        // segment ended at vertex
-
-        const std::vector<uint32_t>& faces_to_try = segment.endVertex->connected_faces;
-        for (int face_to_try : faces_to_try)
+        else if (result_segment_idx != -1)
         {
-            const int result_segment_idx = tryFaceNextSegmentIdx(segment, face_to_try, start_segment_idx);
-            if (result_segment_idx == static_cast<int>(start_segment_idx))
-            {
-                return start_segment_idx;
-            }
-            else if (result_segment_idx != -1)
-            {
-                // not immediately returned since we might still encounter the start_segment_idx
-                next_segment_idx = result_segment_idx;
-            }
+            // not immediately returned since we might still encounter the start_segment_idx
+            next_segment_idx = result_segment_idx;
         }
     }
 
@@ -949,15 +927,63 @@ void Slicer::buildSegments(Application* application, const Mesh& mesh, const std
                                }
 
                                // store the segments per layer
-                               layer.face_idx_to_segment_idx.insert(std::make_pair(mesh_idx, layer.segments.size()));
                                s.faceIndex = mesh_idx;
                                s.endOtherFaceIdx = face.connected_face_index[end_edge_idx];
                                s.addedToPolygon = false;
                                layer.segments.push_back(s);
                            }
+
+                           linkSegments(mesh, layer);
                        });
 }
 
+void Slicer::linkSegments(const Mesh& mesh, SlicerLayer& layer)
+{
+    // Every face makes at most one segment per layer. Map faces to their segment through an array over all faces of
+    // the mesh, which is kept per thread and reset after each layer, so that only the touched entries are written.
+    static thread_local std::vector<int> face_to_segment;
+    if (face_to_segment.size() < mesh.faces.size())
+    {
+        face_to_segment.resize(mesh.faces.size(), -1);
+    }
+    for (size_t segment_idx = 0; segment_idx < layer.segments.size(); segment_idx++)
+    {
+        face_to_segment[layer.segments[segment_idx].faceIndex] = static_cast<int>(segment_idx);
+    }
+
+    std::vector<int>& candidates = layer.next_segment_candidates;
+    candidates.clear();
+    candidates.reserve(layer.segments.size());
+    for (SlicerSegment& segment : layer.segments)
+    {
+        segment.nextCandidatesBegin = static_cast<uint32_t>(candidates.size());
+        if (segment.endVertex == nullptr)
+        {
+            if (segment.endOtherFaceIdx != -1 && face_to_segment[segment.endOtherFaceIdx] != -1)
+            {
+                candidates.push_back(face_to_segment[segment.endOtherFaceIdx]);
+            }
+        }
+        else
+        {
+            // Keep the order of the faces around the vertex: loop tracing prefers the last continuation it finds.
+            for (const uint32_t face_idx : segment.endVertex->connected_faces)
+            {
+                if (face_to_segment[face_idx] != -1)
+                {
+                    candidates.push_back(face_to_segment[face_idx]);
+                }
+            }
+        }
+        segment.nextCandidatesEnd = static_cast<uint32_t>(candidates.size());
+    }
+
+    for (const SlicerSegment& segment : layer.segments)
+    {
+        face_to_segment[segment.faceIndex] = -1;
+    }
+}
+
 std::vector<SlicerLayer>
     Slicer::buildLayersWithHeight(size_t slice_layer_count, SlicingTolerance slicing_tolerance, coord_t initial_layer_thickness, coord_t thickness, bool use_variable_layer_heights, const std::vector<AdaptiveLayer>* adaptive_layers)
 {
@@ -1047,70 +1073,33 @@ void Slicer::makePolygons(Application* application, Mesh& mesh, SlicingTolerance
 
 void Slicer::processPolygons(Application* application,const Mesh& mesh, std::vector<SlicerLayer>& layers)
 {
-    std::string ploygonFile = application->current_slice->ploygonFile;
-
-    std::vector<std::vector<trimesh::vec2>> ploys;
-    auto readPloygon = [](const std::string& ploygonFile, std::vector<std::vector<trimesh::vec2>>& ploys)
-    {
-        std::fstream in(ploygonFile, std::ios::in | std::ios::binary);
-        if (in.is_open())
-        {
-            int pNum = 0;
-            in.read((char*)&pNum, sizeof(int));
-            if (pNum > 0)
-            {
-                ploys.resize(pNum);
-                for (int i = 0; i < pNum; ++i)
-                {
-                    int num = 0;
-                    in.read((char*)&num, sizeof(int));
-                    ploys[i].resize(num);
-                    //in.read((char*)&ploys.at(i), sizeof(trimesh::vec2) * num);
-                    for (int j = 0; j < num; j++)
-                    {
-                        in.read((char*)&ploys[i][j].x, sizeof(float));
-                        in.read((char*)&ploys[i][j].y, sizeof(float));
-                    }
-                }
-            }
-        }
-    };
-
-    readPloygon(ploygonFile, ploys);
-    if (ploys.empty())
+    const SplitPolygons& split = application->current_slice->getSplitPolygons(mesh.settings);
+    if (split.polygons.empty())
     {
         return;
     }
-    Polygons ploygon;
-    for (auto& ploy :  ploys)
-    {
-        ClipperLib::Path path;
-        for (auto& point : ploy)
-        {
-            path.push_back(ClipperLib::IntPoint(MM2INT(point.x), MM2INT(point.y)));
-        }
-        if (!path.empty())
-        {
-            ploygon.add(path);
-        }
-    }
-
-    //double c_gap = 500;
-    const coord_t c_gap = mesh.settings.get<coord_t>("mesh_split_gap");
-
-    auto getPloygons = [&c_gap](Polygons& ploygon)
-    {
-        ClipperLib::ClipperOffset clipper;
-        clipper.AddPaths(ploygon.paths, ClipperLib::JoinType::jtSquare, ClipperLib::etOpenSquare);
-        clipper.Execute(ploygon.paths, c_gap);
-    };
-    getPloygons(ploygon);
-
-    for (SlicerLayer& layer : layers)
-    {
-        layer.polygons = layer.polygons.difference(ploygon);
-    }
 
+    cura52::parallel_for<size_t>(application, 0,
+                               layers.size(),
+                               [&split, &layers](size_t layer_nr)
+                               {
+                                   Polygons& polygons = layers[layer_nr].polygons;
+                                   if (polygons.empty())
+                                   {
+                                       return;
+                                   }
+                                   // Split polygons outside of the layer can't change the difference, leave them out of the clipper.
+                                   const AABB layer_box(polygons);
+                                   Polygons touching;
+                                   for (size_t path_idx = 0; path_idx < split.path_boxes.size(); path_idx++)
+                                   {
+                                       if (split.path_boxes[path_idx].hit(layer_box))
+                                       {
+                                           touching.add(split.polygons[path_idx]);
+                                       }
+                                   }
+                                   polygons = polygons.difference(touching);
+                               });
 }
 
 std::vector<std::pair<int32_t, int32_t>> Slicer::buildZHeightsForFaces(const Mesh& mesh)
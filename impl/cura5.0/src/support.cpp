@@ -465,6 +465,92 @@ void AreaSupport::cleanup(SliceDataStorage& storage)
 }
 
 Polygons AreaSupport::join(const SliceDataStorage& storage, const Polygons& supportLayer_up, Polygons& supportLayer_this, const coord_t smoothing_distance)
+{
+    return join(storage, supportLayer_up, supportLayer_this, smoothing_distance, getConicalSupportBorder(storage));
+}
+
+Polygons AreaSupport::getConicalSupportBorder(const SliceDataStorage& storage)
+{
+    const Settings& infill_settings = storage.application->current_slice->scene.current_mesh_group->settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings;
+    const AngleRadians conical_support_angle = infill_settings.get<AngleRadians>("support_conical_angle");
+    const bool conical_support = infill_settings.get<bool>("support_conical_enabled") && conical_support_angle != 0;
+    if (! conical_support)
+    {
+        return Polygons();
+    }
+
+    const Settings& mesh_group_settings = storage.application->current_slice->scene.current_mesh_group->settings;
+    // Don't go outside the build volume.
+    Polygons machine_volume_border;
+    switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"))
+    {
+    case BuildPlateShape::ELLIPTIC:
+    {
+        // Construct an ellipse to approximate the build volume.
+        const coord_t width = storage.machine_size.max.x - storage.machine_size.min.x;
+        const coord_t depth = storage.machine_size.max.y - storage.machine_size.min.y;
+        Polygon border_circle;
+        constexpr unsigned int circle_resolution = 50;
+        for (unsigned int i = 0; i < circle_resolution; i++)
+        {
+            const AngleRadians angle = TAU * i / circle_resolution;
+            const Point3 machine_middle = storage.machine_size.getMiddle();
+            const coord_t x = machine_middle.x + cos(angle) * width / 2;
+            const coord_t y = machine_middle.y + sin(angle) * depth / 2;
+            border_circle.emplace_back(x, y);
+        }
+        machine_volume_border.add(border_circle);
+        break;
+    }
+    case BuildPlateShape::RECTANGULAR:
+    default:
+        machine_volume_border.add(storage.machine_size.flatten().toPolygon());
+        break;
+    }
+    coord_t adhesion_size = 0; // Make sure there is enough room for the platform adhesion around support.
+    const ExtruderTrain& skirt_brim_extruder = mesh_group_settings.get<ExtruderTrain&>("skirt_brim_extruder_nr");
+    coord_t extra_skirt_line_width = 0;
+    const std::vector<bool> is_extruder_used = storage.getExtrudersUsed();
+    for (size_t extruder_nr = 0; extruder_nr < storage.application->current_slice->scene.extruders.size(); extruder_nr++)
+    {
+        if (extruder_nr == skirt_brim_extruder.extruder_nr || ! is_extruder_used[extruder_nr]) // Unused extruders and the primary adhesion extruder don't generate an extra skirt line.
+        {
+            continue;
+        }
+        const ExtruderTrain& other_extruder = storage.application->current_slice->scene.extruders[extruder_nr];
+        extra_skirt_line_width += other_extruder.settings.get<coord_t>("skirt_brim_line_width") * other_extruder.settings.get<Ratio>("initial_layer_line_width_factor");
+    }
+    switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"))
+    {
+    case EPlatformAdhesion::BRIM:
+        adhesion_size = skirt_brim_extruder.settings.get<coord_t>("brim_width")
+                      + skirt_brim_extruder.settings.get<coord_t>("skirt_brim_line_width") * skirt_brim_extruder.settings.get<size_t>("brim_line_count") * skirt_brim_extruder.settings.get<Ratio>("initial_layer_line_width_factor")
+                      + extra_skirt_line_width;
+        break;
+    case EPlatformAdhesion::RAFT:
+    case EPlatformAdhesion::SIMPLERAFT:
+    {
+        adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings.get<coord_t>("raft_margin"),
+                                   mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings.get<coord_t>("raft_margin"),
+                                   mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings.get<coord_t>("raft_margin") });
+        break;
+    }
+    case EPlatformAdhesion::SKIRT:
+        adhesion_size = skirt_brim_extruder.settings.get<coord_t>("skirt_gap")
+                      + skirt_brim_extruder.settings.get<coord_t>("skirt_brim_line_width") * skirt_brim_extruder.settings.get<Ratio>("initial_layer_line_width_factor") * skirt_brim_extruder.settings.get<size_t>("skirt_line_count")
+                      + extra_skirt_line_width;
+        break;
+    case EPlatformAdhesion::NONE:
+        adhesion_size = 0;
+        break;
+    default: // Also use 0.
+        LOGI("Unknown platform adhesion type! Please implement the width of the platform adhesion here.");
+        break;
+    }
+    return machine_volume_border.offset(-adhesion_size);
+}
+
+Polygons AreaSupport::join(const SliceDataStorage& storage, const Polygons& supportLayer_up, Polygons& supportLayer_this, const coord_t smoothing_distance, const Polygons& machine_volume_border)
 {
     Polygons joined;
 
@@ -483,76 +569,6 @@ Polygons AreaSupport::join(const SliceDataStorage& storage, const Polygons& supp
     const bool conical_support = infill_settings.get<bool>("support_conical_enabled") && conical_support_angle != 0;
     if (conical_support)
     {
-        const Settings& mesh_group_settings = storage.application->current_slice->scene.current_mesh_group->settings;
-        // Don't go outside the build volume.
-        Polygons machine_volume_border;
-        switch (mesh_group_settings.get<BuildPlateShape>("machine_shape"))
-        {
-        case BuildPlateShape::ELLIPTIC:
-        {
-            // Construct an ellipse to approximate the build volume.
-            const coord_t width = storage.machine_size.max.x - storage.machine_size.min.x;
-            const coord_t depth = storage.machine_size.max.y - storage.machine_size.min.y;
-            Polygon border_circle;
-            constexpr unsigned int circle_resolution = 50;
-            for (unsigned int i = 0; i < circle_resolution; i++)
-            {
-                const AngleRadians angle = TAU * i / circle_resolution;
-                const Point3 machine_middle = storage.machine_size.getMiddle();
-                const coord_t x = machine_middle.x + cos(angle) * width / 2;
-                const coord_t y = machine_middle.y + sin(angle) * depth / 2;
-                border_circle.emplace_back(x, y);
-            }
-            machine_volume_border.add(border_circle);
-            break;
-        }
-        case BuildPlateShape::RECTANGULAR:
-        default:
-            machine_volume_border.add(storage.machine_size.flatten().toPolygon());
-            break;
-        }
-        coord_t adhesion_size = 0; // Make sure there is enough room for the platform adhesion around support.
-        const ExtruderTrain& skirt_brim_extruder = mesh_group_settings.get<ExtruderTrain&>("skirt_brim_extruder_nr");
-        coord_t extra_skirt_line_width = 0;
-        const std::vector<bool> is_extruder_used = storage.getExtrudersUsed();
-        for (size_t extruder_nr = 0; extruder_nr < storage.application->current_slice->scene.extruders.size(); extruder_nr++)
-        {
-            if (extruder_nr == skirt_brim_extruder.extruder_nr || ! is_extruder_used[extruder_nr]) // Unused extruders and the primary adhesion extruder don't generate an extra skirt line.
-            {
-                continue;
-            }
-            const ExtruderTrain& other_extruder = storage.application->current_slice->scene.extruders[extruder_nr];
-            extra_skirt_line_width += other_extruder.settings.get<coord_t>("skirt_brim_line_width") * other_extruder.settings.get<Ratio>("initial_layer_line_width_factor");
-        }
-        switch (mesh_group_settings.get<EPlatformAdhesion>("adhesion_type"))
-        {
-        case EPlatformAdhesion::BRIM:
-            adhesion_size = skirt_brim_extruder.settings.get<coord_t>("brim_width")
-                          + skirt_brim_extruder.settings.get<coord_t>("skirt_brim_line_width") * skirt_brim_extruder.settings.get<size_t>("brim_line_count") * skirt_brim_extruder.settings.get<Ratio>("initial_layer_line_width_factor")
-                          + extra_skirt_line_width;
-            break;
-        case EPlatformAdhesion::RAFT:
-        case EPlatformAdhesion::SIMPLERAFT:
-        {
-            adhesion_size = std::max({ mesh_group_settings.get<ExtruderTrain&>("raft_base_extruder_nr").settings.get<coord_t>("raft_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_interface_extruder_nr").settings.get<coord_t>("raft_margin"),
-                                       mesh_group_settings.get<ExtruderTrain&>("raft_surface_extruder_nr").settings.get<coord_t>("raft_margin") });
-            break;
-        }
-        case EPlatformAdhesion::SKIRT:
-            adhesion_size = skirt_brim_extruder.settings.get<coord_t>("skirt_gap")
-                          + skirt_brim_extruder.settings.get<coord_t>("skirt_brim_line_width") * skirt_brim_extruder.settings.get<Ratio>("initial_layer_line_width_factor") * skirt_brim_extruder.settings.get<size_t>("skirt_line_count")
-                          + extra_skirt_line_width;
-            break;
-        case EPlatformAdhesion::NONE:
-            adhesion_size = 0;
-            break;
-        default: // Also use 0.
-            LOGI("Unknown platform adhesion type! Please implement the width of the platform adhesion here.");
-            break;
-        }
-        machine_volume_border = machine_volume_border.offset(-adhesion_size);
-
         const coord_t conical_smallest_breadth = infill_settings.get<coord_t>("support_conical_min_width");
         Polygons insetted = supportLayer_up.offset(-conical_smallest_breadth / 2);
         Polygons small_parts = supportLayer_up.difference(insetted.offset(conical_smallest_breadth / 2 + 20));
@@ -636,7 +652,7 @@ bool AreaSupport::isSupportNecessary(SliceDataStorage& storage)
                     continue;
                 }
 
-                const Polygons overhang = part.outline.offset(offset).difference(storage.support.supportLayers[layer_idx].anti_overhang);
+                const Polygons overhang = part.getOutlineOffset(offset, PolygonOffsetCache::Stage::SUPPORT, storage.application->current_slice->offset_cache_budget)->difference(storage.support.supportLayers[layer_idx].anti_overhang);
                 if (overhang.empty())
                 {
                     return true;
@@ -1107,13 +1123,17 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
     const coord_t support_line_width = mesh_group_settings.get<ExtruderTrain&>("support_infill_extruder_nr").settings.get<coord_t>("support_line_width");
     const double sloped_areas_angle = mesh.settings.get<AngleRadians>("support_bottom_stair_step_min_slope");
     const coord_t sloped_area_detection_width = 10 + static_cast<coord_t>(layer_thickness / std::tan(sloped_areas_angle)) / 2;
-    xy_disallowed_per_layer[0] = storage.getLayerOutlines(0, no_support, no_prime_tower).offset(xy_distance);
+    std::vector<Polygons> outlines_per_layer; // Kept for the serial propagation below, which would otherwise recompute them several times per layer.
+    outlines_per_layer.resize(layer_count);
+    outlines_per_layer[0] = storage.getLayerOutlines(0, no_support, no_prime_tower);
+    xy_disallowed_per_layer[0] = outlines_per_layer[0].offset(xy_distance);
 
     cura52::parallel_for<size_t>(storage.application, 1,
                                layer_count,
                                [&](const size_t layer_idx)
                                {
-                                   const Polygons outlines = storage.getLayerOutlines(layer_idx, no_support, no_prime_tower);
+                                   outlines_per_layer[layer_idx] = storage.getLayerOutlines(layer_idx, no_support, no_prime_tower);
+                                   const Polygons& outlines = outlines_per_layer[layer_idx];
 
                                    // Build sloped areas. We need this for the stair-stepping later on.
                                    // Specifically, sloped areass are used in 'moveUpFromModel' to prevent a stair step happening over an area where there isn't a slope.
@@ -1239,19 +1259,44 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
             bottom_stair_step_layer_count);
     }
 
-    for (size_t layer_idx = layer_count - 1 - layer_z_distance_top; layer_idx != static_cast<size_t>(-1); layer_idx--)
-    {
-        Polygons layer_this = mesh.full_overhang_areas[layer_idx + layer_z_distance_top];
+    const size_t top_support_layer_idx = layer_count - 1 - layer_z_distance_top;
 
-        if (extension_offset && ! is_support_mesh_place_holder)
+    // Everything that doesn't depend on the support of the layer above is computed up front, in parallel,
+    // so that the serial propagation from the top down only has to join each layer with the one above.
+    std::vector<Polygons> overhang_per_layer;
+    overhang_per_layer.resize(top_support_layer_idx + 1);
+    cura52::parallel_for<size_t>(storage.application,
+        0,
+        top_support_layer_idx + 1,
+        [&](const size_t layer_idx)
         {
-            layer_this = layer_this.offset(extension_offset);
-        }
+            Polygons& layer_this = overhang_per_layer[layer_idx];
+            layer_this = mesh.full_overhang_areas[layer_idx + layer_z_distance_top];
+
+            if (extension_offset && ! is_support_mesh_place_holder)
+            {
+                layer_this = layer_this.offset(extension_offset);
+            }
+
+            if (use_towers && ! is_support_mesh_place_holder)
+            {
+                // handle straight walls
+                AreaSupport::handleWallStruts(infill_settings, layer_this);
+            }
+
+            if (is_support_mesh_nondrop_place_holder && layer_idx + 1 < layer_count)
+            { // Only where the layer is joined with the layer above, like the serial loop below.
+                layer_this = layer_this.unionPolygons(storage.support.supportLayers[layer_idx].support_mesh);
+            }
+        });
+
+    const Polygons conical_support_border = AreaSupport::getConicalSupportBorder(storage);
+    for (size_t layer_idx = top_support_layer_idx; layer_idx != static_cast<size_t>(-1); layer_idx--)
+    {
+        Polygons& layer_this = overhang_per_layer[layer_idx];
 
         if (use_towers && ! is_support_mesh_place_holder)
         {
-            // handle straight walls
-            AreaSupport::handleWallStruts(infill_settings, layer_this);
             // handle towers
             AreaSupport::handleTowers(infill_settings, layer_this, tower_roofs, mesh.overhang_points, layer_idx, layer_count);
         }
@@ -1259,14 +1304,9 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
         if (layer_idx + 1 < layer_count)
         { // join with support from layer up
             const Polygons empty;
-            const Polygons* layer_above = (layer_idx < support_areas.size()) ? &support_areas[layer_idx + 1] : &empty;
-            const Polygons model_mesh_on_layer = (layer_idx > 0) && ! is_support_mesh_nondrop_place_holder ? storage.getLayerOutlines(layer_idx, no_support, no_prime_tower) : empty;
-            if (is_support_mesh_nondrop_place_holder)
-            {
-                layer_above = &empty;
-                layer_this = layer_this.unionPolygons(storage.support.supportLayers[layer_idx].support_mesh);
-            }
-            layer_this = AreaSupport::join(storage, *layer_above, layer_this, smoothing_distance).difference(model_mesh_on_layer);
+            const Polygons* layer_above = (layer_idx < support_areas.size() && ! is_support_mesh_nondrop_place_holder) ? &support_areas[layer_idx + 1] : &empty;
+            const Polygons& model_mesh_on_layer = (layer_idx > 0) && ! is_support_mesh_nondrop_place_holder ? outlines_per_layer[layer_idx] : empty;
+            layer_this = AreaSupport::join(storage, *layer_above, layer_this, smoothing_distance, conical_support_border).difference(model_mesh_on_layer);
         }
 
         // make towers for small support
@@ -1283,9 +1323,7 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
                         const Polygons& layer_above = support_areas[layer_idx + tower_top_layer_count];
                         const Point middle = AABB(poly).getMiddle();
                         const bool has_support_above = layer_above.inside(middle);
-                        constexpr bool no_support = false;
-                        constexpr bool no_prime_tower = false;
-                        const bool has_model_below = storage.getLayerOutlines(layer_idx - tower_top_layer_count - bottom_empty_layer_count, no_support, no_prime_tower).inside(middle);
+                        const bool has_model_below = outlines_per_layer[layer_idx - tower_top_layer_count - bottom_empty_layer_count].inside(middle);
                         if (has_support_above && ! has_model_below)
                         {
                             Polygons tiny_tower_here;
@@ -1303,24 +1341,28 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
         }
 
         // Move up from model, handle stair-stepping.
-        moveUpFromModel(storage, stair_removal, sloped_areas_per_layer[layer_idx], layer_this, layer_idx, bottom_empty_layer_count, bottom_stair_step_layer_count, bottom_stair_step_width);
+        moveUpFromModel(outlines_per_layer, stair_removal, sloped_areas_per_layer[layer_idx], layer_this, layer_idx, bottom_empty_layer_count, bottom_stair_step_layer_count, bottom_stair_step_width);
 
-        support_areas[layer_idx] = layer_this;
+        support_areas[layer_idx] = std::move(layer_this);
         storage.application->progressor.messageProgress(Progress::Stage::SUPPORT, layer_count * (mesh_idx + 1) - layer_idx, layer_count * storage.meshes.size());
     }
+    overhang_per_layer.clear();
 
     // Substract x/y-disallowed area from the support.
     // This is done after the main loop, because at least one of the calculations there rely on other layers _without_ the x/y-disallowed area.
-    for (size_t layer_idx = layer_count - 1 - layer_z_distance_top; layer_idx != static_cast<size_t>(-1); layer_idx--)
-    {
-        Polygons& layer_this = support_areas[layer_idx];
-
-        // inset using X/Y distance
-        if (layer_this.size() > 0)
+    cura52::parallel_for<size_t>(storage.application,
+        0,
+        top_support_layer_idx + 1,
+        [&](const size_t layer_idx)
         {
-            layer_this = layer_this.difference(xy_disallowed_per_layer[layer_idx]);
-        }
-    }
+            Polygons& layer_this = support_areas[layer_idx];
+
+            // inset using X/Y distance
+            if (layer_this.size() > 0)
+            {
+                layer_this = layer_this.difference(xy_disallowed_per_layer[layer_idx]);
+            }
+        });
 
 
     // do stuff for when support on buildplate only
@@ -1397,7 +1439,7 @@ void AreaSupport::generateSupportAreasForMesh(SliceDataStorage& storage,
     storage.support.generated = true;
 }
 
-void AreaSupport::moveUpFromModel(const SliceDataStorage& storage,
+void AreaSupport::moveUpFromModel(const std::vector<Polygons>& outlines_per_layer,
                                   Polygons& stair_removal,
                                   Polygons& sloped_areas,
                                   Polygons& support_areas,
@@ -1460,9 +1502,7 @@ void AreaSupport::moveUpFromModel(const SliceDataStorage& storage,
     }
 
     const size_t bottom_layer_nr = layer_idx - bottom_empty_layer_count;
-    constexpr bool no_support = false;
-    constexpr bool no_prime_tower = false;
-    const Polygons bottom_outline = storage.getLayerOutlines(bottom_layer_nr, no_support, no_prime_tower);
+    const Polygons& bottom_outline = outlines_per_layer[bottom_layer_nr];
 
     Polygons to_be_removed;
     if (bottom_stair_step_layer_count <= 1)
@@ -1474,13 +1514,14 @@ void AreaSupport::moveUpFromModel(const SliceDataStorage& storage,
         to_be_removed = stair_removal.unionPolygons(bottom_outline);
         if (layer_idx % bottom_stair_step_layer_count == 0)
         { // update stairs for next step
-            const Polygons supporting_bottom = storage.getLayerOutlines(bottom_layer_nr - 1, no_support, no_prime_tower);
+            const Polygons no_outlines; // The model has no outlines below the first layer.
+            const Polygons& supporting_bottom = bottom_layer_nr > 0 ? outlines_per_layer[bottom_layer_nr - 1] : no_outlines;
             const Polygons allowed_step_width = supporting_bottom.offset(support_bottom_stair_step_width).intersection(sloped_areas);
 
             const int64_t step_bottom_layer_nr = bottom_layer_nr - bottom_stair_step_layer_count + 1;
             if (step_bottom_layer_nr >= 0)
             {
-                const Polygons step_bottom_outline = storage.getLayerOutlines(step_bottom_layer_nr, no_support, no_prime_tower);
+                const Polygons& step_bottom_outline = outlines_per_layer[step_bottom_layer_nr];
                 stair_removal = step_bottom_outline.intersection(allowed_step_width);
             }
             else
@@ -1563,7 +1604,7 @@ void AreaSupport::detectOverhangPoints(const SliceDataStorage& storage, SliceMes
                     continue;
                 }
 
-                const Polygons overhang = part.outline.offset(offset).difference(storage.support.supportLayers[layer_idx].anti_overhang);
+                const Polygons overhang = part.getOutlineOffset(offset, PolygonOffsetCache::Stage::SUPPORT, storage.application->current_slice->offset_cache_budget)->difference(storage.support.supportLayers[layer_idx].anti_overhang);
                 if (! overhang.empty())
                 {
                     mesh.overhang_points[layer_idx].push_back(overhang);
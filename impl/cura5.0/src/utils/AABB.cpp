@@ -4,6 +4,7 @@
 #include "utils/AABB.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygon.h" //To create the AABB of a polygon.
+#include "utils/PolygonSimd.h"
 #include <limits>
 
 namespace cura52
@@ -59,12 +60,9 @@ void AABB::calculate(const Polygons& polys)
 {
     min = Point(POINT_MAX, POINT_MAX);
     max = Point(POINT_MIN, POINT_MIN);
-    for (unsigned int i = 0; i < polys.size(); i++)
+    for (const ClipperLib::Path& poly : polys)
     {
-        for (unsigned int j = 0; j < polys[i].size(); j++)
-        {
-            include(polys[i][j]);
-        }
+        PolygonSimd::includeBounds(poly, min, max);
     }
 }
 
@@ -72,10 +70,7 @@ void AABB::calculate(ConstPolygonRef poly)
 {
     min = Point(POINT_MAX, POINT_MAX);
     max = Point(POINT_MIN, POINT_MIN);
-    for (const Point& p : poly)
-    {
-        include(p);
-    }
+    PolygonSimd::includeBounds(*poly, min, max);
 }
 
 bool AABB::contains(const Point& point) const
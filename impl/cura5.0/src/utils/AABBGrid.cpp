@@ -0,0 +1,136 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For nth_element, sort and unique.
+
+#include "utils/AABBGrid.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+bool hasArea(const AABB& box)
+{
+    return box.min.X <= box.max.X && box.min.Y <= box.max.Y;
+}
+
+} // namespace
+
+AABBGrid::AABBGrid(const coord_t cell_size)
+: SquareGrid(std::max(cell_size, coord_t(1)))
+{
+}
+
+coord_t AABBGrid::getCellSize(const std::vector<AABB>& boxes)
+{
+    constexpr coord_t max_cells_per_side = 64;
+
+    std::vector<coord_t> sizes;
+    sizes.reserve(boxes.size());
+    for (const AABB& box : boxes)
+    {
+        if (hasArea(box))
+        {
+            sizes.push_back(std::max(box.max.X - box.min.X, box.max.Y - box.min.Y));
+        }
+    }
+    if (sizes.empty())
+    {
+        return 1;
+    }
+    const coord_t largest = *std::max_element(sizes.begin(), sizes.end());
+    std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+    return std::max({ sizes[sizes.size() / 2], largest / max_cells_per_side, coord_t(1) });
+}
+
+void AABBGrid::insert(const size_t index, const AABB& box)
+{
+    if (index >= boxes.size())
+    {
+        boxes.resize(index + 1);
+        inserted.resize(index + 1, false);
+    }
+    if (! hasArea(box))
+    {
+        return;
+    }
+    boxes[index] = box;
+    inserted[index] = true;
+    processCells(box, [this, index](const GridPoint& cell) { cells[cell].push_back(index); });
+}
+
+void AABBGrid::remove(const size_t index)
+{
+    if (index >= boxes.size() || ! inserted[index])
+    {
+        return;
+    }
+    inserted[index] = false;
+    processCells(boxes[index],
+        [this, index](const GridPoint& cell)
+        {
+            std::vector<size_t>& indices = cells[cell];
+            indices.erase(std::find(indices.begin(), indices.end(), index));
+        });
+}
+
+std::vector<size_t> AABBGrid::getHits(const AABB& box) const
+{
+    std::vector<size_t> hits;
+    if (! hasArea(box))
+    {
+        return hits;
+    }
+    processCells(box,
+        [this, &box, &hits](const GridPoint& cell)
+        {
+            const auto found = cells.find(cell);
+            if (found == cells.end())
+            {
+                return;
+            }
+            for (const size_t index : found->second)
+            {
+                if (boxes[index].hit(box))
+                {
+                    hits.push_back(index);
+                }
+            }
+        });
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    return hits;
+}
+
+std::vector<std::pair<size_t, size_t>> AABBGrid::getHittingPairs() const
+{
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (const auto& cell : cells)
+    {
+        const std::vector<size_t>& indices = cell.second;
+        for (size_t a = 0; a < indices.size(); a++)
+        {
+            const AABB& box_a = boxes[indices[a]];
+            for (size_t b = a + 1; b < indices.size(); b++)
+            {
+                const AABB& box_b = boxes[indices[b]];
+                if (! box_a.hit(box_b))
+                {
+                    continue;
+                }
+                // Both boxes cover the cell of the lower left corner of their overlap, so only report the pair there.
+                const Point overlap_min(std::max(box_a.min.X, box_b.min.X), std::max(box_a.min.Y, box_b.min.Y));
+                if (toGridPoint(overlap_min) == cell.first)
+                {
+                    pairs.emplace_back(std::min(indices[a], indices[b]), std::max(indices[a], indices[b]));
+                }
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // namespace cura52
@@ -0,0 +1,130 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::find.
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "utils/ClipperPool.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+/*!
+ * The idle engines of one thread, and its share of the statistics.
+ *
+ * The counters are only written by their own thread; they are atomic so that
+ * \ref ClipperPool::getStatistics can read them from another one.
+ */
+struct ThreadEngines
+{
+    std::vector<std::unique_ptr<ClipperLib::Clipper>> clippers;
+    std::vector<std::unique_ptr<ClipperLib::ClipperOffset>> offsetters;
+    std::atomic<size_t> leases { 0 };
+    std::atomic<size_t> constructed { 0 };
+
+    ThreadEngines();
+    ~ThreadEngines();
+};
+
+std::mutex& registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+//! The engines of the threads which are running.
+std::vector<ThreadEngines*>& registry()
+{
+    static std::vector<ThreadEngines*> threads;
+    return threads;
+}
+
+//! The statistics of the threads which have ended.
+ClipperPool::Statistics& retired()
+{
+    static ClipperPool::Statistics statistics;
+    return statistics;
+}
+
+ThreadEngines::ThreadEngines()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+}
+
+ThreadEngines::~ThreadEngines()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    retired().leases += leases.load(std::memory_order_relaxed);
+    retired().constructed += constructed.load(std::memory_order_relaxed);
+    std::vector<ThreadEngines*>& threads = registry();
+    threads.erase(std::find(threads.begin(), threads.end(), this));
+}
+
+ThreadEngines& threadEngines()
+{
+    thread_local ThreadEngines engines;
+    return engines;
+}
+
+template<typename Engine>
+std::unique_ptr<Engine> lease(std::vector<std::unique_ptr<Engine>>& idle, ThreadEngines& engines)
+{
+    engines.leases.store(engines.leases.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (idle.empty())
+    {
+        engines.constructed.store(engines.constructed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return std::make_unique<Engine>();
+    }
+    std::unique_ptr<Engine> engine = std::move(idle.back());
+    idle.pop_back();
+    return engine;
+}
+
+} // namespace
+
+ClipperPool::Statistics ClipperPool::getStatistics()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Statistics statistics = retired();
+    for (const ThreadEngines* engines : registry())
+    {
+        statistics.leases += engines->leases.load(std::memory_order_relaxed);
+        statistics.constructed += engines->constructed.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+PooledClipper::PooledClipper(const int init_options)
+: engine(lease(threadEngines().clippers, threadEngines()))
+{
+    engine->ReverseSolution((init_options & ClipperLib::ioReverseSolution) != 0);
+    engine->StrictlySimple((init_options & ClipperLib::ioStrictlySimple) != 0);
+    engine->PreserveCollinear((init_options & ClipperLib::ioPreserveCollinear) != 0);
+}
+
+PooledClipper::~PooledClipper()
+{
+    engine->Clear(); // Drops the paths which were added, keeps the capacity of the lists.
+    threadEngines().clippers.push_back(std::move(engine));
+}
+
+PooledClipperOffset::PooledClipperOffset(const double miter_limit, const double arc_tolerance)
+: engine(lease(threadEngines().offsetters, threadEngines()))
+{
+    engine->MiterLimit = miter_limit;
+    engine->ArcTolerance = arc_tolerance;
+}
+
+PooledClipperOffset::~PooledClipperOffset()
+{
+    engine->Clear();
+    threadEngines().offsetters.push_back(std::move(engine));
+}
+
+} // namespace cura52
@@ -0,0 +1,209 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::rotate.
+#include <atomic>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "utils/PolygonOffsetCache.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+constexpr size_t num_stages = static_cast<size_t>(PolygonOffsetCache::Stage::NUM_STAGES);
+
+size_t getBytes(const Polygons& polygons)
+{
+    size_t bytes = polygons.paths.capacity() * sizeof(ClipperLib::Path);
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        bytes += path.capacity() * sizeof(Point);
+    }
+    return bytes;
+}
+
+size_t hashPoints(const Polygons& polygons)
+{
+    size_t hash = 0;
+    boost::hash_combine(hash, polygons.size());
+    for (ConstPolygonRef poly : polygons)
+    {
+        boost::hash_combine(hash, poly.size());
+        for (const Point& p : poly)
+        {
+            boost::hash_combine(hash, p.X);
+            boost::hash_combine(hash, p.Y);
+        }
+    }
+    return hash;
+}
+
+} // namespace
+
+PolygonOffsetCache::Budget::Budget()
+    : byte_budget(default_byte_budget)
+    , bytes_used(0)
+{
+    for (size_t stage_idx = 0; stage_idx < num_stages; stage_idx++)
+    {
+        hits[stage_idx].store(0, std::memory_order_relaxed);
+        misses[stage_idx].store(0, std::memory_order_relaxed);
+        uncached[stage_idx].store(0, std::memory_order_relaxed);
+    }
+}
+
+void PolygonOffsetCache::Budget::setBytes(const size_t bytes)
+{
+    byte_budget.store(bytes, std::memory_order_relaxed);
+}
+
+PolygonOffsetCache::Statistics PolygonOffsetCache::Budget::getStatistics(const Stage stage) const
+{
+    const size_t stage_idx = static_cast<size_t>(stage);
+    Statistics statistics;
+    statistics.hits = hits[stage_idx].load(std::memory_order_relaxed);
+    statistics.misses = misses[stage_idx].load(std::memory_order_relaxed);
+    statistics.uncached = uncached[stage_idx].load(std::memory_order_relaxed);
+    return statistics;
+}
+
+bool PolygonOffsetCache::Budget::reserve(const size_t bytes)
+{
+    size_t used = bytes_used.load(std::memory_order_relaxed);
+    do
+    {
+        if (used + bytes > byte_budget.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+    } while (! bytes_used.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+    return true;
+}
+
+void PolygonOffsetCache::Budget::release(const size_t bytes)
+{
+    bytes_used.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+PolygonOffsetCache::PolygonOffsetCache(const PolygonOffsetCache&) noexcept
+{
+}
+
+PolygonOffsetCache::PolygonOffsetCache(PolygonOffsetCache&&) noexcept
+{
+}
+
+PolygonOffsetCache& PolygonOffsetCache::operator=(const PolygonOffsetCache&)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    clear();
+    return *this;
+}
+
+PolygonOffsetCache& PolygonOffsetCache::operator=(PolygonOffsetCache&&)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    clear();
+    return *this;
+}
+
+PolygonOffsetCache::~PolygonOffsetCache()
+{
+    clear();
+}
+
+void PolygonOffsetCache::clear() const
+{
+    size_t bytes = 0;
+    for (const Entry& entry : entries)
+    {
+        bytes += entry.bytes;
+    }
+    if (entries_budget)
+    {
+        entries_budget->release(bytes);
+    }
+    entries.clear();
+}
+
+std::shared_ptr<const Polygons> PolygonOffsetCache::offset(const Polygons& source, const coord_t distance, const ClipperLib::JoinType join_type, const double miter_limit, const Stage stage, Budget& budget) const
+{
+    const size_t stage_idx = static_cast<size_t>(stage);
+    if (distance == 0)
+    {
+        return std::make_shared<const Polygons>(source); // Like Polygons::offset, and not worth an entry.
+    }
+    const size_t hash = hashPoints(source);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (! entries.empty() && (source_hash != hash || entries_budget != &budget))
+        {
+            clear(); // The source changed since, or the cache is asked for another slice.
+        }
+        for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+        {
+            if (entry->distance == distance && entry->join_type == join_type && entry->miter_limit == miter_limit)
+            {
+                std::rotate(entry, entry + 1, entries.end()); // Most recently used goes last.
+                budget.hits[stage_idx].fetch_add(1, std::memory_order_relaxed);
+                return entries.back().result;
+            }
+        }
+    }
+
+    // Offset without holding the lock; another thread asking for the same offset meanwhile computes it too.
+    std::shared_ptr<const Polygons> result = std::make_shared<const Polygons>(source.offset(distance, join_type, miter_limit));
+    budget.misses[stage_idx].fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (! entries.empty() && (source_hash != hash || entries_budget != &budget))
+    {
+        clear();
+    }
+    for (const Entry& entry : entries)
+    {
+        if (entry.distance == distance && entry.join_type == join_type && entry.miter_limit == miter_limit)
+        {
+            return result; // Added by another thread meanwhile.
+        }
+    }
+    const size_t result_bytes = getBytes(*result);
+    if (entries.size() == max_entries)
+    {
+        entries_budget->release(entries.front().bytes);
+        entries.erase(entries.begin());
+    }
+    if (! budget.reserve(result_bytes))
+    {
+        budget.uncached[stage_idx].fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+    source_hash = hash;
+    entries_budget = &budget;
+    entries.push_back(Entry{ distance, join_type, miter_limit, result, result_bytes });
+    return result;
+}
+
+const char* PolygonOffsetCache::getStageName(const Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::WALLS:
+        return "walls";
+    case Stage::COMBING:
+        return "combing";
+    case Stage::SUPPORT:
+        return "support";
+    case Stage::INFILL:
+        return "infill";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace cura52
@@ -0,0 +1,308 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::min and std::max.
+#include <limits>
+
+#include "utils/PolygonSimd.h"
+
+// The vector loops read the coordinates of a path as a packed array of 64-bit integers.
+#if (defined(__x86_64__) || defined(_M_X64)) && ! defined(use_xyz) && ! defined(use_int32)
+#define POLYGON_SIMD_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h> //For __cpuid and _xgetbv.
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+#endif
+
+namespace cura52
+{
+
+namespace
+{
+
+/*!
+ * One edge of ClipperLib::PointInPolygon, from \p ip to \p ip_next.
+ * \param result[in,out] Toggled if the edge crosses the ray to the right of \p pt.
+ * \return Whether \p pt lies on the edge.
+ */
+bool onEdgeOrToggle(const Point& pt, const Point& ip, const Point& ip_next, int& result)
+{
+    if (ip_next.Y == pt.Y)
+    {
+        if ((ip_next.X == pt.X) || (ip.Y == pt.Y && ((ip_next.X > pt.X) == (ip.X < pt.X))))
+        {
+            return true;
+        }
+    }
+    if ((ip.Y < pt.Y) != (ip_next.Y < pt.Y))
+    {
+        if (ip.X >= pt.X && ip_next.X > pt.X)
+        {
+            result = 1 - result;
+        }
+        else if (ip.X >= pt.X || ip_next.X > pt.X)
+        {
+            const double d = (double)(ip.X - pt.X) * (ip_next.Y - pt.Y) - (double)(ip_next.X - pt.X) * (ip.Y - pt.Y);
+            if (! d)
+            {
+                return true;
+            }
+            if ((d > 0) == (ip_next.Y > ip.Y))
+            {
+                result = 1 - result;
+            }
+        }
+    }
+    return false;
+}
+
+#ifdef POLYGON_SIMD_AVX2
+
+bool detectAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    constexpr int osxsave = 1 << 27;
+    constexpr int avx = 1 << 28;
+    if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0 || (_xgetbv(0) & 0x6) != 0x6) // The OS has to save the YMM registers too.
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/*!
+ * Load four points. The lanes hold the points in the order 0, 2, 1, 3.
+ */
+AVX2_TARGET inline void loadPoints(const int64_t* coords, __m256i& x, __m256i& y)
+{
+    const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coords));
+    const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coords + 4));
+    x = _mm256_unpacklo_epi64(first, second);
+    y = _mm256_unpackhi_epi64(first, second);
+}
+
+AVX2_TARGET int laneMask(const __m256i mask)
+{
+    return _mm256_movemask_pd(_mm256_castsi256_pd(mask));
+}
+
+AVX2_TARGET void includeBoundsAvx2(const ClipperLib::Path& path, Point& min, Point& max)
+{
+    const size_t count = path.size();
+    const int64_t* coords = reinterpret_cast<const int64_t*>(path.data());
+    __m256i lowest = _mm256_set_epi64x(min.Y, min.X, min.Y, min.X);
+    __m256i highest = _mm256_set_epi64x(max.Y, max.X, max.Y, max.X);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256i points = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coords + 2 * i));
+        lowest = _mm256_blendv_epi8(lowest, points, _mm256_cmpgt_epi64(lowest, points));
+        highest = _mm256_blendv_epi8(highest, points, _mm256_cmpgt_epi64(points, highest));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), lowest);
+    min.X = std::min(lanes[0], lanes[2]);
+    min.Y = std::min(lanes[1], lanes[3]);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), highest);
+    max.X = std::max(lanes[0], lanes[2]);
+    max.Y = std::max(lanes[1], lanes[3]);
+    for (; i < count; i++)
+    {
+        min.X = std::min(min.X, path[i].X);
+        min.Y = std::min(min.Y, path[i].Y);
+        max.X = std::max(max.X, path[i].X);
+        max.Y = std::max(max.Y, path[i].Y);
+    }
+}
+
+AVX2_TARGET int pointInPolygonAvx2(const Point& pt, const ClipperLib::Path& path)
+{
+    const size_t count = path.size();
+    if (count < 3)
+    {
+        return 0;
+    }
+    const int64_t* coords = reinterpret_cast<const int64_t*>(path.data());
+    const __m256i pt_x = _mm256_set1_epi64x(pt.X);
+    const __m256i pt_y = _mm256_set1_epi64x(pt.Y);
+    int result = 0;
+    size_t i = 1; // The edge from vertex i - 1 to vertex i.
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i prev_x, prev_y, next_x, next_y;
+        loadPoints(coords + 2 * (i - 1), prev_x, prev_y);
+        loadPoints(coords + 2 * i, next_x, next_y);
+        const __m256i on_line = _mm256_cmpeq_epi64(next_y, pt_y);
+        const __m256i crossing = _mm256_xor_si256(_mm256_cmpgt_epi64(pt_y, prev_y), _mm256_cmpgt_epi64(pt_y, next_y));
+        const __m256i prev_left = _mm256_cmpgt_epi64(pt_x, prev_x);
+        const __m256i next_right = _mm256_cmpgt_epi64(next_x, pt_x);
+        // A crossing edge which starts right and ends left of the point, or the other way around, needs the cross product.
+        const __m256i undecided = _mm256_or_si256(on_line, _mm256_andnot_si256(_mm256_xor_si256(prev_left, next_right), crossing));
+        if (laneMask(undecided) != 0)
+        {
+            for (size_t edge = i; edge < i + 4; edge++)
+            {
+                if (onEdgeOrToggle(pt, path[edge - 1], path[edge], result))
+                {
+                    return -1;
+                }
+            }
+            continue;
+        }
+        const int toggles = laneMask(_mm256_andnot_si256(prev_left, _mm256_and_si256(crossing, next_right)));
+        result ^= (toggles ^ (toggles >> 1) ^ (toggles >> 2) ^ (toggles >> 3)) & 1;
+    }
+    for (; i <= count; i++)
+    {
+        if (onEdgeOrToggle(pt, path[i - 1], path[i == count ? 0 : i], result))
+        {
+            return -1;
+        }
+    }
+    return result;
+}
+
+AVX2_TARGET size_t findNearestVertAvx2(const Point& from, const ClipperLib::Path& path, int64_t& best_dist2)
+{
+    const size_t count = path.size();
+    const int64_t* coords = reinterpret_cast<const int64_t*>(path.data());
+    const __m256i from_x = _mm256_set1_epi64x(from.X);
+    const __m256i from_y = _mm256_set1_epi64x(from.Y);
+    // Differences which fit in 32 bits can be squared with a 32-bit multiply. Offset by this, they fit in 32 unsigned bits.
+    const __m256i to_unsigned = _mm256_set1_epi64x(-int64_t(std::numeric_limits<int32_t>::min()));
+
+    // Every lane keeps the first of its closest points, so the first of the lanes' closest is the first closest overall.
+    __m256i lane_dist2 = _mm256_set1_epi64x(best_dist2);
+    __m256i lane_idx = _mm256_set1_epi64x(int64_t(count));
+    __m256i idx = _mm256_set_epi64x(3, 1, 2, 0);
+    const __m256i four = _mm256_set1_epi64x(4);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, idx = _mm256_add_epi64(idx, four))
+    {
+        __m256i x, y;
+        loadPoints(coords + 2 * i, x, y);
+        const __m256i dx = _mm256_sub_epi64(x, from_x);
+        const __m256i dy = _mm256_sub_epi64(y, from_y);
+        const __m256i high_bits = _mm256_srli_epi64(_mm256_or_si256(_mm256_add_epi64(dx, to_unsigned), _mm256_add_epi64(dy, to_unsigned)), 32);
+        __m256i dist2;
+        if (_mm256_testz_si256(high_bits, high_bits))
+        {
+            dist2 = _mm256_add_epi64(_mm256_mul_epi32(dx, dx), _mm256_mul_epi32(dy, dy));
+        }
+        else
+        {
+            alignas(32) const int64_t lanes[4] = { vSize2(path[i] - from), vSize2(path[i + 2] - from), vSize2(path[i + 1] - from), vSize2(path[i + 3] - from) };
+            dist2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+        }
+        const __m256i closer = _mm256_cmpgt_epi64(lane_dist2, dist2);
+        lane_dist2 = _mm256_blendv_epi8(lane_dist2, dist2, closer);
+        lane_idx = _mm256_blendv_epi8(lane_idx, idx, closer);
+    }
+
+    alignas(32) int64_t dist2_lanes[4];
+    alignas(32) int64_t idx_lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dist2_lanes), lane_dist2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(idx_lanes), lane_idx);
+    size_t best_idx = count;
+    for (size_t lane = 0; lane < 4; lane++)
+    {
+        if (dist2_lanes[lane] < best_dist2 || (dist2_lanes[lane] == best_dist2 && size_t(idx_lanes[lane]) < best_idx))
+        {
+            best_dist2 = dist2_lanes[lane];
+            best_idx = idx_lanes[lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        const int64_t dist2 = vSize2(path[i] - from);
+        if (dist2 < best_dist2)
+        {
+            best_dist2 = dist2;
+            best_idx = i;
+        }
+    }
+    return best_idx;
+}
+
+#endif // POLYGON_SIMD_AVX2
+
+} // namespace
+
+bool PolygonSimd::hasAvx2()
+{
+#ifdef POLYGON_SIMD_AVX2
+    static const bool has_avx2 = detectAvx2();
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+void PolygonSimd::includeBounds(const ClipperLib::Path& path, Point& min, Point& max)
+{
+#ifdef POLYGON_SIMD_AVX2
+    if (hasAvx2())
+    {
+        includeBoundsAvx2(path, min, max);
+        return;
+    }
+#endif
+    for (const Point& p : path)
+    {
+        min.X = std::min(min.X, p.X);
+        min.Y = std::min(min.Y, p.Y);
+        max.X = std::max(max.X, p.X);
+        max.Y = std::max(max.Y, p.Y);
+    }
+}
+
+int PolygonSimd::pointInPolygon(const Point& point, const ClipperLib::Path& path)
+{
+#ifdef POLYGON_SIMD_AVX2
+    if (hasAvx2())
+    {
+        return pointInPolygonAvx2(point, path);
+    }
+#endif
+    return ClipperLib::PointInPolygon(point, path);
+}
+
+size_t PolygonSimd::findNearestVert(const Point& from, const ClipperLib::Path& path, int64_t& best_dist2)
+{
+#ifdef POLYGON_SIMD_AVX2
+    if (hasAvx2())
+    {
+        return findNearestVertAvx2(from, path, best_dist2);
+    }
+#endif
+    size_t best_idx = path.size();
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        const int64_t dist2 = vSize2(path[i] - from);
+        if (dist2 < best_dist2)
+        {
+            best_dist2 = dist2;
+            best_idx = i;
+        }
+    }
+    return best_idx;
+}
+
+} // namespace cura52
@@ -0,0 +1,298 @@
+//Copyright (c) 2022 Ultimaker B.V.
+//CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include <algorithm> //For std::min and std::max.
+#include <cmath> //For std::ceil.
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "settings/Settings.h"
+#include "utils/ResourceGovernor.h"
+
+namespace cura52
+{
+
+namespace
+{
+
+#ifdef __linux__
+const std::string cgroup_root = "/sys/fs/cgroup";
+
+bool readFirstLine(const std::string& path, std::string& line)
+{
+    std::ifstream file(path);
+    return file.is_open() && std::getline(file, line);
+}
+
+bool exists(const std::string& path)
+{
+    std::ifstream file(path);
+    return file.is_open();
+}
+
+void tightenCpu(ResourceLimits& limits, const double cpus)
+{
+    if (cpus > 0 && (limits.cpu_quota == 0 || cpus < limits.cpu_quota))
+    {
+        limits.cpu_quota = cpus;
+    }
+}
+
+void tightenMemory(ResourceLimits& limits, const unsigned long long bytes)
+{
+    // Without a limit cgroup v1 reports a huge number instead, which is more than the machine has.
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page_size = sysconf(_SC_PAGE_SIZE);
+    const unsigned long long physical = (pages > 0 && page_size > 0) ? static_cast<unsigned long long>(pages) * page_size : 0;
+    if (bytes == 0 || (physical > 0 && bytes >= physical))
+    {
+        return;
+    }
+    if (limits.memory_limit == 0 || bytes < limits.memory_limit)
+    {
+        limits.memory_limit = bytes;
+    }
+}
+
+/*!
+ * Read the limits of a cgroup v2 directory: "cpu.max" holds "$MAX $PERIOD" and
+ * "memory.max" holds bytes, either may be "max" for no limit.
+ */
+void readCgroupV2(const std::string& directory, ResourceLimits& limits)
+{
+    std::string line;
+    if (readFirstLine(directory + "/cpu.max", line))
+    {
+        std::istringstream values(line);
+        std::string quota;
+        double period = 0;
+        if (values >> quota >> period && quota != "max" && period > 0)
+        {
+            tightenCpu(limits, std::stod(quota) / period);
+        }
+    }
+    if (readFirstLine(directory + "/memory.max", line) && line != "max")
+    {
+        tightenMemory(limits, std::stoull(line));
+    }
+}
+
+/*!
+ * Read the limits of the cgroups of this process, from the lines of
+ * /proc/self/cgroup: "$ID:$CONTROLLERS:$PATH". With cgroup v2 there is a single
+ * line "0::$PATH".
+ */
+void readCgroups(ResourceLimits& limits)
+{
+    std::ifstream proc_cgroup("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(proc_cgroup, line))
+    {
+        const size_t first_colon = line.find(':');
+        const size_t second_colon = line.find(':', first_colon + 1);
+        if (first_colon == std::string::npos || second_colon == std::string::npos)
+        {
+            continue;
+        }
+        const std::string controllers = line.substr(first_colon + 1, second_colon - first_colon - 1);
+        std::string path = line.substr(second_colon + 1);
+        if (path == "/")
+        {
+            path.clear();
+        }
+
+        try
+        {
+            if (controllers.empty()) // cgroup v2.
+            {
+                // In a container the path is usually that of the host, and the cgroup of the container is mounted as the root.
+                std::string directory = cgroup_root + path;
+                if (! exists(directory + "/cgroup.controllers"))
+                {
+                    directory = cgroup_root;
+                }
+                // A parent can limit more than its child, so walk up to the root.
+                while (true)
+                {
+                    readCgroupV2(directory, limits);
+                    if (directory.size() <= cgroup_root.size())
+                    {
+                        break;
+                    }
+                    directory = directory.substr(0, directory.rfind('/'));
+                }
+                continue;
+            }
+
+            // cgroup v1: every controller has a hierarchy of its own, mounted under its name.
+            std::string controller;
+            std::istringstream controller_list(controllers);
+            while (std::getline(controller_list, controller, ','))
+            {
+                if (controller == "cpu")
+                {
+                    for (const std::string& directory : { cgroup_root + "/" + controllers + path, cgroup_root + "/" + controllers, cgroup_root + "/cpu" + path, cgroup_root + "/cpu" })
+                    {
+                        std::string quota;
+                        std::string period;
+                        if (readFirstLine(directory + "/cpu.cfs_quota_us", quota) && readFirstLine(directory + "/cpu.cfs_period_us", period))
+                        {
+                            if (std::stod(quota) > 0 && std::stod(period) > 0) // The quota is -1 without a limit.
+                            {
+                                tightenCpu(limits, std::stod(quota) / std::stod(period));
+                            }
+                            break;
+                        }
+                    }
+                }
+                else if (controller == "memory")
+                {
+                    for (const std::string& directory : { cgroup_root + "/memory" + path, cgroup_root + "/memory" })
+                    {
+                        std::string limit;
+                        if (readFirstLine(directory + "/memory.limit_in_bytes", limit))
+                        {
+                            tightenMemory(limits, std::stoull(limit));
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        catch (const std::exception&) // A file which doesn't hold a number; no limit then.
+        {
+        }
+    }
+}
+#endif
+
+} // namespace
+
+ResourceLimits ResourceLimits::detect()
+{
+    ResourceLimits limits;
+    limits.hardware_threads = std::max(1u, std::thread::hardware_concurrency()); // It can return 0 if it doesn't know.
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &cpu_set))
+            {
+                limits.cpus.push_back(cpu);
+            }
+        }
+        if (! limits.cpus.empty())
+        {
+            limits.hardware_threads = limits.cpus.size();
+        }
+    }
+    readCgroups(limits);
+#endif
+    return limits;
+}
+
+ResourceGovernor::ResourceGovernor()
+: limits(ResourceLimits::detect())
+{
+}
+
+void ResourceGovernor::applySettings(const Settings& settings)
+{
+    if (settings.has("engine_max_threads"))
+    {
+        setThreadCap(std::max(0, settings.get<int>("engine_max_threads")));
+    }
+    if (settings.has("engine_memory_limit"))
+    {
+        setMemoryCap(settings.get<size_t>("engine_memory_limit") * 1024 * 1024);
+    }
+    if (settings.has("engine_pin_threads") && settings.get<bool>("engine_pin_threads"))
+    {
+        setPinThreads(true);
+    }
+}
+
+void ResourceGovernor::setThreadCap(const size_t threads)
+{
+    if (threads > 0 && (thread_cap == 0 || threads < thread_cap))
+    {
+        thread_cap = threads;
+    }
+}
+
+void ResourceGovernor::setMemoryCap(const size_t bytes)
+{
+    if (bytes > 0 && (memory_cap == 0 || bytes < memory_cap))
+    {
+        memory_cap = bytes;
+    }
+}
+
+void ResourceGovernor::setPinThreads(const bool pin)
+{
+    pin_threads = pin;
+}
+
+size_t ResourceGovernor::threadCount() const
+{
+    size_t threads = limits.hardware_threads;
+    if (limits.cpu_quota > 0)
+    {
+        threads = std::min(threads, static_cast<size_t>(std::ceil(limits.cpu_quota)));
+    }
+    if (thread_cap > 0)
+    {
+        threads = std::min(threads, thread_cap);
+    }
+    return std::max(size_t(1), threads);
+}
+
+size_t ResourceGovernor::memoryBudget() const
+{
+    if (limits.memory_limit == 0 || memory_cap == 0)
+    {
+        return std::max(limits.memory_limit, memory_cap);
+    }
+    return std::min(limits.memory_limit, memory_cap);
+}
+
+bool ResourceGovernor::hasMemoryCap() const
+{
+    return memory_cap > 0;
+}
+
+bool ResourceGovernor::pinThreads() const
+{
+    return pin_threads;
+}
+
+void ResourceGovernor::pin(std::thread& thread, const size_t worker_idx) const
+{
+    if (! pin_threads || limits.cpus.empty())
+    {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(limits.cpus[(worker_idx + 1) % limits.cpus.size()], &cpu_set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+const ResourceLimits& ResourceGovernor::detected() const
+{
+    return limits;
+}
+
+} // namespace cura52
@@ -172,24 +172,7 @@ bool SquareGrid::processNearby
     const std::function<bool (const GridPoint&)>& process_func
 ) const
 {
-    const Point min_loc(query_pt.X - radius, query_pt.Y - radius);
-    const Point max_loc(query_pt.X + radius, query_pt.Y + radius);
-
-    GridPoint min_grid = toGridPoint(min_loc);
-    GridPoint max_grid = toGridPoint(max_loc);
-
-    for (coord_t grid_y = min_grid.Y; grid_y <= max_grid.Y; ++grid_y)
-    {
-        for (coord_t grid_x = min_grid.X; grid_x <= max_grid.X; ++grid_x)
-        {
-            GridPoint grid_pt(grid_x,grid_y);
-            if (!process_func(grid_pt))
-            {
-                return false;
-            }
-        }
-    }
-    return true;
+    return processNearbyCells(query_pt, radius, process_func);
 }
 
 SquareGrid::grid_coord_t SquareGrid::nonzeroSign(const grid_coord_t z) const
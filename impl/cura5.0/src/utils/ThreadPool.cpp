@@ -2,16 +2,21 @@
 //CuraEngine is released under the terms of the AGPLv3 or higher.
 
 #include "utils/ThreadPool.h"
+#include "utils/ResourceGovernor.h"
 
 namespace cura52
 {
 
-ThreadPool::ThreadPool(size_t nthreads)
+ThreadPool::ThreadPool(size_t nthreads, const ResourceGovernor* governor)
   : wait_for_new_tasks(true)
 {
     for (size_t i = 0 ; i < nthreads; i++)
     {
         threads.emplace_back(&ThreadPool::worker, this);
+        if (governor)
+        {
+            governor->pin(threads.back(), i);
+        }
     }
 }
 
@@ -63,10 +63,10 @@ bool ConstPolygonRef::_inside(Point p, bool border_result) const
 Polygons ConstPolygonRef::intersection(const ConstPolygonRef& other) const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    clipper.AddPath(*path, ClipperLib::ptSubject, true);
-    clipper.AddPath(*other.path, ClipperLib::ptClip, true);
-    clipper.Execute(ClipperLib::ctIntersection, ret.paths);
+    PooledClipper clipper(clipper_init);
+    clipper->AddPath(*path, ClipperLib::ptSubject, true);
+    clipper->AddPath(*other.path, ClipperLib::ptClip, true);
+    clipper->Execute(ClipperLib::ctIntersection, ret.paths);
     return ret;
 }
 
@@ -93,10 +93,10 @@ void Polygons::sortByNesting_processPolyTreeNode(ClipperLib::PolyNode* node, con
 std::vector<Polygons> Polygons::sortByNesting() const
 {
     std::vector<Polygons> ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-    clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     sortByNesting_processPolyTreeNode(&resultPolyTree, 0, ret);
     return ret;
@@ -113,9 +113,9 @@ Polygons Polygons::approxConvexHull(int extra_outset)
     for (const ClipperLib::Path& path : paths)
     {
         Polygons offset_result;
-        ClipperLib::ClipperOffset offsetter(1.2, 10.0);
-        offsetter.AddPath(path, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
-        offsetter.Execute(offset_result.paths, overshoot);
+        PooledClipperOffset offsetter(1.2, 10.0);
+        offsetter->AddPath(path, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+        offsetter->Execute(offset_result.paths, overshoot);
         convex_hull.add(offset_result);
     }
     return convex_hull.unionPolygons().offset(-overshoot + extra_outset, ClipperLib::jtRound);
@@ -171,7 +171,7 @@ bool Polygons::inside(Point p, bool border_result) const
     int poly_count_inside = 0;
     for (const ClipperLib::Path& poly : *this)
     {
-        const int is_inside_this_poly = ClipperLib::PointInPolygon(p, poly);
+        const int is_inside_this_poly = PolygonSimd::pointInPolygon(p, poly);
         if (is_inside_this_poly == -1)
         {
             return border_result;
@@ -298,10 +298,10 @@ Polygons Polygons::intersectionPolyLines(const Polygons& polylines, bool restitc
     Polygons split_polylines = polylines.splitPolylinesIntoSegments();
     
     ClipperLib::PolyTree result;
-    ClipperLib::Clipper clipper(clipper_init);
-    clipper.AddPaths(split_polylines.paths, ClipperLib::ptSubject, false);
-    clipper.AddPaths(paths, ClipperLib::ptClip, true);
-    clipper.Execute(ClipperLib::ctIntersection, result);
+    PooledClipper clipper(clipper_init);
+    clipper->AddPaths(split_polylines.paths, ClipperLib::ptSubject, false);
+    clipper->AddPaths(paths, ClipperLib::ptClip, true);
+    clipper->Execute(ClipperLib::ctIntersection, result);
     Polygons ret;
     ClipperLib::OpenPathsFromPolyTree(result, ret.paths);
     
@@ -371,10 +371,10 @@ Polygons Polygons::offset(int distance, ClipperLib::JoinType join_type, double m
         return *this;
     }
     Polygons ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    clipper.AddPaths(unionPolygons().paths, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret.paths, distance);
+    PooledClipperOffset clipper(miter_limit, 10.0);
+    clipper->AddPaths(unionPolygons().paths, join_type, ClipperLib::etClosedPolygon);
+    clipper->MiterLimit = miter_limit;
+    clipper->Execute(ret.paths, distance);
     return ret;
 }
 
@@ -387,10 +387,10 @@ Polygons ConstPolygonRef::offset(int distance, ClipperLib::JoinType join_type, d
         return ret;
     }
     Polygons ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    clipper.AddPath(*path, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret.paths, distance);
+    PooledClipperOffset clipper(miter_limit, 10.0);
+    clipper->AddPath(*path, join_type, ClipperLib::etClosedPolygon);
+    clipper->MiterLimit = miter_limit;
+    clipper->Execute(ret.paths, distance);
     return ret;
 }
 
@@ -488,11 +488,11 @@ void PolygonRef::applyMatrix(const Point3Matrix& matrix)
 Polygons Polygons::getOutsidePolygons() const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree poly_tree;
     constexpr bool paths_are_closed_polys = true;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
-    clipper.Execute(ClipperLib::ctUnion, poly_tree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
+    clipper->Execute(ClipperLib::ctUnion, poly_tree);
 
     for (int outer_poly_idx = 0; outer_poly_idx < poly_tree.ChildCount(); outer_poly_idx++)
     {
@@ -505,11 +505,11 @@ Polygons Polygons::getOutsidePolygons() const
 Polygons Polygons::removeEmptyHoles() const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree poly_tree;
     constexpr bool paths_are_closed_polys = true;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
-    clipper.Execute(ClipperLib::ctUnion, poly_tree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
+    clipper->Execute(ClipperLib::ctUnion, poly_tree);
 
     bool remove_holes = true;
     removeEmptyHoles_processPolyTreeNode(poly_tree, remove_holes, ret);
@@ -519,11 +519,11 @@ Polygons Polygons::removeEmptyHoles() const
 Polygons Polygons::getEmptyHoles() const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree poly_tree;
     constexpr bool paths_are_closed_polys = true;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
-    clipper.Execute(ClipperLib::ctUnion, poly_tree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
+    clipper->Execute(ClipperLib::ctUnion, poly_tree);
 
     bool remove_holes = false;
     removeEmptyHoles_processPolyTreeNode(poly_tree, remove_holes, ret);
@@ -1342,13 +1342,13 @@ double Polygons::area() const
 std::vector<PolygonsPart> Polygons::splitIntoParts(bool unionAll) const
 {
     std::vector<PolygonsPart> ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
     if (unionAll)
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     else
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     splitIntoParts_processPolyTreeNode(&resultPolyTree, ret);
     return ret;
@@ -1421,13 +1421,13 @@ PartsView Polygons::splitIntoPartsView(bool unionAll)
 {
     Polygons reordered;
     PartsView partsView(*this);
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipper clipper(clipper_init);
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
     if (unionAll)
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     else
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     splitIntoPartsView_processPolyTreeNode(partsView, reordered, &resultPolyTree);
 
@@ -7,6 +7,7 @@
 #include <unordered_set>
 
 #include "infill.h"
+#include "utils/PolygonSimd.h"
 #include "utils/SparsePointGridInclusive.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygonUtils.h"
@@ -995,15 +996,10 @@ PolygonsPointIndex PolygonUtils::findNearestVert(const Point from, const Polygon
     PolygonsPointIndex closest_vert;
     for (unsigned int poly_idx = 0; poly_idx < polys.size(); poly_idx++)
     {
-        ConstPolygonRef poly = polys[poly_idx];
-        for (unsigned int point_idx = 0; point_idx < poly.size(); point_idx++)
+        const size_t point_idx = PolygonSimd::findNearestVert(from, *polys[poly_idx], best_dist2);
+        if (point_idx < polys[poly_idx].size())
         {
-            int64_t dist2 = vSize2(poly[point_idx] - from);
-            if (dist2 < best_dist2)
-            {
-                best_dist2 = dist2;
-                closest_vert = PolygonsPointIndex(&polys, poly_idx, point_idx);
-            }
+            closest_vert = PolygonsPointIndex(&polys, poly_idx, point_idx);
         }
     }
     return closest_vert;
@@ -1012,17 +1008,8 @@ PolygonsPointIndex PolygonUtils::findNearestVert(const Point from, const Polygon
 unsigned int PolygonUtils::findNearestVert(const Point from, ConstPolygonRef poly)
 {
     int64_t best_dist2 = std::numeric_limits<int64_t>::max();
-    unsigned int closest_vert_idx = -1;
-    for (unsigned int point_idx = 0; point_idx < poly.size(); point_idx++)
-    {
-        int64_t dist2 = vSize2(poly[point_idx] - from);
-        if (dist2 < best_dist2)
-        {
-            best_dist2 = dist2;
-            closest_vert_idx = point_idx;
-        }
-    }
-    return closest_vert_idx;
+    const size_t closest_vert_idx = PolygonSimd::findNearestVert(from, *poly, best_dist2);
+    return closest_vert_idx < poly.size() ? closest_vert_idx : -1;
 }
 
 std::unique_ptr<LocToLineGrid> PolygonUtils::createLocToLineGrid(const Polygons& polygons, int square_size)
@@ -0,0 +1,129 @@
+#include "crslice/crasyncslice.h"
+#include "SliceListener.h"
+
+#include "ccglobal/log.h"
+#include "slicejob.h"
+
+namespace crslice
+{
+	namespace
+	{
+		class CallbackListener : public cura52::SliceListener
+		{
+		public:
+			CallbackListener(const AsyncSliceCallbacks& callbacks)
+				: m_callbacks(callbacks)
+			{
+			}
+
+			void onProgress(const cura52::Progress::Stage stage, const float stage_progress, const float overall_progress) override
+			{
+				if (m_callbacks.progress)
+					m_callbacks.progress({ (SliceStage)stage, stage_progress, overall_progress });
+			}
+
+			bool wantsGCodeChunks() const override
+			{
+				return (bool)m_callbacks.gcodeChunk;
+			}
+
+			void onGCodeChunk(const cura52::GCodeChunk& chunk) override
+			{
+				GCodeChunkEvent event;
+				switch (chunk.type)
+				{
+				case cura52::GCodeChunk::Type::LAYER:
+					event.type = GCodeChunkEvent::Type::layer;
+					break;
+				case cura52::GCodeChunk::Type::HEADER:
+					event.type = GCodeChunkEvent::Type::header;
+					break;
+				default:
+					event.type = GCodeChunkEvent::Type::end;
+					break;
+				}
+				event.layer = chunk.layer_nr;
+				event.offset = chunk.offset;
+				event.data = chunk.data;
+				m_callbacks.gcodeChunk(event);
+			}
+		protected:
+			const AsyncSliceCallbacks& m_callbacks;
+		};
+	}
+
+	CrAsyncSlice::CrAsyncSlice(CrScenePtr scene, const AsyncSliceCallbacks& callbacks, ccglobal::Tracer* tracer,
+		const SliceResourceLimits& limits)
+		: m_callbacks(callbacks)
+		, m_cancel(false)
+		, m_sliceResult({ 0 })
+	{
+		m_future = m_promise.get_future().share();
+		if (!scene)
+		{
+			LOGM("CrAsyncSlice empty scene.");
+			m_promise.set_value(false);
+			return;
+		}
+
+		m_thread = std::thread(&CrAsyncSlice::run, this, scene, tracer, limits);
+	}
+
+	CrAsyncSlice::~CrAsyncSlice()
+	{
+		if (m_thread.joinable())
+		{
+			cancel();
+			m_thread.join();
+		}
+	}
+
+	void CrAsyncSlice::cancel()
+	{
+		m_cancel.store(true, std::memory_order_relaxed);
+	}
+
+	bool CrAsyncSlice::isCancelled() const
+	{
+		return m_cancel.load(std::memory_order_relaxed);
+	}
+
+	std::shared_future<bool> CrAsyncSlice::future() const
+	{
+		return m_future;
+	}
+
+	SliceResult CrAsyncSlice::sliceResult() const
+	{
+		m_future.wait();
+		return m_sliceResult;
+	}
+
+	void CrAsyncSlice::run(CrScenePtr scene, ccglobal::Tracer* tracer, SliceResourceLimits limits)
+	{
+		// Nothing may escape the thread: that would terminate the process and leave the future unset.
+		bool done = false;
+		try
+		{
+			CallbackListener listener(m_callbacks);
+			done = runSlice(scene, tracer, &listener, &m_cancel, limits, m_sliceResult);
+		}
+		catch (const std::exception& e)
+		{
+			LOGE("CrAsyncSlice slice failed: %s", e.what());
+		}
+		catch (...)
+		{
+			LOGE("CrAsyncSlice slice failed.");
+		}
+
+		try
+		{
+			m_promise.set_value(done && !isCancelled());
+		}
+		catch (const std::exception& e)
+		{
+			LOGE("CrAsyncSlice result could not be set: %s", e.what());
+		}
+	}
+}
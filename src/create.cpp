@@ -2,9 +2,12 @@
 #include "Application.h"
 
 #include "crgroup.h"
+#include "settingsbundle.h"
 #include "ccglobal/log.h"
 #include "mmesh/util/trimecr30.h"
 
+#include <algorithm>
+
 namespace crslice
 {
     void trimesh2CuraMesh(trimesh::TriMesh* mesh, cura52::Mesh& curaMesh, cura52::Application* application)
@@ -75,18 +78,38 @@ namespace crslice
         bool sliceValible = false;
 
         std::vector<SettingsPtr>& extruderKVs = scene->m_extruders;
-        int extruder_nr = 0;
-        for (SettingsPtr settings : extruderKVs)
+        std::shared_ptr<const SettingsBundle> bundle = scene->m_bundle;
+        if (bundle)
         {
-            slice->scene.extruders.emplace_back(extruder_nr, &slice->scene.settings);
-            cura52::ExtruderTrain& extruder = slice->scene.extruders[extruder_nr];
-            extruder.settings.settings.swap(settings->settings);
-            ++extruder_nr;
+            // The bundle is the base, shared by all slices; only what the scene overrides is added per slice.
+            const size_t extruderCount = mergedExtruderCount(*scene);
+            for (size_t extruder_nr = 0; extruder_nr < extruderCount; ++extruder_nr)
+            {
+                slice->scene.extruders.emplace_back(extruder_nr, &slice->scene.settings);
+                cura52::ExtruderTrain& extruder = slice->scene.extruders[extruder_nr];
+                if (extruder_nr < bundle->extruderCount())
+                    extruder.settings.setShared(bundle->extruderSettings(extruder_nr));
+                if (extruder_nr < extruderKVs.size())
+                    crSetting2CuraSettings(*extruderKVs[extruder_nr], &extruder.settings);
+            }
+        }
+        else
+        {
+            int extruder_nr = 0;
+            for (SettingsPtr settings : extruderKVs)
+            {
+                slice->scene.extruders.emplace_back(extruder_nr, &slice->scene.settings);
+                cura52::ExtruderTrain& extruder = slice->scene.extruders[extruder_nr];
+                extruder.settings.settings.swap(settings->settings);
+                ++extruder_nr;
+            }
         }
 
         if (slice->scene.extruders.size() == 0)
             slice->scene.extruders.emplace_back(0, &slice->scene.settings); // Always have one extruder.
 
+        if (bundle)
+            slice->scene.settings.setShared(bundle->sceneSettings());
         crSetting2CuraSettings(*(scene->m_settings), &(slice->scene.settings));
 
         //CR30 
@@ -2,13 +2,17 @@
 
 #include "crgroup.h"
 #include "crobject.h"
+#include "settingsbundle.h"
 #include "crcommon/jsonloader.h"
 #include "ccglobal/log.h"
 
+#include <algorithm>
+
 namespace crslice
 {
 	CrScene::CrScene()
-		:m_debugger(nullptr)
+		:m_resultCacheMaxBytes(0)
+		, m_debugger(nullptr)
 	{
 		m_settings.reset(new crcommon::Settings());
 		machine_center_is_zero = false;
@@ -108,11 +112,23 @@ namespace crslice
 		}
 	}
 
+	bool CrScene::setSceneBundleFile(const std::string& fileName)
+	{
+		m_bundle = SettingsBundle::open(fileName);
+		return m_bundle != nullptr;
+	}
+
 	void CrScene::setTempDirectory(const std::string& directory)
 	{
 		m_tempDirectory = directory;
 	}
 
+	void CrScene::setResultCacheDirectory(const std::string& directory, size_t maxBytes)
+	{
+		m_resultCacheDirectory = directory;
+		m_resultCacheMaxBytes = maxBytes;
+	}
+
 	void CrScene::release()
 	{
 		for (CrGroup* group : m_groups)
@@ -141,11 +157,34 @@ namespace crslice
 		out.open(fileName, std::ios_base::binary);
 		if (out.is_open())
 		{
-			m_settings->save(out);
-			int extruderCount = (int)m_extruders.size();
-			templateSave<int>(extruderCount, out);
-			for (int i = 0; i < extruderCount; ++i)
-				m_extruders.at(i)->save(out);
+			if (m_bundle)
+			{
+				// Save the bundle values together with the overrides, so that the saved scene doesn't need the bundle.
+				std::map<std::string, std::string> merged;
+				mergeSceneSettings(*this, merged);
+				crcommon::Settings settings;
+				settings.settings.insert(merged.begin(), merged.end());
+				settings.save(out);
+
+				int extruderCount = (int)mergedExtruderCount(*this);
+				templateSave<int>(extruderCount, out);
+				for (int i = 0; i < extruderCount; ++i)
+				{
+					merged.clear();
+					mergeExtruderSettings(*this, i, merged);
+					crcommon::Settings extruder;
+					extruder.settings.insert(merged.begin(), merged.end());
+					extruder.save(out);
+				}
+			}
+			else
+			{
+				m_settings->save(out);
+				int extruderCount = (int)m_extruders.size();
+				templateSave<int>(extruderCount, out);
+				for (int i = 0; i < extruderCount; ++i)
+					m_extruders.at(i)->save(out);
+			}
 
 			int groupCount = (int)m_groups.size();
 			templateSave<int>(groupCount, out);
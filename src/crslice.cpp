@@ -3,6 +3,12 @@
 
 #include "ccglobal/log.h"
 #include "crslicefromscene.h"
+#include "slicecache.h"
+#include "slicejob.h"
+#include "ccglobal/tracer.h"
+
+#include <fstream>
+#include <iterator>
 
 namespace crslice
 {
@@ -25,13 +31,67 @@ namespace crslice
 			return;
 		}
 
+		runSlice(scene, tracer, nullptr, nullptr, m_resourceLimits, sliceResult);
+	}
+
+	void CrSlice::setResourceLimits(const SliceResourceLimits& limits)
+	{
+		m_resourceLimits = limits;
+	}
+
+	bool runSlice(CrScenePtr scene, ccglobal::Tracer* tracer, cura52::SliceListener* listener,
+		const std::atomic<bool>* cancelFlag, const SliceResourceLimits& limits, SliceResult& result)
+	{
+		// The cache key doesn't cover the contents of the split polygons file, and the debugger
+		// needs the engine to run, so either of them bypasses the cache.
+		std::unique_ptr<SliceCache> cache;
+		std::string cacheKey;
+		if (!scene->m_resultCacheDirectory.empty() && scene->m_ploygonFileName.empty() && !scene->m_debugger)
+		{
+			cache.reset(new SliceCache(scene->m_resultCacheDirectory, scene->m_resultCacheMaxBytes));
+			cacheKey = SliceCache::key(*scene);
+			if (cache->fetch(cacheKey, scene->m_gcodeFileName, result))
+			{
+				LOGM("runSlice cache hit %s.", cacheKey.c_str());
+				if (tracer)
+					tracer->progress(1.0f);
+				if (listener)
+				{
+					listener->onProgress(cura52::Progress::Stage::FINISH, 1.0f, 1.0f);
+					if (listener->wantsGCodeChunks())
+					{
+						// The whole file at once, there are no layers to wait for.
+						cura52::GCodeChunk chunk;
+						chunk.type = cura52::GCodeChunk::Type::END;
+						std::ifstream in(scene->m_gcodeFileName, std::ios::binary);
+						chunk.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+						listener->onGCodeChunk(chunk);
+					}
+				}
+				return true;
+			}
+		}
+
 		cura52::Application app(tracer);
 		app.tempDirectory = scene->m_tempDirectory;
 		app.fDebugger = scene->m_debugger;
+		app.listener = listener;
+		app.cancel_flag = cancelFlag;
+		app.resources.setThreadCap(limits.maxThreads > 0 ? limits.maxThreads : 0);
+		app.resources.setMemoryCap(limits.maxMemoryMB * 1024 * 1024);
+		if (limits.pinThreads)
+			app.resources.setPinThreads(true);
 
 		CRSliceFromScene crScene(&app, scene);
 		app.runCommulication(&crScene);
-        sliceResult = { app.sliceResult.print_time,app.sliceResult.filament_len ,app.sliceResult.filament_volume,app.sliceResult.layer_count,
-            app.sliceResult.x,app.sliceResult.y,app.sliceResult.z };
+        result = { app.sliceResult.print_time,app.sliceResult.filament_len ,app.sliceResult.filament_volume,app.sliceResult.layer_count,
+            app.sliceResult.x,app.sliceResult.y,app.sliceResult.z,
+            (int)app.sliceResult.thread_count,app.sliceResult.cpu_quota,app.sliceResult.memory_budget,app.sliceResult.pinned_threads };
+
+		if (app.interrupted())
+			return false;
+		if (cache && result.layer_count > 0)
+			cache->store(cacheKey, scene->m_gcodeFileName, result);
+		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "settingsbundle.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "crslice/crscene.h"
+#include "crcommon/jsonloader.h"
+#include "ccglobal/log.h"
+#include "settings/SharedSettings.h"
+
+namespace crslice
+{
+	namespace
+	{
+		size_t align8(size_t offset)
+		{
+			return (offset + 7) & ~size_t(7);
+		}
+
+		struct Layout
+		{
+			size_t keys;
+			size_t sets;
+			size_t values;
+			size_t strings;
+			size_t end;
+		};
+
+		Layout layoutOf(const SettingsBundle::Header& header)
+		{
+			Layout layout;
+			layout.keys = align8(sizeof(SettingsBundle::Header));
+			layout.sets = align8(layout.keys + size_t(header.key_count) * sizeof(SettingsBundle::StringRef));
+			layout.values = align8(layout.sets + size_t(header.set_count) * sizeof(SettingsBundle::SetRef));
+			layout.strings = align8(layout.values + size_t(header.value_count) * sizeof(SettingsBundle::Value));
+			layout.end = layout.strings + header.strings_size;
+			return layout;
+		}
+
+		bool fileStamp(const std::string& fileName, int64_t& size, int64_t& mtime)
+		{
+			struct stat info;
+			if (stat(fileName.c_str(), &info) != 0)
+				return false;
+			size = (int64_t)info.st_size;
+			mtime = (int64_t)info.st_mtime;
+			return true;
+		}
+
+		struct CachedBundle
+		{
+			std::weak_ptr<const SettingsBundle> bundle;
+			int64_t size;
+			int64_t mtime;
+		};
+
+		std::mutex cacheMutex;
+		std::unordered_map<std::string, CachedBundle> cache;
+
+		/*
+		 * Collects the strings of a bundle, storing equal strings only once.
+		 */
+		class StringPool
+		{
+		public:
+			SettingsBundle::StringRef add(const std::string& str)
+			{
+				auto it = m_offsets.find(str);
+				if (it == m_offsets.end())
+				{
+					it = m_offsets.emplace(str, (uint32_t)m_data.size()).first;
+					m_data.insert(m_data.end(), str.begin(), str.end());
+				}
+				return SettingsBundle::StringRef{ it->second, (uint32_t)str.size() };
+			}
+
+			const std::vector<char>& data() const
+			{
+				return m_data;
+			}
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_offsets;
+			std::vector<char> m_data;
+		};
+
+		template<typename T>
+		void writeAt(std::ofstream& out, size_t offset, const T* data, size_t count)
+		{
+			out.seekp((std::streamoff)offset);
+			out.write((const char*)data, count * sizeof(T));
+		}
+	}
+
+	SettingsBundle::~SettingsBundle()
+	{
+#ifdef _WIN32
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mapping)
+			CloseHandle((HANDLE)m_mapping);
+#else
+		if (m_data)
+			munmap((void*)m_data, m_size);
+#endif
+	}
+
+	std::shared_ptr<const SettingsBundle> SettingsBundle::open(const std::string& fileName)
+	{
+		int64_t size = 0;
+		int64_t mtime = 0;
+		if (!fileStamp(fileName, size, mtime))
+		{
+			LOGE("SettingsBundle::open can't find %s", fileName.c_str());
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		CachedBundle& cached = cache[fileName];
+		std::shared_ptr<const SettingsBundle> shared = cached.bundle.lock();
+		if (shared && cached.size == size && cached.mtime == mtime)
+			return shared;
+
+		std::shared_ptr<SettingsBundle> bundle(new SettingsBundle());
+		if (!bundle->map(fileName) || !bundle->validate())
+		{
+			LOGE("SettingsBundle::open invalid bundle file: %s", fileName.c_str());
+			cache.erase(fileName);
+			return nullptr;
+		}
+		bundle->readSets();
+
+		cached.bundle = bundle;
+		cached.size = size;
+		cached.mtime = mtime;
+		return bundle;
+	}
+
+	size_t SettingsBundle::extruderCount() const
+	{
+		return m_header->set_count - 1;
+	}
+
+	std::shared_ptr<const cura52::SharedSettings> SettingsBundle::sceneSettings() const
+	{
+		return m_shared[0];
+	}
+
+	std::shared_ptr<const cura52::SharedSettings> SettingsBundle::extruderSettings(size_t extruder) const
+	{
+		return m_shared[1 + extruder];
+	}
+
+	void SettingsBundle::readSets()
+	{
+		m_shared.reserve(m_header->set_count);
+		for (uint32_t set = 0; set < m_header->set_count; ++set)
+		{
+			std::shared_ptr<cura52::SharedSettings> shared(new cura52::SharedSettings());
+			forEachInSet(set, [&shared](std::string_view key, std::string_view value) {
+				shared->add(std::string(key), std::string(value));
+			});
+			m_shared.push_back(shared);
+		}
+	}
+
+	namespace
+	{
+		void mergeSettings(const cura52::SharedSettings* shared, const crcommon::Settings* overrides, std::map<std::string, std::string>& settings)
+		{
+			if (shared)
+			{
+				for (const auto& pair : shared->getValues())
+					settings[pair.first] = pair.second.serialised;
+			}
+			if (overrides)
+			{
+				for (const auto& pair : overrides->settings)
+					settings[pair.first] = pair.second;
+			}
+		}
+	}
+
+	void mergeSceneSettings(const CrScene& scene, std::map<std::string, std::string>& settings)
+	{
+		mergeSettings(scene.m_bundle ? scene.m_bundle->sceneSettings().get() : nullptr, scene.m_settings.get(), settings);
+	}
+
+	size_t mergedExtruderCount(const CrScene& scene)
+	{
+		size_t extruderCount = scene.m_extruders.size();
+		if (scene.m_bundle)
+			extruderCount = std::max(extruderCount, scene.m_bundle->extruderCount());
+		return extruderCount;
+	}
+
+	void mergeExtruderSettings(const CrScene& scene, size_t extruder, std::map<std::string, std::string>& settings)
+	{
+		const bool inBundle = scene.m_bundle && extruder < scene.m_bundle->extruderCount();
+		const bool inScene = extruder < scene.m_extruders.size();
+		mergeSettings(inBundle ? scene.m_bundle->extruderSettings(extruder).get() : nullptr, inScene ? scene.m_extruders.at(extruder).get() : nullptr, settings);
+	}
+
+	bool SettingsBundle::map(const std::string& fileName)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping)
+			return false;
+		m_mapping = mapping;
+		m_data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		m_size = (size_t)size.QuadPart;
+#else
+		int fd = ::open(fileName.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+		m_data = (const char*)data;
+		m_size = (size_t)info.st_size;
+#endif
+		return m_data != nullptr;
+	}
+
+	bool SettingsBundle::validate()
+	{
+		if (m_size < sizeof(Header))
+			return false;
+
+		Header header;
+		memcpy(&header, m_data, sizeof(Header));
+		if (memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version || header.set_count == 0)
+			return false;
+
+		const Layout layout = layoutOf(header);
+		if (layout.end > m_size)
+			return false;
+
+		m_header = (const Header*)m_data;
+		m_keys = (const StringRef*)(m_data + layout.keys);
+		m_sets = (const SetRef*)(m_data + layout.sets);
+		m_values = (const Value*)(m_data + layout.values);
+		m_strings = m_data + layout.strings;
+
+		// Check every reference once here, so that reading the settings doesn't have to.
+		auto validString = [&header](const StringRef& ref) {
+			return (size_t)ref.offset + ref.length <= header.strings_size;
+		};
+		for (uint32_t i = 0; i < header.key_count; ++i)
+		{
+			if (!validString(m_keys[i]))
+				return false;
+		}
+		for (uint32_t i = 0; i < header.set_count; ++i)
+		{
+			if ((size_t)m_sets[i].first_value + m_sets[i].value_count > header.value_count)
+				return false;
+		}
+		for (uint32_t i = 0; i < header.value_count; ++i)
+		{
+			if (m_values[i].key >= header.key_count || !validString(m_values[i].value))
+				return false;
+		}
+		return true;
+	}
+
+	bool compileSettingsBundle(const std::string& jsonFile, const std::string& bundleFile)
+	{
+		crcommon::KValues sceneKVs;
+		std::vector<crcommon::KValues> extruderKVs;
+		if (crcommon::loadJSON(jsonFile, sceneKVs, extruderKVs) != 0)
+		{
+			LOGE("compileSettingsBundle invalid json file: %s", jsonFile.c_str());
+			return false;
+		}
+
+		std::vector<const crcommon::KValues*> sets;
+		sets.push_back(&sceneKVs);
+		for (const crcommon::KValues& kvs : extruderKVs)
+			sets.push_back(&kvs);
+
+		std::vector<std::string> keys;
+		for (const crcommon::KValues* kvs : sets)
+		{
+			for (const auto& pair : *kvs)
+				keys.push_back(pair.first);
+		}
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+		StringPool pool;
+		std::vector<SettingsBundle::StringRef> keyRefs;
+		keyRefs.reserve(keys.size());
+		for (const std::string& key : keys)
+			keyRefs.push_back(pool.add(key));
+
+		std::vector<SettingsBundle::SetRef> setRefs;
+		std::vector<SettingsBundle::Value> values;
+		for (const crcommon::KValues* kvs : sets)
+		{
+			SettingsBundle::SetRef setRef{ (uint32_t)values.size(), (uint32_t)kvs->size() };
+			for (const auto& pair : *kvs)
+			{
+				const uint32_t key = (uint32_t)(std::lower_bound(keys.begin(), keys.end(), pair.first) - keys.begin());
+				values.push_back(SettingsBundle::Value{ key, pool.add(pair.second) });
+			}
+			std::sort(values.begin() + setRef.first_value, values.end(),
+				[](const SettingsBundle::Value& a, const SettingsBundle::Value& b) { return a.key < b.key; });
+			setRefs.push_back(setRef);
+		}
+
+		SettingsBundle::Header header;
+		memcpy(header.magic, SettingsBundle::magic, sizeof(header.magic));
+		header.version = SettingsBundle::version;
+		header.key_count = (uint32_t)keyRefs.size();
+		header.set_count = (uint32_t)setRefs.size();
+		header.value_count = (uint32_t)values.size();
+		header.strings_size = (uint32_t)pool.data().size();
+		const Layout layout = layoutOf(header);
+
+		// Write next to the target and rename, so that scenes which have the old bundle mapped keep a consistent file.
+		const std::string tmpFile = bundleFile + ".tmp";
+		{
+			std::ofstream out(tmpFile, std::ios_base::binary | std::ios_base::trunc);
+			if (!out.is_open())
+			{
+				LOGE("compileSettingsBundle can't write %s", tmpFile.c_str());
+				return false;
+			}
+			writeAt(out, 0, &header, 1);
+			writeAt(out, layout.keys, keyRefs.data(), keyRefs.size());
+			writeAt(out, layout.sets, setRefs.data(), setRefs.size());
+			writeAt(out, layout.values, values.data(), values.size());
+			writeAt(out, layout.strings, pool.data().data(), pool.data().size());
+			if (!out.good())
+			{
+				LOGE("compileSettingsBundle can't write %s", tmpFile.c_str());
+				return false;
+			}
+		}
+
+#ifdef _WIN32
+		std::remove(bundleFile.c_str());
+#endif
+		if (std::rename(tmpFile.c_str(), bundleFile.c_str()) != 0)
+		{
+			LOGE("compileSettingsBundle can't write %s", bundleFile.c_str());
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,138 @@
+#ifndef CRSLICE_SETTINGSBUNDLE_1697712000000_H
+#define CRSLICE_SETTINGSBUNDLE_1697712000000_H
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cura52
+{
+	class SharedSettings;
+}
+
+namespace crslice
+{
+	class CrScene;
+
+	/*
+	 * A precompiled machine + material + profile settings set, mapped read-only from disk.
+	 *
+	 * The bundle is produced offline by compileSettingsBundle from the same json that
+	 * CrScene::setSceneJsonFile reads. It holds the scene settings and the settings of
+	 * every extruder. Keys are stored once in a sorted table and referenced by index,
+	 * equal values share one string. Loading it is a mmap, a header check and reading
+	 * every set once into the shared settings the engine reads, and the same file is
+	 * shared by all scenes which use it. The settings of a slice then refer to those
+	 * instead of each getting a copy of the values.
+	 *
+	 * Layout, all integers native endian:
+	 *   Header
+	 *   StringRef keys[key_count]           sorted by key
+	 *   SetRef sets[set_count]              set 0 is the scene, set 1 + i is extruder i
+	 *   Value values[sum of value_count]    sorted by key index within a set
+	 *   char strings[strings_size]          pool referenced by the StringRefs
+	 */
+	class SettingsBundle
+	{
+	public:
+		~SettingsBundle();
+
+		/*
+		 * Open a bundle. Bundles which are still in use by another scene are shared
+		 * as long as the file has not changed. Returns nullptr if the file can't be
+		 * mapped or is not a valid bundle.
+		 */
+		static std::shared_ptr<const SettingsBundle> open(const std::string& fileName);
+
+		size_t extruderCount() const;
+
+		/*
+		 * The scene settings, to share with the scene settings of every slice.
+		 */
+		std::shared_ptr<const cura52::SharedSettings> sceneSettings() const;
+
+		/*
+		 * The settings of an extruder, to share with the extruder settings of every slice.
+		 */
+		std::shared_ptr<const cura52::SharedSettings> extruderSettings(size_t extruder) const;
+
+		struct StringRef
+		{
+			uint32_t offset;
+			uint32_t length;
+		};
+
+		struct SetRef
+		{
+			uint32_t first_value;
+			uint32_t value_count;
+		};
+
+		struct Value
+		{
+			uint32_t key;
+			StringRef value;
+		};
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t key_count;
+			uint32_t set_count;
+			uint32_t value_count;
+			uint32_t strings_size;
+		};
+
+		static constexpr char magic[4] = { 'C', 'R', 'S', 'B' };
+		static constexpr uint32_t version = 1;
+
+	private:
+		SettingsBundle() = default;
+
+		bool map(const std::string& fileName);
+		bool validate();
+		void readSets();
+
+		std::string_view string(const StringRef& ref) const
+		{
+			return std::string_view(m_strings + ref.offset, ref.length);
+		}
+
+		template<typename Func>
+		void forEachInSet(size_t set, Func func) const
+		{
+			const SetRef& ref = m_sets[set];
+			for (uint32_t i = ref.first_value; i < ref.first_value + ref.value_count; ++i)
+			{
+				const Value& value = m_values[i];
+				func(string(m_keys[value.key]), string(value.value));
+			}
+		}
+
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+		void* m_mapping = nullptr; //!< The platform mapping handle, if any.
+
+		const Header* m_header = nullptr;
+		const StringRef* m_keys = nullptr;
+		const SetRef* m_sets = nullptr;
+		const Value* m_values = nullptr;
+		const char* m_strings = nullptr;
+
+		std::vector<std::shared_ptr<const cura52::SharedSettings>> m_shared; //!< Set 0 is the scene, set 1 + i is extruder i.
+	};
+
+	/*
+	 * The settings a scene is sliced with: the values of its bundle, if it has one, with
+	 * the settings of the scene on top. Saving and hashing a scene go through here, so
+	 * they see the same values as the engine.
+	 */
+	void mergeSceneSettings(const CrScene& scene, std::map<std::string, std::string>& settings);
+	size_t mergedExtruderCount(const CrScene& scene);
+	void mergeExtruderSettings(const CrScene& scene, size_t extruder, std::map<std::string, std::string>& settings);
+}
+
+#endif // CRSLICE_SETTINGSBUNDLE_1697712000000_H
@@ -0,0 +1,356 @@
+#include "slicecache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "crslice/crscene.h"
+#include "crgroup.h"
+#include "settingsbundle.h"
+#include "crsliceinfo.h"
+#include "ccglobal/log.h"
+
+namespace fs = std::filesystem;
+
+namespace crslice
+{
+	namespace
+	{
+		const char resultMagic[4] = { 'C', 'R', 'S', 'C' };
+		const uint32_t resultVersion = 1;
+
+		uint64_t rotl(uint64_t x, int r)
+		{
+			return (x << r) | (x >> (64 - r));
+		}
+
+		uint64_t fmix(uint64_t x)
+		{
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdull;
+			x ^= x >> 33;
+			x *= 0xc4ceb9fe1a85ec53ull;
+			x ^= x >> 33;
+			return x;
+		}
+
+		/*
+		 * Two independently mixed 64 bit lanes, fed a word at a time. Not meant to
+		 * withstand an attacker, only to make accidental collisions unlikely.
+		 */
+		class Hasher
+		{
+		public:
+			void word(uint64_t w)
+			{
+				m_a = rotl((m_a ^ w) * 0x87c37b91114253d5ull, 31);
+				m_b = rotl((m_b ^ rotl(w, 17)) * 0x4cf5ad432745937full, 29) + m_a;
+			}
+
+			void bytes(const void* data, size_t size)
+			{
+				const unsigned char* p = (const unsigned char*)data;
+				size_t i = 0;
+				for (; i + 8 <= size; i += 8)
+				{
+					uint64_t w;
+					memcpy(&w, p + i, 8);
+					word(w);
+				}
+				uint64_t tail = 0;
+				memcpy(&tail, p + i, size - i);
+				word(tail);
+				word((uint64_t)size);
+			}
+
+			void string(const std::string& s)
+			{
+				bytes(s.data(), s.size());
+			}
+
+			std::string hex() const
+			{
+				static const char digits[] = "0123456789abcdef";
+				const uint64_t lanes[2] = { fmix(m_a + m_b), fmix(m_b ^ rotl(m_a, 23)) };
+				std::string result;
+				for (uint64_t lane : lanes)
+				{
+					for (int shift = 60; shift >= 0; shift -= 4)
+						result.push_back(digits[(lane >> shift) & 0xf]);
+				}
+				return result;
+			}
+		protected:
+			uint64_t m_a = 0x9e3779b97f4a7c15ull;
+			uint64_t m_b = 0xc2b2ae3d27d4eb4full;
+		};
+
+		void hashSettings(Hasher& hasher, const std::map<std::string, std::string>& settings)
+		{
+			hasher.word(settings.size());
+			for (const auto& pair : settings)
+			{
+				hasher.string(pair.first);
+				hasher.string(pair.second);
+			}
+		}
+
+		void hashSettings(Hasher& hasher, const SettingsPtr& settings)
+		{
+			std::map<std::string, std::string> sorted;
+			if (settings)
+				sorted.insert(settings->settings.begin(), settings->settings.end());
+			hashSettings(hasher, sorted);
+		}
+
+		uint32_t floatBits(float f)
+		{
+			f += 0.0f; // -0 and +0 slice the same.
+			uint32_t bits;
+			memcpy(&bits, &f, 4);
+			return bits;
+		}
+
+		void hashMesh(Hasher& hasher, const TriMeshPtr& mesh)
+		{
+			if (!mesh)
+			{
+				hasher.word(0);
+				return;
+			}
+
+			hasher.word(mesh->vertices.size());
+			for (const trimesh::vec3& v : mesh->vertices)
+			{
+				hasher.word(((uint64_t)floatBits(v.x) << 32) | floatBits(v.y));
+				hasher.word(floatBits(v.z));
+			}
+			hasher.word(mesh->faces.size());
+			if (!mesh->faces.empty())
+				hasher.bytes(mesh->faces.data(), mesh->faces.size() * sizeof(mesh->faces[0]));
+		}
+
+		// Unique per process and thread, so that concurrent writers don't share temporary files.
+		std::string temporarySuffix()
+		{
+			const uint64_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+			const uint64_t now = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+			return ".tmp" + std::to_string(thread) + "-" + std::to_string(now);
+		}
+
+		template<typename T>
+		void writeValue(std::ofstream& out, T value)
+		{
+			out.write((const char*)&value, sizeof(T));
+		}
+
+		template<typename T>
+		T readValue(std::ifstream& in)
+		{
+			T value = T();
+			in.read((char*)&value, sizeof(T));
+			return value;
+		}
+	}
+
+	SliceCache::SliceCache(const std::string& directory, size_t maxBytes)
+		: m_directory(directory)
+		, m_maxBytes(maxBytes)
+	{
+		std::error_code error;
+		fs::create_directories(m_directory, error);
+	}
+
+	std::string SliceCache::key(const CrScene& scene)
+	{
+		Hasher hasher;
+		hasher.string(CRSLICE_GIT_HASH);
+		hasher.word(resultVersion);
+		hasher.word(scene.machine_center_is_zero ? 1 : 0);
+
+		// The effective settings, merged the same way CrScene::save merges the bundle with the overrides.
+		std::map<std::string, std::string> settings;
+		mergeSceneSettings(scene, settings);
+		hashSettings(hasher, settings);
+
+		const size_t extruderCount = mergedExtruderCount(scene);
+		hasher.word(extruderCount);
+		for (size_t i = 0; i < extruderCount; ++i)
+		{
+			std::map<std::string, std::string> extruder;
+			mergeExtruderSettings(scene, i, extruder);
+			hashSettings(hasher, extruder);
+		}
+
+		hasher.word(scene.m_groups.size());
+		for (const CrGroup* group : scene.m_groups)
+		{
+			hashSettings(hasher, group->m_settings);
+			hasher.word(((uint64_t)floatBits(group->m_offset.x) << 32) | floatBits(group->m_offset.y));
+			hasher.word(floatBits(group->m_offset.z));
+			hasher.word(group->m_objects.size());
+			for (const CrObject& object : group->m_objects)
+			{
+				hashSettings(hasher, object.m_settings);
+				hashMesh(hasher, object.m_mesh);
+			}
+		}
+		return hasher.hex();
+	}
+
+	bool SliceCache::fetch(const std::string& key, const std::string& gcodeFile, SliceResult& result)
+	{
+		const fs::path resultPath = fs::path(m_directory) / (key + ".result");
+		const fs::path gcodePath = fs::path(m_directory) / (key + ".gcode");
+
+		std::ifstream in(resultPath, std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		char magic[4] = { 0 };
+		in.read(magic, 4);
+		const uint32_t version = readValue<uint32_t>(in);
+		const uint64_t gcodeSize = readValue<uint64_t>(in);
+		SliceResult cached = { 0 }; // The resources are those of this run, which didn't slice.
+		cached.print_time = (unsigned long int)readValue<uint64_t>(in);
+		cached.filament_len = readValue<double>(in);
+		cached.filament_volume = readValue<double>(in);
+		cached.layer_count = (unsigned long int)readValue<uint64_t>(in);
+		cached.x = readValue<double>(in);
+		cached.y = readValue<double>(in);
+		cached.z = readValue<double>(in);
+		if (!in || memcmp(magic, resultMagic, 4) != 0 || version != resultVersion)
+			return false;
+		in.close();
+
+		std::error_code error;
+		if (fs::file_size(gcodePath, error) != gcodeSize || error)
+			return false;
+		if (!fs::copy_file(gcodePath, gcodeFile, fs::copy_options::overwrite_existing, error) || error)
+		{
+			LOGE("SliceCache::fetch can't copy %s to %s.", gcodePath.string().c_str(), gcodeFile.c_str());
+			return false;
+		}
+
+		// The modification time of the result file is the last use for eviction.
+		fs::last_write_time(resultPath, fs::file_time_type::clock::now(), error);
+		result = cached;
+		return true;
+	}
+
+	void SliceCache::store(const std::string& key, const std::string& gcodeFile, const SliceResult& result)
+	{
+		const fs::path resultPath = fs::path(m_directory) / (key + ".result");
+		const fs::path gcodePath = fs::path(m_directory) / (key + ".gcode");
+		const std::string suffix = temporarySuffix();
+
+		std::error_code error;
+		const uint64_t gcodeSize = fs::file_size(gcodeFile, error);
+		if (error)
+			return;
+		if (m_maxBytes > 0 && gcodeSize > m_maxBytes)
+			return;
+
+		// The g-code first: a result file is only ever next to complete g-code.
+		const fs::path gcodeTemp = gcodePath.string() + suffix;
+		if (!fs::copy_file(gcodeFile, gcodeTemp, fs::copy_options::overwrite_existing, error) || error)
+		{
+			LOGE("SliceCache::store can't write %s.", gcodeTemp.string().c_str());
+			fs::remove(gcodeTemp, error);
+			return;
+		}
+		fs::rename(gcodeTemp, gcodePath, error);
+		if (error)
+		{
+			fs::remove(gcodeTemp, error);
+			return;
+		}
+
+		const fs::path resultTemp = resultPath.string() + suffix;
+		{
+			std::ofstream out(resultTemp, std::ios::binary);
+			out.write(resultMagic, 4);
+			writeValue<uint32_t>(out, resultVersion);
+			writeValue<uint64_t>(out, gcodeSize);
+			writeValue<uint64_t>(out, result.print_time);
+			writeValue<double>(out, result.filament_len);
+			writeValue<double>(out, result.filament_volume);
+			writeValue<uint64_t>(out, result.layer_count);
+			writeValue<double>(out, result.x);
+			writeValue<double>(out, result.y);
+			writeValue<double>(out, result.z);
+			if (!out)
+			{
+				out.close();
+				fs::remove(resultTemp, error);
+				return;
+			}
+		}
+		fs::rename(resultTemp, resultPath, error);
+		if (error)
+			fs::remove(resultTemp, error);
+
+		evict();
+	}
+
+	void SliceCache::evict()
+	{
+		if (m_maxBytes == 0)
+			return;
+
+		struct Entry
+		{
+			fs::path result;
+			fs::path gcode;
+			fs::file_time_type used;
+			uint64_t bytes;
+		};
+		std::vector<Entry> entries;
+		uint64_t total = 0;
+
+		std::error_code error;
+		for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+		{
+			const fs::path& path = it->path();
+			if (path.extension() != ".result")
+				continue;
+
+			Entry entry;
+			entry.result = path;
+			entry.gcode = path;
+			entry.gcode.replace_extension(".gcode");
+			std::error_code entryError;
+			entry.used = fs::last_write_time(path, entryError);
+			entry.bytes = fs::file_size(path, entryError);
+			const uint64_t gcodeBytes = fs::file_size(entry.gcode, entryError);
+			if (!entryError)
+				entry.bytes += gcodeBytes;
+			total += entry.bytes;
+			entries.push_back(entry);
+		}
+		if (total <= m_maxBytes)
+			return;
+
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			return a.used < b.used;
+		});
+		size_t removed = 0;
+		for (const Entry& entry : entries)
+		{
+			if (total <= m_maxBytes)
+				break;
+			std::error_code removeError;
+			fs::remove(entry.result, removeError);
+			fs::remove(entry.gcode, removeError);
+			total -= entry.bytes;
+			++removed;
+		}
+		LOGM("SliceCache evicted %d entries, %lld bytes left.", (int)removed, (long long)total);
+	}
+}
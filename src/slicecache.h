@@ -0,0 +1,48 @@
+#ifndef CRSLICE_SLICECACHE_1697980000000_H
+#define CRSLICE_SLICECACHE_1697980000000_H
+#include "crslice/crslice.h"
+#include <string>
+
+namespace crslice
+{
+	class CrScene;
+
+	/*
+	 * A directory of finished slices, keyed by the content of the scene.
+	 *
+	 * The key hashes everything that reaches the engine: the effective scene and
+	 * extruder settings (the bundle merged with the overrides, in key order), the
+	 * settings, offset and mesh of every group and object, and the engine build.
+	 * Names of the output files and the temp directory are not part of it.
+	 *
+	 * Each entry is <key>.gcode plus <key>.result, which holds the SliceResult and
+	 * the size of the g-code. Entries are written under a temporary name and
+	 * renamed, so a reader never sees half an entry. Whenever an entry is added the
+	 * oldest used entries are removed until the directory fits in the size limit.
+	 */
+	class SliceCache
+	{
+	public:
+		SliceCache(const std::string& directory, size_t maxBytes);
+
+		static std::string key(const CrScene& scene);
+
+		/*
+		 * Copy the g-code of the entry to gcodeFile and read its result. Returns false
+		 * if there is no complete entry for the key.
+		 */
+		bool fetch(const std::string& key, const std::string& gcodeFile, SliceResult& result);
+
+		/*
+		 * Add the g-code in gcodeFile and its result as the entry for the key.
+		 */
+		void store(const std::string& key, const std::string& gcodeFile, const SliceResult& result);
+	protected:
+		void evict();
+
+		std::string m_directory;
+		size_t m_maxBytes;
+	};
+}
+
+#endif // CRSLICE_SLICECACHE_1697980000000_H
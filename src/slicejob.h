@@ -0,0 +1,22 @@
+#ifndef CRSLICE_SLICEJOB_1698000000000_H
+#define CRSLICE_SLICEJOB_1698000000000_H
+#include "crslice/crslice.h"
+#include <atomic>
+
+namespace cura52
+{
+	class SliceListener;
+}
+
+namespace crslice
+{
+	/*
+	 * Slice a scene into its g-code file, through the result cache if the scene has one.
+	 * Shared by CrSlice and CrAsyncSlice. The listener and the cancel flag may be null.
+	 * Returns false if the slice was interrupted.
+	 */
+	bool runSlice(CrScenePtr scene, ccglobal::Tracer* tracer, cura52::SliceListener* listener,
+		const std::atomic<bool>* cancelFlag, const SliceResourceLimits& limits, SliceResult& result);
+}
+
+#endif // CRSLICE_SLICEJOB_1698000000000_H